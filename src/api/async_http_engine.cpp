@@ -0,0 +1,446 @@
+#include "async_http_engine.h"
+#include "http_response_cache.h"
+#include "transport_backend.h"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <iostream>
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace polymarket_bot {
+namespace api {
+
+AsyncHttpEngine& AsyncHttpEngine::getInstance() {
+    static AsyncHttpEngine instance;
+    return instance;
+}
+
+AsyncHttpEngine::AsyncHttpEngine()
+    : transport(HttpTransport::getInstance()), multi(curl_multi_init()), activeCount(0), throttledCount(0), stopping(false) {
+    if (multi) {
+        curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, 16L);
+        curl_multi_setopt(multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, 64L);
+#ifdef __linux__
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = wakeFd;
+        if (epollFd >= 0 && wakeFd >= 0 && epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event) == 0) {
+            curl_multi_setopt(multi, CURLMOPT_SOCKETFUNCTION, &AsyncHttpEngine::onSocket);
+            curl_multi_setopt(multi, CURLMOPT_SOCKETDATA, this);
+            curl_multi_setopt(multi, CURLMOPT_TIMERFUNCTION, &AsyncHttpEngine::onTimer);
+            curl_multi_setopt(multi, CURLMOPT_TIMERDATA, this);
+        } else {
+            std::cerr << "[AsyncHttpEngine] epoll unavailable, falling back to curl_multi_poll" << std::endl;
+            if (epollFd >= 0) {
+                close(epollFd);
+            }
+            if (wakeFd >= 0) {
+                close(wakeFd);
+            }
+            epollFd = -1;
+            wakeFd = -1;
+        }
+#endif
+    }
+    loopThread = std::thread(&AsyncHttpEngine::eventLoop, this);
+}
+
+AsyncHttpEngine::~AsyncHttpEngine() {
+    stopping = true;
+    if (multi) {
+        wake();
+    }
+    if (loopThread.joinable()) {
+        loopThread.join();
+    }
+
+    // Fail anything that never ran so no caller waits forever
+    for (auto& entry : active) {
+        curl_multi_remove_handle(multi, entry.first);
+        complete(std::move(entry.second), CURLE_ABORTED_BY_CALLBACK);
+    }
+    active.clear();
+    for (auto& transfer : throttled) {
+        pending.push_back(std::move(transfer));
+    }
+    throttled.clear();
+    for (auto& transfer : pending) {
+        transfer->response.curlCode = CURLE_ABORTED_BY_CALLBACK;
+        transfer->response.error = "HTTP engine shut down";
+        if (transfer->callback) {
+            transfer->callback(std::move(transfer->response));
+        }
+    }
+    pending.clear();
+
+    if (multi) {
+        curl_multi_cleanup(multi);
+    }
+#ifdef __linux__
+    if (epollFd >= 0) {
+        close(epollFd);
+        close(wakeFd);
+    }
+#endif
+}
+
+void FetchAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    // The callback may run before submit() returns, so nothing here touches the awaiter after submitting
+    engine.submit(std::move(request), [this, handle, priority = priority](HttpResponse result) {
+        response = std::move(result);
+        common::ThreadPool::getInstance().post(priority, [handle]() { handle.resume(); });
+    });
+}
+
+void AsyncHttpEngine::submit(HttpRequest request, Callback callback) {
+    // A 304 to a conditional request is useless once the cache has evicted the entry it would reuse,
+    // so that request goes out once more without validators and the caller only sees the full reply
+    if (HttpResponseCache::hasValidators(request)) {
+        HttpRequest unconditional = request;
+        HttpResponseCache::stripValidators(unconditional);
+        callback = [this, unconditional = std::move(unconditional), callback = std::move(callback)](HttpResponse response) mutable {
+            if (response.ok() && response.statusCode == 304 &&
+                !HttpResponseCache::getInstance().holds(unconditional.url)) {
+                submit(std::move(unconditional), std::move(callback));
+                return;
+            }
+            if (callback) {
+                callback(std::move(response));
+            }
+        };
+    }
+
+    if (auto backend = transport.getBackend()) {
+        backend->performAsync(std::move(request), std::move(callback));
+        return;
+    }
+    submitLive(std::move(request), std::move(callback));
+}
+
+void AsyncHttpEngine::submitLive(HttpRequest request, Callback callback) {
+    auto transfer = std::make_unique<Transfer>();
+    transfer->request = std::move(request);
+    transfer->callback = std::move(callback);
+    transfer->request.deadline = transport.effectiveDeadline(transfer->request);
+    transfer->host = HttpTransport::hostKey(transfer->request.url);
+    transfer->limiter = RateLimiterRegistry::getInstance().find(transfer->request.url);
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        pending.push_back(std::move(transfer));
+    }
+    wake();
+}
+
+void AsyncHttpEngine::wake() {
+#ifdef __linux__
+    if (wakeFd >= 0) {
+        uint64_t one = 1;
+        ssize_t written = write(wakeFd, &one, sizeof(one));
+        (void)written;   // A full counter already means a pending wake-up
+        return;
+    }
+#endif
+    curl_multi_wakeup(multi);
+}
+
+std::future<HttpResponse> AsyncHttpEngine::submit(HttpRequest request) {
+    auto promise = std::make_shared<std::promise<HttpResponse>>();
+    std::future<HttpResponse> future = promise->get_future();
+    submit(std::move(request), [promise](HttpResponse response) {
+        promise->set_value(std::move(response));
+    });
+    return future;
+}
+
+std::vector<HttpResponse> AsyncHttpEngine::performAll(std::vector<HttpRequest> requests) {
+    std::vector<std::future<HttpResponse>> futures;
+    futures.reserve(requests.size());
+    for (auto& request : requests) {
+        futures.push_back(submit(std::move(request)));
+    }
+
+    std::vector<HttpResponse> responses;
+    responses.reserve(futures.size());
+    for (auto& future : futures) {
+        responses.push_back(future.get());
+    }
+    return responses;
+}
+
+size_t AsyncHttpEngine::inFlight() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return pending.size() + throttledCount.load() + activeCount.load();
+}
+
+std::chrono::milliseconds AsyncHttpEngine::startPending() {
+    std::vector<std::unique_ptr<Transfer>> batch;
+    batch.swap(throttled);
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        for (auto& transfer : pending) {
+            batch.push_back(std::move(transfer));
+        }
+        pending.clear();
+    }
+
+    auto now = RateLimiter::Clock::now();
+    auto nextToken = RateLimiter::Clock::duration::max();
+    for (auto& transfer : batch) {
+        const Deadline& deadline = transfer->request.deadline;
+        if (deadline.expired(now)) {
+            transport.failDeadline(transfer->response, transfer->request.url);
+            std::string error = transfer->response.error;
+            complete(std::move(transfer), CURLE_OPERATION_TIMEDOUT, error);
+            continue;
+        }
+
+        // Transfers without a token wait here instead of blocking a thread
+        RateLimiter::Clock::duration wait{};
+        if (transfer->limiter && !transfer->limiter->tryAcquire(now, wait)) {
+            if (wait == RateLimiter::Clock::duration::max()) {
+                std::string error = "Request quota exhausted for " + transfer->host;
+                transfer->response.statusCode = 429;
+                complete(std::move(transfer), CURLE_OK, error);
+                continue;
+            }
+            if (deadline.isSet() && deadline.time() - now < wait) {
+                // The token would come too late; fail now rather than hold the caller until the deadline
+                transport.failDeadline(transfer->response, transfer->request.url);
+                std::string error = transfer->response.error;
+                complete(std::move(transfer), CURLE_OPERATION_TIMEDOUT, error);
+                continue;
+            }
+            nextToken = std::min(nextToken, wait);
+            throttled.push_back(std::move(transfer));
+            continue;
+        }
+
+        transfer->handle = transport.acquireHandle(transfer->host);
+        if (!transfer->handle) {
+            complete(std::move(transfer), CURLE_FAILED_INIT);
+            continue;
+        }
+
+        transfer->headers = transport.prepareHandle(transfer->handle, transfer->request, deadline, transfer->response);
+        curl_easy_setopt(transfer->handle, CURLOPT_PRIVATE, transfer.get());
+
+        CURLMcode rc = curl_multi_add_handle(multi, transfer->handle);
+        if (rc != CURLM_OK) {
+            std::cerr << "[AsyncHttpEngine] curl_multi_add_handle failed: " << curl_multi_strerror(rc) << std::endl;
+            complete(std::move(transfer), CURLE_FAILED_INIT);
+            continue;
+        }
+
+        CURL* handle = transfer->handle;
+        active.emplace(handle, std::move(transfer));
+        activeCount++;
+    }
+    throttledCount = throttled.size();
+
+    if (nextToken == RateLimiter::Clock::duration::max()) {
+        return std::chrono::milliseconds(1000);
+    }
+    // Round up so the loop does not wake a hair before the token is there
+    return std::chrono::ceil<std::chrono::milliseconds>(nextToken) + std::chrono::milliseconds(1);
+}
+
+void AsyncHttpEngine::completeFinished() {
+    int messagesLeft = 0;
+    while (CURLMsg* message = curl_multi_info_read(multi, &messagesLeft)) {
+        if (message->msg != CURLMSG_DONE) {
+            continue;
+        }
+
+        CURL* handle = message->easy_handle;
+        CURLcode code = message->data.result;
+        curl_multi_remove_handle(multi, handle);
+
+        auto it = active.find(handle);
+        if (it == active.end()) {
+            continue;
+        }
+        std::unique_ptr<Transfer> transfer = std::move(it->second);
+        active.erase(it);
+        activeCount--;
+
+        complete(std::move(transfer), code);
+    }
+}
+
+std::chrono::milliseconds AsyncHttpEngine::cancelExpired() {
+    auto now = Deadline::Clock::now();
+    auto next = std::chrono::milliseconds::max();
+    for (auto it = active.begin(); it != active.end();) {
+        const Deadline& deadline = it->second->request.deadline;
+        if (!deadline.isSet()) {
+            ++it;
+            continue;
+        }
+        if (!deadline.expired(now)) {
+            next = std::min(next, deadline.remaining(now));
+            ++it;
+            continue;
+        }
+        // CURLOPT_TIMEOUT_MS normally gets there first; this catches transfers it has not yet noticed
+        curl_multi_remove_handle(multi, it->first);
+        std::unique_ptr<Transfer> transfer = std::move(it->second);
+        it = active.erase(it);
+        activeCount--;
+        complete(std::move(transfer), CURLE_OPERATION_TIMEDOUT);
+    }
+    return next;
+}
+
+void AsyncHttpEngine::complete(std::unique_ptr<Transfer> transfer, CURLcode code, const std::string& error) {
+    if (transfer->handle) {
+        HttpTransport::finishResponse(transfer->handle, code, transfer->response);
+        curl_slist_free_all(transfer->headers);
+        transport.releaseHandle(transfer->host, transfer->handle);
+        transfer->handle = nullptr;
+        transfer->headers = nullptr;
+        if (!error.empty()) {
+            transfer->response.error = error;
+        }
+        if (transfer->response.timedOut() && transfer->request.deadline.expired()) {
+            transport.failDeadline(transfer->response, transfer->request.url);
+        }
+        if (transfer->limiter) {
+            transfer->limiter->observe(transfer->response);
+        }
+        transport.recordTransfer(transfer->request.url, transfer->response);
+    } else {
+        transfer->response.curlCode = code;
+        transfer->response.error = error.empty() ? curl_easy_strerror(code) : error;
+    }
+
+    if (!transfer->callback) {
+        return;
+    }
+    try {
+        transfer->callback(std::move(transfer->response));
+    } catch (const std::exception& e) {
+        std::cerr << "[AsyncHttpEngine] Completion callback threw: " << e.what() << std::endl;
+    }
+}
+
+void AsyncHttpEngine::eventLoop() {
+    if (epollFd >= 0) {
+        socketLoop();
+    } else {
+        pollLoop();
+    }
+}
+
+void AsyncHttpEngine::pollLoop() {
+    while (!stopping) {
+        auto pollTimeout = startPending();
+
+        int running = 0;
+        curl_multi_perform(multi, &running);
+        completeFinished();
+        pollTimeout = std::min(pollTimeout, cancelExpired());
+
+        // Sleeps until socket activity, the next rate-limit token, or curl_multi_wakeup() from submit()
+        curl_multi_poll(multi, nullptr, 0, static_cast<int>(std::min<long long>(pollTimeout.count(), 1000)), nullptr);
+    }
+}
+
+#ifdef __linux__
+
+// curl says which events it wants on a socket; epoll is updated to match
+int AsyncHttpEngine::onSocket(CURL*, curl_socket_t socket, int what, void* userp, void* socketData) {
+    auto* engine = static_cast<AsyncHttpEngine*>(userp);
+    if (what == CURL_POLL_REMOVE) {
+        epoll_ctl(engine->epollFd, EPOLL_CTL_DEL, socket, nullptr);
+        return 0;
+    }
+
+    epoll_event event{};
+    event.data.fd = socket;
+    event.events = ((what & CURL_POLL_IN) ? EPOLLIN : 0u) | ((what & CURL_POLL_OUT) ? EPOLLOUT : 0u);
+    // The socket's curl-side pointer marks whether epoll already has it
+    if (socketData) {
+        epoll_ctl(engine->epollFd, EPOLL_CTL_MOD, socket, &event);
+    } else {
+        if (epoll_ctl(engine->epollFd, EPOLL_CTL_ADD, socket, &event) != 0 && errno == EEXIST) {
+            epoll_ctl(engine->epollFd, EPOLL_CTL_MOD, socket, &event);
+        }
+        curl_multi_assign(engine->multi, socket, engine);
+    }
+    return 0;
+}
+
+int AsyncHttpEngine::onTimer(CURLM*, long timeoutMs, void* userp) {
+    auto* engine = static_cast<AsyncHttpEngine*>(userp);
+    engine->curlTimerAt = timeoutMs < 0 ? std::chrono::steady_clock::time_point::max()
+                                        : std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    return 0;
+}
+
+void AsyncHttpEngine::socketLoop() {
+    std::array<epoll_event, 64> events;
+    while (!stopping) {
+        auto wait = std::min(startPending(), cancelExpired());
+        if (curlTimerAt != std::chrono::steady_clock::time_point::max()) {
+            auto untilTimer = std::chrono::ceil<std::chrono::milliseconds>(curlTimerAt - std::chrono::steady_clock::now());
+            wait = std::min(wait, std::max(untilTimer, std::chrono::milliseconds(0)));
+        }
+
+        // Sleeps until socket activity, curl's timeout, the next rate-limit token, or a submit()
+        int ready = epoll_wait(epollFd, events.data(), static_cast<int>(events.size()),
+                               static_cast<int>(std::min<long long>(wait.count(), 1000)));
+        int running = 0;
+        for (int i = 0; i < ready; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == wakeFd) {
+                uint64_t count = 0;
+                ssize_t drained = read(wakeFd, &count, sizeof(count));
+                (void)drained;
+                continue;
+            }
+            int flags = 0;
+            if (events[i].events & EPOLLIN) {
+                flags |= CURL_CSELECT_IN;
+            }
+            if (events[i].events & EPOLLOUT) {
+                flags |= CURL_CSELECT_OUT;
+            }
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                flags |= CURL_CSELECT_ERR;
+            }
+            curl_multi_socket_action(multi, fd, flags, &running);
+        }
+        if (std::chrono::steady_clock::now() >= curlTimerAt) {
+            curlTimerAt = std::chrono::steady_clock::time_point::max();
+            curl_multi_socket_action(multi, CURL_SOCKET_TIMEOUT, 0, &running);
+        }
+        completeFinished();
+    }
+}
+
+#else
+
+int AsyncHttpEngine::onSocket(CURL*, curl_socket_t, int, void*, void*) {
+    return 0;
+}
+
+int AsyncHttpEngine::onTimer(CURLM*, long, void*) {
+    return 0;
+}
+
+void AsyncHttpEngine::socketLoop() {
+    pollLoop();
+}
+
+#endif
+
+} // namespace api
+} // namespace polymarket_bot
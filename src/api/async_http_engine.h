@@ -0,0 +1,126 @@
+#pragma once
+
+#include "http_transport.h"
+#include "rate_limiter.h"
+#include "../common/thread_pool.h"
+#include <chrono>
+#include <atomic>
+#include <coroutine>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace polymarket_bot {
+namespace api {
+
+class AsyncHttpEngine;
+
+// `co_await engine.fetch(request)` suspends the coroutine until the response is
+// in, then resumes it as a ThreadPool task of the given priority (never on the
+// event-loop thread)
+class FetchAwaiter {
+public:
+    FetchAwaiter(AsyncHttpEngine& engine, HttpRequest request, common::TaskPriority priority)
+        : engine(engine), request(std::move(request)), priority(priority) {}
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle);
+    HttpResponse await_resume() { return std::move(response); }
+
+private:
+    AsyncHttpEngine& engine;
+    HttpRequest request;
+    common::TaskPriority priority;
+    HttpResponse response;
+};
+
+// Asynchronous HTTP engine built on curl_multi.
+//
+// A single event-loop thread drives every in-flight transfer, so callers can
+// submit a whole batch of requests up front and wait for the results instead
+// of blocking on each one in turn. On Linux the loop uses curl's socket
+// interface: curl reports the sockets and timeout it cares about through
+// callbacks, epoll waits on exactly those plus an eventfd that submit() signals,
+// and only sockets with activity are handed back to curl. Completion callbacks
+// run on the event-loop thread and must not block; coroutines co_await fetch()
+// and continue on the shared ThreadPool, and the future overload suits plain code
+// that waits on its own thread. A request's deadline (its own, or the one
+// installed on HttpTransport when it was submitted) is enforced wherever the
+// request is: queued, waiting for a rate-limit token, or on the wire. Past it,
+// the request completes with CURLE_OPERATION_TIMEDOUT. Transfers borrow easy
+// handles from HttpTransport's pool and so share its DNS cache and TLS
+// sessions, but not open connections: the multi handle keeps its own
+// connection cache, apart from the one synchronous requests reuse.
+class AsyncHttpEngine {
+public:
+    using Callback = std::function<void(HttpResponse)>;
+
+    static AsyncHttpEngine& getInstance();
+
+    // Goes through the transport's installed backend, or onto the curl_multi loop when none is installed
+    void submit(HttpRequest request, Callback callback);
+    std::future<HttpResponse> submit(HttpRequest request);
+    FetchAwaiter fetch(HttpRequest request, common::TaskPriority priority = common::TaskPriority::Pricing) {
+        return FetchAwaiter(*this, std::move(request), priority);
+    }
+    void submitLive(HttpRequest request, Callback callback);
+
+    // Convenience: submit every request at once and wait for all of them (results in request order)
+    std::vector<HttpResponse> performAll(std::vector<HttpRequest> requests);
+
+    size_t inFlight() const;
+
+private:
+    AsyncHttpEngine();
+    ~AsyncHttpEngine();
+
+    AsyncHttpEngine(const AsyncHttpEngine&) = delete;
+    AsyncHttpEngine& operator=(const AsyncHttpEngine&) = delete;
+
+    struct Transfer {
+        HttpRequest request;
+        HttpResponse response;
+        Callback callback;
+        std::string host;
+        std::shared_ptr<RateLimiter> limiter;  // Null for unlimited hosts
+        CURL* handle = nullptr;
+        struct curl_slist* headers = nullptr;
+    };
+
+    void eventLoop();
+    void pollLoop();     // curl_multi_poll, where epoll is not available
+    void socketLoop();   // curl socket callbacks driven by epoll
+    void wake();
+    static int onSocket(CURL* easy, curl_socket_t socket, int what, void* engine, void* socketData);
+    static int onTimer(CURLM* multi, long timeoutMs, void* engine);
+    // Returns how long the loop may sleep before a rate-limited transfer can start
+    std::chrono::milliseconds startPending();
+    void completeFinished();
+    // Aborts active transfers whose deadline has passed; returns the time until the next one expires
+    std::chrono::milliseconds cancelExpired();
+    void complete(std::unique_ptr<Transfer> transfer, CURLcode code, const std::string& error = "");
+
+    HttpTransport& transport;
+    CURLM* multi;
+
+    mutable std::mutex queueMutex;
+    std::vector<std::unique_ptr<Transfer>> pending;
+    std::vector<std::unique_ptr<Transfer>> throttled;  // Loop thread only: waiting for a rate-limit token
+    std::unordered_map<CURL*, std::unique_ptr<Transfer>> active;
+    std::atomic<size_t> activeCount;
+    std::atomic<size_t> throttledCount;
+
+    std::atomic<bool> stopping;
+    std::thread loopThread;
+
+    int epollFd = -1;    // -1 when the engine runs pollLoop()
+    int wakeFd = -1;     // eventfd signalled by submit()
+    std::chrono::steady_clock::time_point curlTimerAt = std::chrono::steady_clock::time_point::max();  // Loop thread only
+};
+
+} // namespace api
+} // namespace polymarket_bot
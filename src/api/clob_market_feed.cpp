@@ -0,0 +1,447 @@
+#include "clob_market_feed.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <poll.h>
+
+namespace polymarket_bot {
+namespace api {
+
+namespace {
+
+// Prices and sizes arrive as strings ("0.48") on the market channel, numbers in older payloads
+std::optional<double> number(const nlohmann::json& event, const char* key) {
+    auto it = event.find(key);
+    if (it == event.end() || it->is_null()) {
+        return std::nullopt;
+    }
+    try {
+        if (it->is_string()) {
+            const std::string& text = it->get_ref<const std::string&>();
+            if (text.empty()) {
+                return std::nullopt;
+            }
+            return std::stod(text);
+        }
+        if (it->is_number()) {
+            return it->get<double>();
+        }
+    } catch (const std::exception&) {
+    }
+    return std::nullopt;
+}
+
+const nlohmann::json* levels(const nlohmann::json& event, const char* key, const char* legacyKey) {
+    auto it = event.find(key);
+    if (it == event.end()) {
+        it = event.find(legacyKey);
+    }
+    return (it != event.end() && it->is_array()) ? &*it : nullptr;
+}
+
+constexpr auto pingInterval = std::chrono::seconds(10);
+
+} // namespace
+
+ClobMarketFeed::ClobMarketFeed(std::string url)
+    : url(std::move(url)), running(false), connected(false) {
+}
+
+ClobMarketFeed::~ClobMarketFeed() {
+    stop();
+}
+
+bool ClobMarketFeed::isSupported() {
+    const curl_version_info_data* info = curl_version_info(CURLVERSION_NOW);
+    for (const char* const* protocol = info->protocols; protocol && *protocol; ++protocol) {
+        if (std::strcmp(*protocol, "ws") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ClobMarketFeed::start() {
+    if (running) {
+        return true;
+    }
+    if (url.empty()) {
+        return false;
+    }
+    if (!isSupported()) {
+        std::cerr << "[ClobMarketFeed] libcurl " << curl_version_info(CURLVERSION_NOW)->version
+                  << " was built without WebSocket support; prices will only be polled" << std::endl;
+        return false;
+    }
+    running = true;
+    worker = std::thread(&ClobMarketFeed::run, this);
+    return true;
+}
+
+void ClobMarketFeed::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void ClobMarketFeed::subscribe(const std::vector<std::string>& tokenIds) {
+    std::lock_guard<std::mutex> lock(subscriptionMutex);
+    for (const auto& tokenId : tokenIds) {
+        if (!tokenId.empty() && subscribed.insert(tokenId).second) {
+            unsent.push_back(tokenId);
+        }
+    }
+}
+
+std::optional<ClobQuote> ClobMarketFeed::quote(const std::string& tokenId) const {
+    std::lock_guard<std::mutex> lock(bookMutex);
+    auto it = books.find(tokenId);
+    if (it == books.end()) {
+        return std::nullopt;
+    }
+    return it->second.quote;
+}
+
+std::vector<std::string> ClobMarketFeed::takeChanged() {
+    std::lock_guard<std::mutex> lock(bookMutex);
+    std::vector<std::string> tokens(changed.begin(), changed.end());
+    changed.clear();
+    return tokens;
+}
+
+bool ClobMarketFeed::recordTo(const std::string& path) {
+    std::lock_guard<std::mutex> lock(recordMutex);
+    recording.open(path, std::ios::out | std::ios::app);
+    if (!recording.is_open()) {
+        std::cerr << "[ClobMarketFeed] Cannot open " << path << " for recording" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void ClobMarketFeed::record(const std::string& payload) {
+    std::lock_guard<std::mutex> lock(recordMutex);
+    if (!recording.is_open()) {
+        return;
+    }
+    auto offset = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - connectedAt);
+    std::string line = payload;
+    // Newlines can only be whitespace between JSON tokens, so one frame stays on one line
+    std::replace(line.begin(), line.end(), '\n', ' ');
+    recording << offset.count() << '\t' << line << '\n';
+    recording.flush();
+}
+
+void ClobMarketFeed::run() {
+    auto backoff = std::chrono::seconds(1);
+    while (running) {
+        CURL* curl = connect();
+        if (curl) {
+            backoff = std::chrono::seconds(1);
+            connected = true;
+            pump(curl);
+            connected = false;
+            curl_easy_cleanup(curl);
+        }
+        if (!running) {
+            break;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(bookMutex);
+            stats.reconnects++;
+        }
+        std::cerr << "[ClobMarketFeed] Connection to " << url << " lost, reconnecting in " << backoff.count() << " s" << std::endl;
+        auto resume = std::chrono::steady_clock::now() + backoff;
+        while (running && std::chrono::steady_clock::now() < resume) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        backoff = std::min<std::chrono::seconds>(backoff * 2, std::chrono::seconds(30));
+    }
+}
+
+CURL* ClobMarketFeed::connect() {
+    CURL* curl = curl_easy_init();
+    if (!curl) {
+        return nullptr;
+    }
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    // 2 = perform the WebSocket upgrade, then hand the connection to curl_ws_send/curl_ws_recv
+    curl_easy_setopt(curl, CURLOPT_CONNECT_ONLY, 2L);
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, 10000L);
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_USERAGENT, "polymarket-bot/1.0");
+
+    CURLcode rc = curl_easy_perform(curl);
+    if (rc != CURLE_OK) {
+        std::cerr << "[ClobMarketFeed] Cannot connect to " << url << ": " << curl_easy_strerror(rc) << std::endl;
+        curl_easy_cleanup(curl);
+        return nullptr;
+    }
+    connectedAt = std::chrono::steady_clock::now();
+    std::cout << "[ClobMarketFeed] Connected to " << url << std::endl;
+    return curl;
+}
+
+bool ClobMarketFeed::sendText(CURL* curl, const std::string& text) {
+    size_t offset = 0;
+    while (offset < text.size()) {
+        size_t sent = 0;
+        CURLcode rc = curl_ws_send(curl, text.data() + offset, text.size() - offset, &sent, 0, CURLWS_TEXT);
+        if (rc == CURLE_AGAIN) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        if (rc != CURLE_OK) {
+            std::cerr << "[ClobMarketFeed] Send failed: " << curl_easy_strerror(rc) << std::endl;
+            return false;
+        }
+        offset += sent;
+    }
+    return true;
+}
+
+bool ClobMarketFeed::sendSubscription(CURL* curl, bool initial) {
+    std::vector<std::string> tokens;
+    {
+        std::lock_guard<std::mutex> lock(subscriptionMutex);
+        if (initial) {
+            tokens.assign(subscribed.begin(), subscribed.end());
+        } else {
+            tokens = unsent;
+        }
+        unsent.clear();
+    }
+    if (tokens.empty()) {
+        return true;
+    }
+
+    // The first message opens the market channel; later ones add assets to it
+    nlohmann::json message = {{"assets_ids", tokens}};
+    if (initial) {
+        message["type"] = "market";
+    } else {
+        message["operation"] = "subscribe";
+    }
+    return sendText(curl, message.dump());
+}
+
+bool ClobMarketFeed::pump(CURL* curl) {
+    curl_socket_t socket = CURL_SOCKET_BAD;
+    curl_easy_getinfo(curl, CURLINFO_ACTIVESOCKET, &socket);
+
+    bool channelOpen = false;
+    auto lastPing = std::chrono::steady_clock::now();
+    std::string message;
+    char buffer[65536];
+
+    while (running) {
+        bool hasTokens;
+        bool hasUnsent;
+        {
+            std::lock_guard<std::mutex> lock(subscriptionMutex);
+            hasTokens = !subscribed.empty();
+            hasUnsent = !unsent.empty();
+        }
+        // After a reconnect the opening message carries every token subscribed so far
+        if (!channelOpen && hasTokens) {
+            if (!sendSubscription(curl, true)) {
+                return false;
+            }
+            channelOpen = true;
+        } else if (channelOpen && hasUnsent && !sendSubscription(curl, false)) {
+            return false;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastPing >= pingInterval) {
+            // The market channel drops connections that stay silent
+            if (!sendText(curl, "PING")) {
+                return false;
+            }
+            lastPing = now;
+        }
+
+        size_t received = 0;
+        const struct curl_ws_frame* meta = nullptr;
+        CURLcode rc = curl_ws_recv(curl, buffer, sizeof(buffer), &received, &meta);
+        if (rc == CURLE_AGAIN) {
+            pollfd descriptor{socket, POLLIN, 0};
+            poll(&descriptor, 1, 200);
+            continue;
+        }
+        if (rc != CURLE_OK) {
+            std::cerr << "[ClobMarketFeed] Receive failed: " << curl_easy_strerror(rc) << std::endl;
+            return false;
+        }
+        if (meta->flags & CURLWS_CLOSE) {
+            return false;
+        }
+        if (meta->flags & (CURLWS_PING | CURLWS_PONG)) {
+            // libcurl answers pings itself
+            continue;
+        }
+
+        message.append(buffer, received);
+        if (meta->bytesleft > 0 || (meta->flags & CURLWS_CONT)) {
+            continue;
+        }
+        record(message);
+        handleMessage(message);
+        message.clear();
+    }
+    return true;
+}
+
+void ClobMarketFeed::handleMessage(const std::string& payload) {
+    if (payload == "PONG" || payload.empty()) {
+        return;
+    }
+    nlohmann::json parsed = nlohmann::json::parse(payload, nullptr, false);
+
+    std::lock_guard<std::mutex> lock(bookMutex);
+    stats.messages++;
+    if (parsed.is_discarded()) {
+        stats.parseErrors++;
+        return;
+    }
+    // The initial snapshot comes as an array of book events
+    if (parsed.is_array()) {
+        for (const auto& event : parsed) {
+            if (event.is_object()) {
+                applyEvent(event);
+            }
+        }
+    } else if (parsed.is_object()) {
+        applyEvent(parsed);
+    }
+}
+
+void ClobMarketFeed::applyEvent(const nlohmann::json& event) {
+    std::string type = event.value("event_type", "");
+
+    if (type == "book") {
+        std::string tokenId = event.value("asset_id", "");
+        if (tokenId.empty()) {
+            return;
+        }
+        stats.books++;
+        Book& book = books[tokenId];
+        book.bids.clear();
+        book.asks.clear();
+        if (const auto* bids = levels(event, "bids", "buys")) {
+            for (const auto& level : *bids) {
+                applyLevel(book, "BUY", number(level, "price").value_or(0.0), number(level, "size").value_or(0.0));
+            }
+        }
+        if (const auto* asks = levels(event, "asks", "sells")) {
+            for (const auto& level : *asks) {
+                applyLevel(book, "SELL", number(level, "price").value_or(0.0), number(level, "size").value_or(0.0));
+            }
+        }
+        refreshQuote(tokenId, book, std::nullopt, std::nullopt);
+        return;
+    }
+
+    if (type == "price_change") {
+        stats.priceChanges++;
+        // Current schema: one entry per asset, each carrying the new best bid/ask
+        if (const auto* changes = levels(event, "price_changes", "price_changes")) {
+            for (const auto& change : *changes) {
+                std::string tokenId = change.value("asset_id", "");
+                if (tokenId.empty()) {
+                    continue;
+                }
+                Book& book = books[tokenId];
+                applyLevel(book, change.value("side", ""), number(change, "price").value_or(0.0),
+                           number(change, "size").value_or(0.0));
+                refreshQuote(tokenId, book, number(change, "best_bid"), number(change, "best_ask"));
+            }
+            return;
+        }
+        // Older schema: asset_id at the top and bare level changes
+        std::string tokenId = event.value("asset_id", "");
+        const auto* changes = levels(event, "changes", "changes");
+        if (tokenId.empty() || !changes) {
+            return;
+        }
+        Book& book = books[tokenId];
+        for (const auto& change : *changes) {
+            applyLevel(book, change.value("side", ""), number(change, "price").value_or(0.0),
+                       number(change, "size").value_or(0.0));
+        }
+        refreshQuote(tokenId, book, std::nullopt, std::nullopt);
+        return;
+    }
+
+    if (type == "best_bid_ask") {
+        std::string tokenId = event.value("asset_id", "");
+        if (!tokenId.empty()) {
+            Book& book = books[tokenId];
+            refreshQuote(tokenId, book, number(event, "best_bid"), number(event, "best_ask"));
+        }
+    }
+    // tick_size_change and last_trade_price do not move the top of the book
+}
+
+void ClobMarketFeed::applyLevel(Book& book, const std::string& side, double price, double size) {
+    if (price <= 0.0) {
+        return;
+    }
+    if (side == "BUY") {
+        if (size > 0.0) {
+            book.bids[price] = size;
+        } else {
+            book.bids.erase(price);
+        }
+    } else if (side == "SELL") {
+        if (size > 0.0) {
+            book.asks[price] = size;
+        } else {
+            book.asks.erase(price);
+        }
+    }
+}
+
+void ClobMarketFeed::refreshQuote(const std::string& tokenId, Book& book, std::optional<double> bestBid,
+                                  std::optional<double> bestAsk) {
+    // Levels are authoritative unless the event states the top of the book outright
+    if (!bestBid && !book.bids.empty()) {
+        bestBid = book.bids.begin()->first;
+    }
+    if (!bestAsk && !book.asks.empty()) {
+        bestAsk = book.asks.begin()->first;
+    }
+    if (bestBid != book.quote.bestBid || bestAsk != book.quote.bestAsk) {
+        changed.insert(tokenId);
+        stats.quoteChanges++;
+    }
+    book.quote.bestBid = bestBid;
+    book.quote.bestAsk = bestAsk;
+    book.quote.updatedAt = std::chrono::steady_clock::now();
+}
+
+ClobMarketFeed::Stats ClobMarketFeed::getStats() const {
+    std::lock_guard<std::mutex> lock(bookMutex);
+    return stats;
+}
+
+void ClobMarketFeed::logStats() const {
+    Stats current = getStats();
+    size_t tokens;
+    {
+        std::lock_guard<std::mutex> lock(subscriptionMutex);
+        tokens = subscribed.size();
+    }
+    std::cout << "[ClobMarketFeed] " << (connected ? "Connected" : "Disconnected") << ", " << tokens << " tokens, "
+              << current.messages << " messages (" << current.books << " books, " << current.priceChanges
+              << " price changes), " << current.quoteChanges << " quote changes, " << current.reconnects
+              << " reconnects" << std::endl;
+}
+
+} // namespace api
+} // namespace polymarket_bot
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <curl/curl.h>
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace polymarket_bot {
+namespace api {
+
+// Best bid and ask for one CLOB token, as last seen on the market channel
+struct ClobQuote {
+    std::optional<double> bestBid;
+    std::optional<double> bestAsk;
+    std::chrono::steady_clock::time_point updatedAt;
+};
+
+// Live order-book tops from the CLOB WebSocket market channel.
+//
+// A background thread holds one WebSocket connection (libcurl's
+// CONNECT_ONLY WebSocket mode), subscribes every token id handed to
+// subscribe() and keeps the book levels of each token in memory, applying
+// `book` snapshots and `price_change` deltas. Tokens whose best bid or ask
+// moved are collected until takeChanged() drains them, so callers
+// re-evaluate only what changed instead of re-polling Gamma. The connection
+// is re-established with backoff and resubscribed when it drops. Received
+// frames can be written to a file that the stub server replays.
+class ClobMarketFeed {
+public:
+    explicit ClobMarketFeed(std::string url);
+    ~ClobMarketFeed();
+
+    // Whether the linked libcurl can speak ws:// and wss://
+    static bool isSupported();
+
+    bool start();
+    void stop();
+    bool isConnected() const { return connected; }
+
+    // Adds tokens to the subscription; new ones are sent on the open connection
+    void subscribe(const std::vector<std::string>& tokenIds);
+
+    std::optional<ClobQuote> quote(const std::string& tokenId) const;
+    // Tokens whose best bid or ask changed since the last call
+    std::vector<std::string> takeChanged();
+
+    // Append every received frame to `path` as "<ms since connect>\t<payload>" lines
+    bool recordTo(const std::string& path);
+
+    // Apply one market channel message (a single event or an array of events)
+    void handleMessage(const std::string& payload);
+
+    struct Stats {
+        size_t messages = 0;
+        size_t books = 0;
+        size_t priceChanges = 0;
+        size_t quoteChanges = 0;     // Best bid/ask moves
+        size_t reconnects = 0;
+        size_t parseErrors = 0;
+    };
+    Stats getStats() const;
+    void logStats() const;
+
+private:
+    ClobMarketFeed(const ClobMarketFeed&) = delete;
+    ClobMarketFeed& operator=(const ClobMarketFeed&) = delete;
+
+    struct Book {
+        std::map<double, double, std::greater<double>> bids;  // price -> size, best first
+        std::map<double, double> asks;
+        ClobQuote quote;
+    };
+
+    void run();
+    CURL* connect();
+    // Reads until the connection needs attention; returns false when it is gone
+    bool pump(CURL* curl);
+    bool sendText(CURL* curl, const std::string& text);
+    bool sendSubscription(CURL* curl, bool initial);
+    void record(const std::string& payload);
+
+    // Callers hold bookMutex
+    void applyEvent(const nlohmann::json& event);
+    void applyLevel(Book& book, const std::string& side, double price, double size);
+    void refreshQuote(const std::string& tokenId, Book& book, std::optional<double> bestBid, std::optional<double> bestAsk);
+
+    std::string url;
+    std::atomic<bool> running;
+    std::atomic<bool> connected;
+    std::thread worker;
+
+    mutable std::mutex subscriptionMutex;
+    std::set<std::string> subscribed;
+    std::vector<std::string> unsent;   // Subscribed while connected, not yet sent
+
+    mutable std::mutex bookMutex;
+    std::unordered_map<std::string, Book> books;
+    std::unordered_set<std::string> changed;
+    Stats stats;
+
+    std::mutex recordMutex;
+    std::ofstream recording;
+    std::chrono::steady_clock::time_point connectedAt;
+};
+
+} // namespace api
+} // namespace polymarket_bot
@@ -0,0 +1,79 @@
+#include "connection_warmer.h"
+#include "async_http_engine.h"
+#include "http_transport.h"
+#include <algorithm>
+#include <future>
+#include <iostream>
+
+namespace polymarket_bot {
+namespace api {
+
+ConnectionWarmer::ConnectionWarmer(std::vector<std::string> baseUrls, size_t connectionsPerHost)
+    : connectionsPerHost(std::max<size_t>(1, connectionsPerHost)) {
+    for (const auto& url : baseUrls) {
+        if (url.empty()) {
+            continue;
+        }
+        std::string host = HttpTransport::hostKey(url);
+        if (std::find(hosts.begin(), hosts.end(), host) == hosts.end()) {
+            hosts.push_back(host);
+        }
+    }
+}
+
+ConnectionWarmer::Result ConnectionWarmer::warm(const Deadline& deadline) {
+    Result result;
+    auto& transport = HttpTransport::getInstance();
+    if (transport.getBackend()) {
+        return result;
+    }
+
+    auto started = Deadline::Clock::now();
+    auto makeRequest = [&deadline](const std::string& host) {
+        HttpRequest request;
+        request.method = "HEAD";
+        request.url = host + "/";
+        request.deadline = deadline;
+        return request;
+    };
+
+    std::vector<std::future<HttpResponse>> responses;
+    for (const auto& host : hosts) {
+        // The synchronous pool keeps one connection per handle, and its callers are sequential. performLive
+        // blocks for the whole handshake, so it runs on its own thread, not on a ThreadPool worker
+        responses.push_back(std::async(std::launch::async, [&transport, request = makeRequest(host)]() {
+            return transport.performLive(request);
+        }));
+        for (size_t i = 0; i < connectionsPerHost; ++i) {
+            responses.push_back(AsyncHttpEngine::getInstance().submit(makeRequest(host)));
+        }
+    }
+
+    for (auto& response : responses) {
+        // A status code of any kind means DNS, TCP and TLS all completed
+        HttpResponse warmed = response.get();
+        if (warmed.statusCode > 0) {
+            result.connected++;
+        } else {
+            result.failed++;
+        }
+    }
+    result.hosts = hosts.size();
+    result.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(Deadline::Clock::now() - started).count();
+    return result;
+}
+
+void ConnectionWarmer::logResult(const Result& result) const {
+    if (result.hosts == 0) {
+        return;
+    }
+    std::cout << "[ConnectionWarmer] Warmed " << result.connected << " connections to " << result.hosts
+              << " hosts in " << result.elapsedMs << " ms";
+    if (result.failed > 0) {
+        std::cout << " (" << result.failed << " failed)";
+    }
+    std::cout << std::endl;
+}
+
+} // namespace api
+} // namespace polymarket_bot
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "deadline.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace polymarket_bot {
+namespace api {
+
+// Opens connections to the API hosts ahead of a scan.
+//
+// Between scans idle connections are closed by the servers (and by libcurl
+// after two minutes) and DNS entries expire, so the first requests of every
+// cycle pay for a lookup, a TCP connect and a TLS handshake. warm() sends a
+// HEAD to each host root through both request paths: several concurrent
+// requests through AsyncHttpEngine, whose connection cache the bulk fetches
+// use, and one through the synchronous handle pool used for order placement.
+// The connections are then left idle for the scan to pick up.
+class ConnectionWarmer {
+public:
+    ConnectionWarmer(std::vector<std::string> baseUrls, size_t connectionsPerHost);
+
+    struct Result {
+        size_t hosts = 0;
+        size_t connected = 0;   // Warm-up requests that got a response (any status)
+        size_t failed = 0;
+        long long elapsedMs = 0;
+    };
+
+    // Blocks until every warm-up request finished or `deadline` passed. Does nothing while a
+    // record/replay backend is installed, since those never touch the network.
+    Result warm(const Deadline& deadline);
+    void logResult(const Result& result) const;
+
+private:
+    std::vector<std::string> hosts;   // Deduplicated "scheme://host[:port]" keys
+    size_t connectionsPerHost;
+};
+
+} // namespace api
+} // namespace polymarket_bot
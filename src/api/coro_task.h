@@ -0,0 +1,242 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace polymarket_bot {
+namespace api {
+
+template <typename T>
+class Task;
+
+namespace detail {
+
+// Resumes whoever awaited the task once it finishes (symmetric transfer, so long chains do not grow the stack)
+struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> finished) noexcept {
+        auto continuation = finished.promise().continuation;
+        return continuation ? continuation : std::noop_coroutine();
+    }
+    void await_resume() const noexcept {}
+};
+
+struct PromiseBase {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr error;
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() { error = std::current_exception(); }
+};
+
+template <typename T>
+struct TaskPromise : PromiseBase {
+    std::optional<T> value;
+
+    Task<T> get_return_object();
+    void return_value(T result) { value.emplace(std::move(result)); }
+    T take() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return std::move(*value);
+    }
+};
+
+template <>
+struct TaskPromise<void> : PromiseBase {
+    Task<void> get_return_object();
+    void return_void() const noexcept {}
+    void take() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+// Fire-and-forget coroutine: starts at once and frees itself when it finishes
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+// Resumes one awaiting coroutine after `count` arrivals; safe if they all happen before it suspends
+class Latch {
+public:
+    explicit Latch(size_t count) : remaining(count + 1) {}
+
+    void arrive() {
+        if (--remaining == 0) {
+            awaiting.resume();
+        }
+    }
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> handle) noexcept {
+        awaiting = handle;
+        return --remaining > 0;
+    }
+    void await_resume() const noexcept {}
+
+private:
+    std::atomic<size_t> remaining;
+    std::coroutine_handle<> awaiting;
+};
+
+} // namespace detail
+
+// Lazily started coroutine producing a T.
+//
+// Nothing runs until the task is awaited (or handed to syncWait / whenAll);
+// the awaiting coroutine resumes on whichever thread finishes the task.
+// Exceptions thrown inside the task are rethrown at the co_await.
+template <typename T = void>
+class Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle) {
+                handle.destroy();
+            }
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    struct Awaiter {
+        std::coroutine_handle<promise_type> handle;
+
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            handle.promise().continuation = awaiting;
+            return handle;
+        }
+        T await_resume() { return handle.promise().take(); }
+    };
+    Awaiter operator co_await() const noexcept { return Awaiter{handle}; }
+
+private:
+    friend struct detail::TaskPromise<T>;
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+// Owns the task and the promise, so the waiting thread may return the moment the value is set
+template <typename T>
+Detached completeInto(Task<T> task, std::shared_ptr<std::promise<T>> done) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await task;
+            done->set_value();
+        } else {
+            done->set_value(co_await task);
+        }
+    } catch (...) {
+        done->set_exception(std::current_exception());
+    }
+}
+
+template <typename T>
+struct WhenAllState {
+    std::vector<Task<T>> tasks;
+    std::vector<std::optional<T>> results;
+    std::atomic<size_t> next{0};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+};
+
+template <typename T>
+Detached runTasks(WhenAllState<T>& state, Latch& latch) {
+    for (size_t i = state.next++; i < state.tasks.size(); i = state.next++) {
+        try {
+            state.results[i].emplace(co_await state.tasks[i]);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(state.errorMutex);
+            if (!state.error) {
+                state.error = std::current_exception();
+            }
+        }
+    }
+    latch.arrive();
+}
+
+} // namespace detail
+
+// Runs `task` and blocks the calling thread until it finishes. For entry from
+// plain code only: calling it from inside a coroutine can starve the executor.
+template <typename T>
+T syncWait(Task<T> task) {
+    auto done = std::make_shared<std::promise<T>>();
+    auto result = done->get_future();
+    detail::completeInto(std::move(task), done);
+    return result.get();
+}
+
+// Runs every task concurrently, at most `maxConcurrent` at a time (0 for no cap),
+// and returns their results in task order. The first exception is rethrown once all are done.
+template <typename T>
+Task<std::vector<T>> whenAll(std::vector<Task<T>> tasks, size_t maxConcurrent = 0) {
+    detail::WhenAllState<T> state;
+    state.results.resize(tasks.size());
+    state.tasks = std::move(tasks);
+
+    size_t runners = state.tasks.size();
+    if (maxConcurrent > 0 && maxConcurrent < runners) {
+        runners = maxConcurrent;
+    }
+    detail::Latch latch(runners);
+    for (size_t r = 0; r < runners; ++r) {
+        detail::runTasks(state, latch);
+    }
+    co_await latch;
+
+    if (state.error) {
+        std::rethrow_exception(state.error);
+    }
+    std::vector<T> results;
+    results.reserve(state.results.size());
+    for (auto& result : state.results) {
+        results.push_back(std::move(*result));
+    }
+    co_return results;
+}
+
+} // namespace api
+} // namespace polymarket_bot
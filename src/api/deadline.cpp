@@ -0,0 +1,104 @@
+#include "deadline.h"
+#include "http_transport.h"
+#include <iostream>
+
+namespace polymarket_bot {
+namespace api {
+
+std::chrono::milliseconds Deadline::remaining(Clock::time_point now) const {
+    if (!isSet()) {
+        return std::chrono::milliseconds::max();
+    }
+    if (now >= when) {
+        return std::chrono::milliseconds(0);
+    }
+    return std::chrono::ceil<std::chrono::milliseconds>(when - now);
+}
+
+ScanBudget::ScanBudget(std::chrono::milliseconds total)
+    : total(total), started(Deadline::Clock::now()),
+      scanDeadline(total.count() > 0 ? Deadline(started + total) : Deadline::never()) {
+}
+
+ScanBudget::~ScanBudget() {
+    HttpTransport::getInstance().setDeadline(Deadline::never());
+}
+
+ScanBudget::Stage ScanBudget::stage(const std::string& name, double share) {
+    Deadline deadline = scanDeadline;
+    if (deadline.isSet() && share < 1.0) {
+        auto limit = std::chrono::duration_cast<std::chrono::milliseconds>(total * share);
+        deadline = deadline.earliest(Deadline::in(limit));
+    }
+    return Stage(this, name, deadline);
+}
+
+ScanBudget::Stage ScanBudget::unbounded(const std::string& name) {
+    return Stage(this, name, Deadline::never());
+}
+
+ScanBudget::Stage::Stage(ScanBudget* budget, std::string name, Deadline deadline)
+    : budget(budget), name(std::move(name)), stageDeadline(deadline), started(Deadline::Clock::now()) {
+    auto& transport = HttpTransport::getInstance();
+    previous = transport.getDeadline();
+    cancelledAtStart = transport.deadlineCancellations();
+    transport.setDeadline(stageDeadline);
+}
+
+ScanBudget::Stage::Stage(Stage&& other) noexcept
+    : budget(other.budget), name(std::move(other.name)), stageDeadline(other.stageDeadline), previous(other.previous),
+      started(other.started), cancelledAtStart(other.cancelledAtStart) {
+    other.budget = nullptr;
+}
+
+ScanBudget::Stage::~Stage() {
+    if (!budget) {
+        return;
+    }
+    budget->finish(*this);
+    HttpTransport::getInstance().setDeadline(previous);
+}
+
+void ScanBudget::finish(const Stage& stage) {
+    auto now = Deadline::Clock::now();
+    StageReport report;
+    report.name = stage.name;
+    report.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - stage.started).count();
+    if (stage.stageDeadline.isSet()) {
+        report.limitMs = std::chrono::duration_cast<std::chrono::milliseconds>(stage.stageDeadline.time() - stage.started).count();
+    }
+    report.cancelled = HttpTransport::getInstance().deadlineCancellations() - stage.cancelledAtStart;
+    report.overran = stage.stageDeadline.expired(now) || report.cancelled > 0;
+    stages.push_back(report);
+}
+
+bool ScanBudget::overran() const {
+    for (const auto& stage : stages) {
+        if (stage.overran) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ScanBudget::logReport() const {
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Deadline::Clock::now() - started).count();
+    std::cout << "[ScanBudget] Scan took " << elapsed << " ms";
+    if (scanDeadline.isSet()) {
+        std::cout << " of " << total.count() << " ms budget";
+    }
+    std::cout << std::endl;
+    for (const auto& stage : stages) {
+        std::cout << "[ScanBudget]   " << stage.name << ": " << stage.elapsedMs << " ms";
+        if (stage.limitMs >= 0) {
+            std::cout << " (limit " << stage.limitMs << " ms)";
+        }
+        if (stage.overran) {
+            std::cout << " OVERRAN, " << stage.cancelled << " requests cancelled, continued with partial data";
+        }
+        std::cout << std::endl;
+    }
+}
+
+} // namespace api
+} // namespace polymarket_bot
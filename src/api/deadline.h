@@ -0,0 +1,99 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace polymarket_bot {
+namespace api {
+
+// Point in time by which a request, or a whole stage of work, must be done.
+// A default-constructed deadline never expires.
+class Deadline {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Deadline() : when(Clock::time_point::max()) {}
+    explicit Deadline(Clock::time_point when) : when(when) {}
+
+    static Deadline never() { return Deadline(); }
+    static Deadline in(std::chrono::milliseconds budget) { return Deadline(Clock::now() + budget); }
+
+    bool isSet() const { return when != Clock::time_point::max(); }
+    bool expired(Clock::time_point now = Clock::now()) const { return isSet() && now >= when; }
+    Clock::time_point time() const { return when; }
+
+    // Time left, zero once expired and milliseconds::max() for a deadline that is not set
+    std::chrono::milliseconds remaining(Clock::time_point now = Clock::now()) const;
+
+    Deadline earliest(const Deadline& other) const { return other.when < when ? other : *this; }
+
+private:
+    Clock::time_point when;
+};
+
+// Latency budget for one scan cycle, split into stages.
+//
+// While a stage is open its deadline (the stage limit, capped by what is
+// left of the scan) is installed on HttpTransport, so every request the
+// stage issues, synchronous or through AsyncHttpEngine, inherits it and is
+// cancelled when it passes. The stage then carries on with whatever data
+// arrived in time. Closing the stage restores the deadline that was
+// installed before, and report() lists the stages that ran over.
+class ScanBudget {
+public:
+    explicit ScanBudget(std::chrono::milliseconds total);
+    ~ScanBudget();
+
+    class Stage {
+    public:
+        ~Stage();
+        Stage(Stage&& other) noexcept;
+        Stage(const Stage&) = delete;
+        Stage& operator=(const Stage&) = delete;
+        Stage& operator=(Stage&&) = delete;
+
+        const Deadline& deadline() const { return stageDeadline; }
+
+    private:
+        friend class ScanBudget;
+        Stage(ScanBudget* budget, std::string name, Deadline deadline);
+
+        ScanBudget* budget;
+        std::string name;
+        Deadline stageDeadline;
+        Deadline previous;
+        Deadline::Clock::time_point started;
+        size_t cancelledAtStart;
+    };
+
+    // Opens a stage allowed `share` of the total budget, capped by what is left of the scan
+    Stage stage(const std::string& name, double share = 1.0);
+    // Opens a stage with no deadline at all (e.g. order placement, which must not be cut off mid-request)
+    Stage unbounded(const std::string& name);
+
+    bool expired() const { return scanDeadline.expired(); }
+    const Deadline& deadline() const { return scanDeadline; }
+
+    struct StageReport {
+        std::string name;
+        long long elapsedMs = 0;
+        long long limitMs = -1;   // -1 when the stage had no deadline
+        size_t cancelled = 0;     // Requests cut off by the deadline while the stage was open
+        bool overran = false;
+    };
+    const std::vector<StageReport>& report() const { return stages; }
+    bool overran() const;
+    void logReport() const;
+
+private:
+    void finish(const Stage& stage);
+
+    std::chrono::milliseconds total;
+    Deadline::Clock::time_point started;
+    Deadline scanDeadline;
+    std::vector<StageReport> stages;
+};
+
+} // namespace api
+} // namespace polymarket_bot
@@ -0,0 +1,545 @@
+#include "gamma_market_decoder.h"
+#include <charconv>
+#include <cstring>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+using polymarket_bot::common::GammaMarket;
+
+namespace polymarket_bot {
+namespace api {
+
+namespace {
+
+// One GammaMarket member per JSON key; exactly one of the member pointers is set
+struct FieldSpec {
+    std::string_view key;
+    std::optional<std::string> GammaMarket::*text = nullptr;
+    std::optional<double> GammaMarket::*number = nullptr;
+    std::optional<bool> GammaMarket::*flag = nullptr;
+};
+
+// Same keys and types as from_json(const json&, GammaMarket&) in common/types.h
+const FieldSpec fieldTable[] = {
+    {.key = "id", .text = &GammaMarket::id},
+    {.key = "question", .text = &GammaMarket::question},
+    {.key = "conditionId", .text = &GammaMarket::conditionId},
+    {.key = "slug", .text = &GammaMarket::slug},
+    {.key = "resolutionSource", .text = &GammaMarket::resolutionSource},
+    {.key = "endDate", .text = &GammaMarket::endDate},
+    {.key = "liquidity", .text = &GammaMarket::liquidity},
+    {.key = "startDate", .text = &GammaMarket::startDate},
+    {.key = "image", .text = &GammaMarket::image},
+    {.key = "icon", .text = &GammaMarket::icon},
+    {.key = "description", .text = &GammaMarket::description},
+    {.key = "outcomes", .text = &GammaMarket::outcomes},
+    {.key = "outcomePrices", .text = &GammaMarket::outcomePrices},
+    {.key = "volume", .text = &GammaMarket::volume},
+    {.key = "active", .flag = &GammaMarket::active},
+    {.key = "closed", .flag = &GammaMarket::closed},
+    {.key = "marketMakerAddress", .text = &GammaMarket::marketMakerAddress},
+    {.key = "createdAt", .text = &GammaMarket::createdAt},
+    {.key = "updatedAt", .text = &GammaMarket::updatedAt},
+    {.key = "new", .flag = &GammaMarket::new_market},
+    {.key = "featured", .flag = &GammaMarket::featured},
+    {.key = "submitted_by", .text = &GammaMarket::submitted_by},
+    {.key = "archived", .flag = &GammaMarket::archived},
+    {.key = "resolvedBy", .text = &GammaMarket::resolvedBy},
+    {.key = "restricted", .flag = &GammaMarket::restricted},
+    {.key = "groupItemTitle", .text = &GammaMarket::groupItemTitle},
+    {.key = "groupItemThreshold", .text = &GammaMarket::groupItemThreshold},
+    {.key = "questionID", .text = &GammaMarket::questionID},
+    {.key = "enableOrderBook", .flag = &GammaMarket::enableOrderBook},
+    {.key = "orderPriceMinTickSize", .number = &GammaMarket::orderPriceMinTickSize},
+    {.key = "orderMinSize", .number = &GammaMarket::orderMinSize},
+    {.key = "volumeNum", .number = &GammaMarket::volumeNum},
+    {.key = "liquidityNum", .number = &GammaMarket::liquidityNum},
+    {.key = "endDateIso", .text = &GammaMarket::endDateIso},
+    {.key = "startDateIso", .text = &GammaMarket::startDateIso},
+    {.key = "hasReviewedDates", .flag = &GammaMarket::hasReviewedDates},
+    {.key = "volume24hr", .number = &GammaMarket::volume24hr},
+    {.key = "volume1wk", .number = &GammaMarket::volume1wk},
+    {.key = "volume1mo", .number = &GammaMarket::volume1mo},
+    {.key = "volume1yr", .number = &GammaMarket::volume1yr},
+    {.key = "clobTokenIds", .text = &GammaMarket::clobTokenIds},
+    {.key = "umaBond", .text = &GammaMarket::umaBond},
+    {.key = "umaReward", .text = &GammaMarket::umaReward},
+    {.key = "volume24hrClob", .number = &GammaMarket::volume24hrClob},
+    {.key = "volume1wkClob", .number = &GammaMarket::volume1wkClob},
+    {.key = "volume1moClob", .number = &GammaMarket::volume1moClob},
+    {.key = "volume1yrClob", .number = &GammaMarket::volume1yrClob},
+    {.key = "volumeClob", .number = &GammaMarket::volumeClob},
+    {.key = "liquidityClob", .number = &GammaMarket::liquidityClob},
+    {.key = "acceptingOrders", .flag = &GammaMarket::acceptingOrders},
+    {.key = "negRisk", .flag = &GammaMarket::negRisk},
+    {.key = "ready", .flag = &GammaMarket::ready},
+    {.key = "funded", .flag = &GammaMarket::funded},
+    {.key = "acceptingOrdersTimestamp", .text = &GammaMarket::acceptingOrdersTimestamp},
+    {.key = "cyom", .flag = &GammaMarket::cyom},
+    {.key = "competitive", .number = &GammaMarket::competitive},
+    {.key = "pagerDutyNotificationEnabled", .flag = &GammaMarket::pagerDutyNotificationEnabled},
+    {.key = "approved", .flag = &GammaMarket::approved},
+    {.key = "rewardsMinSize", .number = &GammaMarket::rewardsMinSize},
+    {.key = "rewardsMaxSpread", .number = &GammaMarket::rewardsMaxSpread},
+    {.key = "spread", .number = &GammaMarket::spread},
+    {.key = "umaResolutionStatuses", .text = &GammaMarket::umaResolutionStatuses},
+    {.key = "oneDayPriceChange", .number = &GammaMarket::oneDayPriceChange},
+    {.key = "oneWeekPriceChange", .number = &GammaMarket::oneWeekPriceChange},
+    {.key = "oneMonthPriceChange", .number = &GammaMarket::oneMonthPriceChange},
+    {.key = "lastTradePrice", .number = &GammaMarket::lastTradePrice},
+    {.key = "bestBid", .number = &GammaMarket::bestBid},
+    {.key = "bestAsk", .number = &GammaMarket::bestAsk},
+    {.key = "automaticallyActive", .flag = &GammaMarket::automaticallyActive},
+    {.key = "clearBookOnStart", .flag = &GammaMarket::clearBookOnStart},
+    {.key = "manualActivation", .flag = &GammaMarket::manualActivation},
+    {.key = "negRiskOther", .flag = &GammaMarket::negRiskOther},
+    {.key = "pendingDeployment", .flag = &GammaMarket::pendingDeployment},
+    {.key = "deploying", .flag = &GammaMarket::deploying},
+    {.key = "rfqEnabled", .flag = &GammaMarket::rfqEnabled},
+};
+
+bool isDelimiter(char c) {
+    return c == ',' || c == '}' || c == ']' || c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+void appendUtf8(std::string& out, unsigned codePoint) {
+    if (codePoint < 0x80) {
+        out += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        out += static_cast<char>(0xC0 | (codePoint >> 6));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        out += static_cast<char>(0xE0 | (codePoint >> 12));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (codePoint >> 18));
+        out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+
+bool readHex4(std::string_view in, size_t at, unsigned& value) {
+    if (at + 4 > in.size()) {
+        return false;
+    }
+    auto result = std::from_chars(in.data() + at, in.data() + at + 4, value, 16);
+    return result.ec == std::errc() && result.ptr == in.data() + at + 4;
+}
+
+// The contents of a JSON string (between the quotes) with its escapes resolved
+bool unescape(std::string_view in, std::string& out) {
+    out.clear();
+    out.reserve(in.size());
+    for (size_t i = 0; i < in.size(); ++i) {
+        if (in[i] != '\\') {
+            out += in[i];
+            continue;
+        }
+        if (++i == in.size()) {
+            return false;
+        }
+        switch (in[i]) {
+        case '"': out += '"'; break;
+        case '\\': out += '\\'; break;
+        case '/': out += '/'; break;
+        case 'b': out += '\b'; break;
+        case 'f': out += '\f'; break;
+        case 'n': out += '\n'; break;
+        case 'r': out += '\r'; break;
+        case 't': out += '\t'; break;
+        case 'u': {
+            unsigned codePoint = 0;
+            if (!readHex4(in, i + 1, codePoint)) {
+                return false;
+            }
+            i += 4;
+            // A high surrogate must be followed by \u and its low half
+            if (codePoint >= 0xD800 && codePoint < 0xDC00) {
+                unsigned low = 0;
+                if (i + 2 >= in.size() || in[i + 1] != '\\' || in[i + 2] != 'u' || !readHex4(in, i + 3, low) ||
+                    low < 0xDC00 || low > 0xDFFF) {
+                    return false;
+                }
+                i += 6;
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+            }
+            appendUtf8(out, codePoint);
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+bool parseDouble(std::string_view text, double& value) {
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+// Walks JSON text without building anything; callers ask for the pieces they keep
+class Scanner {
+public:
+    enum class Token { String, Number, True, False, Null, Container };
+
+    explicit Scanner(std::string_view text) : p(text.data()), end(text.data() + text.size()) {}
+
+    const char* position() const { return p; }
+
+    void skipSpace() {
+        while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) {
+            ++p;
+        }
+    }
+
+    bool consume(char c) {
+        skipSpace();
+        if (p < end && *p == c) {
+            ++p;
+            return true;
+        }
+        return false;
+    }
+
+    bool atEnd() {
+        skipSpace();
+        return p == end;
+    }
+
+    // The text between the quotes of the next string, escapes left in place
+    bool string(std::string_view& out, bool& escaped) {
+        if (!consume('"')) {
+            return false;
+        }
+        const char* start = p;
+        while (true) {
+            auto* quote = static_cast<const char*>(std::memchr(p, '"', end - p));
+            if (!quote) {
+                return false;
+            }
+            p = quote + 1;
+            size_t slashes = 0;
+            for (const char* back = quote; back > start && back[-1] == '\\'; --back) {
+                ++slashes;
+            }
+            if (slashes % 2 == 0) {
+                out = std::string_view(start, quote - start);
+                escaped = std::memchr(start, '\\', quote - start) != nullptr;
+                return true;
+            }
+        }
+    }
+
+    // Reads a scalar into text (string contents or the number itself); objects and arrays are skipped
+    bool value(Token& token, std::string_view& text, bool& escaped) {
+        skipSpace();
+        if (p == end) {
+            return false;
+        }
+        escaped = false;
+        switch (*p) {
+        case '"':
+            token = Token::String;
+            return string(text, escaped);
+        case '{':
+        case '[':
+            token = Token::Container;
+            return skipContainer();
+        default:
+            break;
+        }
+        const char* start = p;
+        while (p < end && !isDelimiter(*p)) {
+            ++p;
+        }
+        text = std::string_view(start, p - start);
+        if (text == "true") {
+            token = Token::True;
+        } else if (text == "false") {
+            token = Token::False;
+        } else if (text == "null") {
+            token = Token::Null;
+        } else {
+            token = Token::Number;
+        }
+        return !text.empty();
+    }
+
+    bool skipValue() {
+        Token token;
+        std::string_view text;
+        bool escaped;
+        return value(token, text, escaped);
+    }
+
+private:
+    // Matches brackets and steps over strings; the contents are not checked
+    bool skipContainer() {
+        size_t depth = 0;
+        while (p < end) {
+            char c = *p;
+            if (c == '"') {
+                std::string_view ignored;
+                bool escaped;
+                if (!string(ignored, escaped)) {
+                    return false;
+                }
+                continue;
+            }
+            ++p;
+            if (c == '{' || c == '[') {
+                ++depth;
+            } else if ((c == '}' || c == ']') && --depth == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const char* p;
+    const char* end;
+};
+
+// Stores one projected value, converting between strings, numbers and booleans where the API is loose
+bool assign(const FieldSpec& field, Scanner::Token token, std::string_view text, bool escaped, GammaMarket& market) {
+    using Token = Scanner::Token;
+    if (token == Token::Null || token == Token::Container) {
+        return true;
+    }
+
+    std::string decoded;
+    if (escaped) {
+        if (!unescape(text, decoded)) {
+            return false;
+        }
+        text = decoded;
+    }
+
+    if (field.text) {
+        if (escaped) {
+            market.*field.text = std::move(decoded);
+        } else {
+            market.*field.text = std::string(text);
+        }
+    } else if (field.number) {
+        double value = 0.0;
+        if (token != Token::True && token != Token::False && parseDouble(text, value)) {
+            market.*field.number = value;
+        }
+    } else if (field.flag) {
+        if (token == Token::True || (token == Token::String && text == "true")) {
+            market.*field.flag = true;
+        } else if (token == Token::False || (token == Token::String && text == "false")) {
+            market.*field.flag = false;
+        }
+    }
+    return true;
+}
+
+// The elements of a JSON array held inside a string field, e.g. ["Yes", "No"] or ["0.55", 0.45].
+// Strings come back unescaped and numbers as their text; anything else is malformed.
+bool readEncodedArray(std::string_view text, std::vector<std::string>& elements) {
+    Scanner scanner(text);
+    elements.clear();
+    if (!scanner.consume('[')) {
+        return false;
+    }
+    if (!scanner.consume(']')) {
+        do {
+            Scanner::Token token;
+            std::string_view element;
+            bool escaped;
+            if (!scanner.value(token, element, escaped) ||
+                (token != Scanner::Token::String && token != Scanner::Token::Number)) {
+                return false;
+            }
+            if (escaped) {
+                if (!unescape(element, elements.emplace_back())) {
+                    return false;
+                }
+            } else {
+                elements.emplace_back(element);
+            }
+        } while (scanner.consume(','));
+        if (!scanner.consume(']')) {
+            return false;
+        }
+    }
+    return scanner.atEnd();
+}
+
+bool decodeMarket(Scanner& scanner, const std::vector<std::pair<std::string_view, size_t>>& wanted, GammaMarket& market) {
+    if (!scanner.consume('{')) {
+        return false;
+    }
+    if (scanner.consume('}')) {
+        return true;
+    }
+    do {
+        std::string_view key;
+        bool keyEscaped;
+        if (!scanner.string(key, keyEscaped) || !scanner.consume(':')) {
+            return false;
+        }
+        const FieldSpec* field = nullptr;
+        for (const auto& [name, row] : wanted) {
+            if (name == key) {
+                field = &fieldTable[row];
+                break;
+            }
+        }
+        if (!field) {
+            if (!scanner.skipValue()) {
+                return false;
+            }
+            continue;
+        }
+        Scanner::Token token;
+        std::string_view text;
+        bool escaped;
+        if (!scanner.value(token, text, escaped) || !assign(*field, token, text, escaped, market)) {
+            return false;
+        }
+    } while (scanner.consume(','));
+    return scanner.consume('}');
+}
+
+} // namespace
+
+const char* outcomeErrorName(OutcomeError error) {
+    switch (error) {
+    case OutcomeError::None: return "none";
+    case OutcomeError::Missing: return "missing outcomes or prices";
+    case OutcomeError::Malformed: return "malformed outcome arrays";
+    case OutcomeError::Mismatched: return "outcomes, prices and tokens do not line up";
+    case OutcomeError::TooMany: return "too many outcomes";
+    }
+    return "unknown";
+}
+
+GammaProjection::GammaProjection(std::initializer_list<std::string_view> keys, bool keepRaw) : keepRaw(keepRaw) {
+    for (auto key : keys) {
+        for (size_t row = 0; row < std::size(fieldTable); ++row) {
+            if (fieldTable[row].key == key) {
+                wanted.emplace_back(fieldTable[row].key, row);
+                break;
+            }
+        }
+    }
+}
+
+const GammaProjection& GammaProjection::matching() {
+    static const GammaProjection projection{"id", "slug", "conditionId", "question", "outcomes", "outcomePrices",
+                                            "clobTokenIds", "volumeNum", "liquidityNum", "bestBid", "bestAsk",
+                                            "lastTradePrice", "spread", "active", "closed", "acceptingOrders",
+                                            "endDateIso"};
+    return projection;
+}
+
+const GammaProjection& GammaProjection::all() {
+    static const GammaProjection projection = []() {
+        GammaProjection everything({}, false);
+        for (size_t row = 0; row < std::size(fieldTable); ++row) {
+            everything.wanted.emplace_back(fieldTable[row].key, row);
+        }
+        return everything;
+    }();
+    return projection;
+}
+
+GammaMarket DecodedGammaMarket::full() const {
+    if (raw.empty()) {
+        return market;
+    }
+    try {
+        GammaMarket decoded;
+        from_json(json::parse(raw), decoded);
+        return decoded;
+    } catch (const std::exception&) {
+        // from_json is strict about types; the projection already holds what could be read
+        return market;
+    }
+}
+
+std::optional<std::vector<DecodedGammaMarket>> GammaMarketDecoder::decodePage(std::string_view body,
+                                                                              const GammaProjection& projection) {
+    Scanner scanner(body);
+    std::vector<DecodedGammaMarket> markets;
+    if (!scanner.consume('[')) {
+        return std::nullopt;   // An error object rather than a list of markets
+    }
+    if (!scanner.consume(']')) {
+        do {
+            scanner.skipSpace();
+            const char* start = scanner.position();
+            DecodedGammaMarket& decoded = markets.emplace_back();
+            if (!decodeMarket(scanner, projection.wanted, decoded.market)) {
+                return std::nullopt;
+            }
+            decoded.outcomeError = decodeOutcomes(decoded.market, decoded.outcomes);
+            if (projection.keepRaw) {
+                decoded.raw.assign(start, scanner.position());
+            }
+        } while (scanner.consume(','));
+        if (!scanner.consume(']')) {
+            return std::nullopt;
+        }
+    }
+    if (!scanner.atEnd()) {
+        return std::nullopt;
+    }
+    return markets;
+}
+
+OutcomeError GammaMarketDecoder::decodeOutcomes(const GammaMarket& market, std::vector<GammaOutcome>& outcomes) {
+    outcomes.clear();
+    if (!market.outcomes || !market.outcomePrices) {
+        return OutcomeError::Missing;
+    }
+    std::vector<std::string> names;
+    std::vector<std::string> prices;
+    std::vector<std::string> tokens;
+    if (!readEncodedArray(*market.outcomes, names) || !readEncodedArray(*market.outcomePrices, prices) ||
+        (market.clobTokenIds && !readEncodedArray(*market.clobTokenIds, tokens))) {
+        return OutcomeError::Malformed;
+    }
+    // A market without CLOB tokens can still be priced from outcomePrices
+    if (names.size() != prices.size() || (!tokens.empty() && tokens.size() != names.size())) {
+        return OutcomeError::Mismatched;
+    }
+
+    outcomes.resize(names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (!parseDouble(prices[i], outcomes[i].price)) {
+            outcomes.clear();
+            return OutcomeError::Malformed;
+        }
+        outcomes[i].name = std::move(names[i]);
+        if (!tokens.empty()) {
+            outcomes[i].tokenId = std::move(tokens[i]);
+        }
+    }
+    return OutcomeError::None;
+}
+
+std::optional<std::vector<GammaMarket>> GammaMarketDecoder::decodePageDom(const std::string& body) {
+    try {
+        json j = json::parse(body);
+        if (!j.is_array()) {
+            return std::nullopt;
+        }
+        std::vector<GammaMarket> markets(j.size());
+        for (size_t i = 0; i < j.size(); ++i) {
+            from_json(j[i], markets[i]);
+        }
+        return markets;
+    } catch (const std::exception&) {
+        return std::nullopt;
+    }
+}
+
+} // namespace api
+} // namespace polymarket_bot
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "../common/types.h"
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace polymarket_bot {
+namespace api {
+
+// The GammaMarket fields a caller reads, named by their JSON keys
+class GammaProjection {
+public:
+    // Unknown keys are ignored. keepRaw also copies each market's JSON object so full() works later.
+    GammaProjection(std::initializer_list<std::string_view> keys, bool keepRaw = true);
+
+    // What the matcher and the universe indexes read: identity, tokens, outcomes and top-of-book
+    static const GammaProjection& matching();
+    // Every field from_json knows
+    static const GammaProjection& all();
+
+    bool keepsRaw() const { return keepRaw; }
+    size_t size() const { return wanted.size(); }
+
+private:
+    friend class GammaMarketDecoder;
+
+    std::vector<std::pair<std::string_view, size_t>> wanted;   // JSON key, row in the field table
+    bool keepRaw;
+};
+
+// One entry of a market's outcomes, outcomePrices and clobTokenIds arrays, read together
+struct GammaOutcome {
+    std::string name;
+    double price = 0.0;
+    std::string tokenId;    // Empty if the market lists no CLOB tokens
+};
+
+// Why a market's outcomes could not be used; outcomes is empty unless this is None
+enum class OutcomeError : uint8_t {
+    None = 0,
+    Missing,        // outcomes or outcomePrices not sent (or not projected)
+    Malformed,      // Not a JSON array of strings, or a price that is not a number
+    Mismatched,     // Names, prices and token ids do not line up one to one
+    TooMany         // More outcomes than the consumer holds (set by MarketRecord)
+};
+
+const char* outcomeErrorName(OutcomeError error);
+
+// A market decoded to a projection, with its JSON kept for a full decode on demand
+struct DecodedGammaMarket {
+    common::GammaMarket market;     // Projected fields only; the rest stay nullopt
+    // The JSON-encoded outcome arrays, decoded once here so nothing downstream parses them again
+    std::vector<GammaOutcome> outcomes;
+    OutcomeError outcomeError = OutcomeError::Missing;
+    std::string raw;                // The market's JSON object (empty unless the projection keeps it)
+
+    // Every field, decoded from raw with the regular from_json; the projected market if that is not possible
+    common::GammaMarket full() const;
+};
+
+// Decodes Gamma /markets responses without building a json DOM.
+//
+// The scanner walks each market object once. Keys outside the projection are
+// matched against the few projected keys and their values are jumped over
+// (strings, numbers and nested objects alike) without being copied or
+// converted, so a 75-field market costs about as much as the handful of
+// fields the caller asked for. Projected values are decoded in place: strings
+// are unescaped only when they contain escapes, numbers go through
+// from_chars. A number sent as a string (or the other way round) is converted
+// rather than failing the page. Structural errors return nullopt. When the
+// projection includes outcomes and outcomePrices, the arrays encoded inside
+// those strings (and clobTokenIds) are decoded into DecodedGammaMarket::outcomes
+// on the same pass; a bad array marks that one market, not the page.
+class GammaMarketDecoder {
+public:
+    // The markets of a /markets page (a JSON array of objects), or nullopt if the body is not one
+    static std::optional<std::vector<DecodedGammaMarket>> decodePage(std::string_view body,
+                                                                     const GammaProjection& projection);
+
+    // Outcomes of a market whose outcome fields came from elsewhere (e.g. from_json)
+    static OutcomeError decodeOutcomes(const common::GammaMarket& market, std::vector<GammaOutcome>& outcomes);
+
+    // The two-pass path (json DOM, then from_json per market), kept as the benchmark baseline
+    static std::optional<std::vector<common::GammaMarket>> decodePageDom(const std::string& body);
+};
+
+} // namespace api
+} // namespace polymarket_bot
@@ -0,0 +1,159 @@
+#include "http_response_cache.h"
+#include <algorithm>
+#include <iostream>
+
+namespace polymarket_bot {
+namespace api {
+
+HttpResponseCache& HttpResponseCache::getInstance() {
+    static HttpResponseCache instance;
+    return instance;
+}
+
+void HttpResponseCache::addValidators(HttpRequest& request) const {
+    if (request.method != "GET") {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(request.url);
+    if (it == entries.end()) {
+        return;
+    }
+    const Entry& entry = *it->second.entry;
+    if (!entry.etag.empty()) {
+        request.headers.push_back("If-None-Match: " + entry.etag);
+    }
+    if (!entry.lastModified.empty()) {
+        request.headers.push_back("If-Modified-Since: " + entry.lastModified);
+    }
+}
+
+bool HttpResponseCache::holds(const std::string& url) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.count(url) > 0;
+}
+
+namespace {
+
+bool isValidator(const std::string& header) {
+    return header.rfind("If-None-Match:", 0) == 0 || header.rfind("If-Modified-Since:", 0) == 0;
+}
+
+} // namespace
+
+bool HttpResponseCache::hasValidators(const HttpRequest& request) {
+    return std::any_of(request.headers.begin(), request.headers.end(), isValidator);
+}
+
+bool HttpResponseCache::stripValidators(HttpRequest& request) {
+    auto removed = std::remove_if(request.headers.begin(), request.headers.end(), isValidator);
+    bool stripped = removed != request.headers.end();
+    request.headers.erase(removed, request.headers.end());
+    return stripped;
+}
+
+std::shared_ptr<HttpResponseCache::Entry> HttpResponseCache::update(const std::string& url, const HttpResponse& response,
+                                                                    bool& notModified) {
+    std::lock_guard<std::mutex> lock(mutex);
+    notModified = false;
+
+    if (!response.ok()) {
+        return nullptr;
+    }
+
+    if (response.statusCode == 304) {
+        auto it = entries.find(url);
+        if (it == entries.end()) {
+            stats.orphaned++;
+            std::cerr << "[HttpResponseCache] 304 for " << url << " but its entry was evicted" << std::endl;
+            return nullptr;
+        }
+        notModified = true;
+        stats.hits++;
+        it->second.lastUsed = std::chrono::steady_clock::now();
+        return it->second.entry;
+    }
+
+    if (response.statusCode != 200) {
+        return nullptr;
+    }
+
+    auto etag = response.headers.find("etag");
+    auto lastModified = response.headers.find("last-modified");
+    if (etag == response.headers.end() && lastModified == response.headers.end()) {
+        stats.uncacheable++;
+        entries.erase(url);
+        return nullptr;
+    }
+
+    stats.misses++;
+    auto entry = std::make_shared<Entry>();
+    entry->etag = etag != response.headers.end() ? etag->second : "";
+    entry->lastModified = lastModified != response.headers.end() ? lastModified->second : "";
+    entry->body = response.body;
+    entries[url] = Slot{entry, std::chrono::steady_clock::now()};
+    evictIfFull();
+    return entry;
+}
+
+void HttpResponseCache::storeParsed(const std::string& url, const std::shared_ptr<Entry>& entry,
+                                    std::shared_ptr<const void> parsed, std::type_index type) {
+    // Publish a new entry rather than mutating one another thread may be reading.
+    // Only the immutable entry is copied here; its lastUsed stays in the slot, under the lock
+    auto updated = std::make_shared<Entry>(*entry);
+    updated->parsed = std::move(parsed);
+    updated->parsedType = type;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(url);
+    if (it != entries.end() && it->second.entry == entry) {
+        it->second.entry = std::move(updated);
+    }
+}
+
+std::string HttpResponseCache::resolveBody(const std::string& url, const HttpResponse& response) {
+    bool notModified = false;
+    std::shared_ptr<Entry> entry = update(url, response, notModified);
+    if (notModified && entry) {
+        return entry->body;
+    }
+    return response.body;
+}
+
+std::optional<std::string> HttpResponseCache::notModifiedBody(const std::string& url, const HttpResponse& response) {
+    bool notModified = false;
+    std::shared_ptr<Entry> entry = update(url, response, notModified);
+    if (notModified && entry) {
+        return entry->body;
+    }
+    return std::nullopt;
+}
+
+void HttpResponseCache::evictIfFull() {
+    if (entries.size() <= maxEntries) {
+        return;
+    }
+    auto oldest = entries.begin();
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        if (it->second.lastUsed < oldest->second.lastUsed) {
+            oldest = it;
+        }
+    }
+    entries.erase(oldest);
+}
+
+HttpResponseCache::Stats HttpResponseCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats copy = stats;
+    copy.entries = entries.size();
+    return copy;
+}
+
+void HttpResponseCache::logStats() const {
+    Stats current = getStats();
+    std::cout << "[HttpResponseCache] " << current.hits << " hits (304), " << current.misses << " misses, "
+              << current.uncacheable << " uncacheable, " << current.orphaned << " orphaned 304s, " << current.entries << " entries" << std::endl;
+}
+
+} // namespace api
+} // namespace polymarket_bot
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "http_transport.h"
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+
+namespace polymarket_bot {
+namespace api {
+
+// Conditional-request cache keyed by URL.
+//
+// addValidators() attaches If-None-Match / If-Modified-Since from the last
+// 200 response for the URL. resolve() then turns the reply into a parsed
+// object: a 200 is parsed and stored together with its validators, while a
+// 304 hands back the object parsed last time without running the parser.
+// A 304 is only usable while the entry its validators came from is still
+// here; AsyncHttpEngine re-sends a request once without validators when the
+// entry was evicted in the meantime (see holds(), hasValidators() and stripValidators()).
+// Works with both HttpTransport::perform and AsyncHttpEngine futures.
+// Safe to share between threads.
+class HttpResponseCache {
+public:
+    static HttpResponseCache& getInstance();
+
+    void addValidators(HttpRequest& request) const;
+
+    // Whether a 304 for `url` can still be answered from the cache
+    bool holds(const std::string& url) const;
+
+    // Whether `request` carries If-None-Match or If-Modified-Since
+    static bool hasValidators(const HttpRequest& request);
+    // Removes If-None-Match / If-Modified-Since from `request`; returns false if it carried neither
+    static bool stripValidators(HttpRequest& request);
+
+    // Parsed result for `response`, or nullptr if the request failed or had no usable body
+    template <typename T>
+    std::shared_ptr<const T> resolve(const std::string& url, const HttpResponse& response,
+                                     const std::function<T(const std::string&)>& parse);
+
+    // Body of `response`, or the cached body when the server answered 304 (empty if the entry is gone)
+    std::string resolveBody(const std::string& url, const HttpResponse& response);
+
+    // Records a 200's validators and body like resolveBody(), but hands back only the body of a usable 304,
+    // so a caller that moves its parse result out can parse a 200 straight from the response
+    std::optional<std::string> notModifiedBody(const std::string& url, const HttpResponse& response);
+
+    struct Stats {
+        size_t hits = 0;       // 304 Not Modified, previous result reused
+        size_t misses = 0;     // Full 200 body received
+        size_t uncacheable = 0; // 200 without ETag or Last-Modified
+        size_t orphaned = 0;   // 304 after the entry was evicted, nothing to reuse
+        size_t entries = 0;
+    };
+    Stats getStats() const;
+    void logStats() const;
+
+private:
+    HttpResponseCache() = default;
+
+    HttpResponseCache(const HttpResponseCache&) = delete;
+    HttpResponseCache& operator=(const HttpResponseCache&) = delete;
+
+    // Never changed once published in `entries`, so threads holding one read it without the lock
+    struct Entry {
+        std::string etag;
+        std::string lastModified;
+        std::string body;
+        std::shared_ptr<const void> parsed;
+        std::type_index parsedType = typeid(void);
+    };
+
+    // The mutable part lives next to the entry, guarded by `mutex`
+    struct Slot {
+        std::shared_ptr<Entry> entry;
+        std::chrono::steady_clock::time_point lastUsed;
+    };
+
+    // Returns the cached entry for a 304, stores validators and body for a 200 (nullptr otherwise)
+    std::shared_ptr<Entry> update(const std::string& url, const HttpResponse& response, bool& notModified);
+    void storeParsed(const std::string& url, const std::shared_ptr<Entry>& entry,
+                     std::shared_ptr<const void> parsed, std::type_index type);
+    void evictIfFull();
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, Slot> entries;
+    size_t maxEntries = 4096;
+    Stats stats;
+};
+
+template <typename T>
+std::shared_ptr<const T> HttpResponseCache::resolve(const std::string& url, const HttpResponse& response,
+                                                    const std::function<T(const std::string&)>& parse) {
+    bool notModified = false;
+    std::shared_ptr<Entry> entry = update(url, response, notModified);
+
+    if (notModified && entry) {
+        // A published entry's body and parsed result never change, so reading them without the lock is safe
+        if (entry->parsed && entry->parsedType == std::type_index(typeid(T))) {
+            return std::static_pointer_cast<const T>(entry->parsed);
+        }
+        // Cached as another type (or body only): parse the stored body once and keep the result
+        auto parsed = std::make_shared<const T>(parse(entry->body));
+        storeParsed(url, entry, parsed, typeid(T));
+        return parsed;
+    }
+
+    if (!response.ok() || response.statusCode != 200) {
+        return nullptr;
+    }
+
+    auto parsed = std::make_shared<const T>(parse(response.body));
+    if (entry) {
+        storeParsed(url, entry, parsed, typeid(T));
+    }
+    return parsed;
+}
+
+} // namespace api
+} // namespace polymarket_bot
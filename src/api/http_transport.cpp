@@ -0,0 +1,320 @@
+#include "http_transport.h"
+#include "rate_limiter.h"
+#include "transport_backend.h"
+#include <algorithm>
+#include <cctype>
+#include <iomanip>
+#include <iostream>
+
+namespace polymarket_bot {
+namespace api {
+
+HttpTransport& HttpTransport::getInstance() {
+    static HttpTransport instance;
+    return instance;
+}
+
+HttpTransport::HttpTransport()
+    : share(nullptr), installedDeadline(Deadline::Clock::time_point::max().time_since_epoch().count()),
+      connectTimeoutMs(5000), requestTimeoutMs(30000), cancelledByDeadline(0), maxIdleHandlesPerHost(8) {
+    curl_global_init(CURL_GLOBAL_ALL);
+
+    share = curl_share_init();
+    if (share) {
+        curl_share_setopt(share, CURLSHOPT_LOCKFUNC, &HttpTransport::lockShare);
+        curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, &HttpTransport::unlockShare);
+        curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    }
+}
+
+HttpTransport::~HttpTransport() {
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        for (auto& entry : idleHandles) {
+            for (CURL* handle : entry.second) {
+                curl_easy_cleanup(handle);
+            }
+        }
+        idleHandles.clear();
+    }
+    if (share) {
+        curl_share_cleanup(share);
+    }
+    curl_global_cleanup();
+}
+
+void HttpTransport::lockShare(CURL* handle, curl_lock_data data, curl_lock_access access, void* userp) {
+    (void)handle;
+    (void)access;
+    static_cast<HttpTransport*>(userp)->shareLocks[data].lock();
+}
+
+void HttpTransport::unlockShare(CURL* handle, curl_lock_data data, void* userp) {
+    (void)handle;
+    static_cast<HttpTransport*>(userp)->shareLocks[data].unlock();
+}
+
+size_t HttpTransport::writeCallback(void* contents, size_t size, size_t nmemb, void* userp) {
+    static_cast<std::string*>(userp)->append(static_cast<char*>(contents), size * nmemb);
+    return size * nmemb;
+}
+
+size_t HttpTransport::headerCallback(char* buffer, size_t size, size_t nitems, void* userp) {
+    auto* headers = static_cast<std::map<std::string, std::string>*>(userp);
+    std::string line(buffer, size * nitems);
+
+    // A new status line means a new response (redirect or 100-continue)
+    if (line.rfind("HTTP/", 0) == 0) {
+        headers->clear();
+        return size * nitems;
+    }
+
+    size_t colon = line.find(':');
+    if (colon != std::string::npos) {
+        std::string name = line.substr(0, colon);
+        std::transform(name.begin(), name.end(), name.begin(),
+                       [](unsigned char c) { return std::tolower(c); });
+        size_t start = line.find_first_not_of(" \t", colon + 1);
+        size_t end = line.find_last_not_of(" \t\r\n");
+        (*headers)[name] = (start == std::string::npos || end < start) ? "" : line.substr(start, end - start + 1);
+    }
+    return size * nitems;
+}
+
+std::string HttpTransport::hostKey(const std::string& url) {
+    size_t schemeEnd = url.find("://");
+    size_t hostStart = (schemeEnd == std::string::npos) ? 0 : schemeEnd + 3;
+    size_t hostEnd = url.find_first_of("/?#", hostStart);
+    return url.substr(0, hostEnd);
+}
+
+void HttpTransport::applyDefaults(CURL* handle) {
+    curl_easy_setopt(handle, CURLOPT_SHARE, share);
+    curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(handle, CURLOPT_USERAGENT, "polymarket-bot/1.0");
+    // Empty string = offer every encoding this libcurl build can decode
+    curl_easy_setopt(handle, CURLOPT_ACCEPT_ENCODING, "");
+}
+
+std::string HttpTransport::endpointKey(const std::string& url) {
+    return url.substr(0, url.find_first_of("?#"));
+}
+
+void HttpTransport::recordTransfer(const std::string& url, const HttpResponse& response) {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    auto& stats = endpointStats[endpointKey(url)];
+    stats.wireBytes += response.wireBytes;
+    stats.decodedBytes += response.body.size();
+    // Ring buffer: once full, the oldest sample is overwritten
+    if (stats.recentMs.size() < maxLatencySamples) {
+        stats.recentMs.push_back(response.totalMs);
+    } else {
+        stats.recentMs[stats.requests % maxLatencySamples] = response.totalMs;
+    }
+    stats.requests++;
+}
+
+double HttpTransport::EndpointStats::latencyPercentile(double fraction) const {
+    if (recentMs.empty()) {
+        return 0.0;
+    }
+    std::vector<double> sorted = recentMs;
+    size_t index = std::min(sorted.size() - 1, static_cast<size_t>(fraction * static_cast<double>(sorted.size())));
+    std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(index), sorted.end());
+    return sorted[index];
+}
+
+std::map<std::string, HttpTransport::EndpointStats> HttpTransport::getEndpointStats() const {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return endpointStats;
+}
+
+void HttpTransport::logEndpointStats() const {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    std::cout << "[HttpTransport] Transfer statistics (wire / decoded bytes, latency):" << std::endl;
+    for (const auto& entry : endpointStats) {
+        const auto& stats = entry.second;
+        double ratio = stats.decodedBytes ? 100.0 * stats.wireBytes / stats.decodedBytes : 100.0;
+        std::cout << "[HttpTransport]   " << entry.first << ": " << stats.requests << " requests, "
+                  << stats.wireBytes << " / " << stats.decodedBytes << " bytes ("
+                  << std::fixed << std::setprecision(1) << ratio << "% on wire), p50 "
+                  << stats.latencyPercentile(0.50) << " ms, p99 " << stats.latencyPercentile(0.99) << " ms"
+                  << std::defaultfloat << std::endl;
+    }
+}
+
+CURL* HttpTransport::acquireHandle(const std::string& host) {
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        auto it = idleHandles.find(host);
+        if (it != idleHandles.end() && !it->second.empty()) {
+            CURL* handle = it->second.back();
+            it->second.pop_back();
+            return handle;
+        }
+    }
+    return curl_easy_init();
+}
+
+void HttpTransport::releaseHandle(const std::string& host, CURL* handle) {
+    // Reset options but keep the live connection and caches attached to the handle
+    curl_easy_reset(handle);
+
+    std::lock_guard<std::mutex> lock(poolMutex);
+    auto& pool = idleHandles[host];
+    if (pool.size() < maxIdleHandlesPerHost) {
+        pool.push_back(handle);
+        return;
+    }
+    curl_easy_cleanup(handle);
+}
+
+struct curl_slist* HttpTransport::prepareHandle(CURL* curl, const HttpRequest& request, const Deadline& deadline,
+                                                HttpResponse& response) {
+    applyDefaults(curl);
+
+    // Without a timeout a hung server holds the transfer forever
+    long timeoutMs = requestTimeoutMs.load();
+    if (deadline.isSet()) {
+        long remaining = static_cast<long>(std::max<long long>(1, deadline.remaining().count()));
+        timeoutMs = timeoutMs > 0 ? std::min(timeoutMs, remaining) : remaining;
+    }
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, connectTimeoutMs.load());
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, timeoutMs);
+
+    struct curl_slist* headers = nullptr;
+    for (const auto& header : request.headers) {
+        headers = curl_slist_append(headers, header.c_str());
+    }
+
+    curl_easy_setopt(curl, CURLOPT_URL, request.url.c_str());
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, &HttpTransport::writeCallback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response.body);
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, &HttpTransport::headerCallback);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &response.headers);
+
+    if (request.method == "HEAD") {
+        // CURLOPT_CUSTOMREQUEST alone would leave curl waiting for a body that never comes
+        curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+    } else if (request.method != "GET" && request.method != "POST") {
+        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, request.method.c_str());
+    }
+    if (!request.body.empty()) {
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(request.body.size()));
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.body.c_str());
+    } else if (request.method == "POST") {
+        curl_easy_setopt(curl, CURLOPT_POST, 1L);
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, 0L);
+    }
+
+    return headers;
+}
+
+void HttpTransport::finishResponse(CURL* curl, CURLcode code, HttpResponse& response) {
+    response.curlCode = code;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response.statusCode);
+    curl_off_t downloaded = 0;
+    if (curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &downloaded) == CURLE_OK) {
+        response.wireBytes = static_cast<size_t>(downloaded);
+    }
+    curl_off_t totalUs = 0;
+    if (curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME_T, &totalUs) == CURLE_OK) {
+        response.totalMs = static_cast<double>(totalUs) / 1000.0;
+    }
+    if (code != CURLE_OK) {
+        response.error = curl_easy_strerror(code);
+    }
+}
+
+void HttpTransport::setDeadline(const Deadline& deadline) {
+    installedDeadline = deadline.time().time_since_epoch().count();
+}
+
+Deadline HttpTransport::getDeadline() const {
+    return Deadline(Deadline::Clock::time_point(Deadline::Clock::duration(installedDeadline.load())));
+}
+
+Deadline HttpTransport::effectiveDeadline(const HttpRequest& request) const {
+    return request.deadline.earliest(getDeadline());
+}
+
+void HttpTransport::setTimeouts(long connectMs, long requestMs) {
+    connectTimeoutMs = connectMs;
+    requestTimeoutMs = requestMs;
+}
+
+void HttpTransport::failDeadline(HttpResponse& response, const std::string& url) {
+    response.curlCode = CURLE_OPERATION_TIMEDOUT;
+    response.error = "Deadline exceeded for " + endpointKey(url);
+    cancelledByDeadline++;
+}
+
+void HttpTransport::setBackend(std::shared_ptr<TransportBackend> newBackend) {
+    std::lock_guard<std::mutex> lock(backendMutex);
+    backend = std::move(newBackend);
+}
+
+std::shared_ptr<TransportBackend> HttpTransport::getBackend() const {
+    std::lock_guard<std::mutex> lock(backendMutex);
+    return backend;
+}
+
+HttpResponse HttpTransport::perform(const HttpRequest& request) {
+    if (auto installed = getBackend()) {
+        return installed->perform(request);
+    }
+    return performLive(request);
+}
+
+HttpResponse HttpTransport::performLive(const HttpRequest& request) {
+    HttpResponse response;
+    std::string host = hostKey(request.url);
+    Deadline deadline = effectiveDeadline(request);
+    if (deadline.expired()) {
+        failDeadline(response, request.url);
+        return response;
+    }
+
+    std::shared_ptr<RateLimiter> limiter = RateLimiterRegistry::getInstance().find(request.url);
+    bool quotaExhausted = false;
+    if (limiter && !limiter->acquire(deadline.time(), quotaExhausted)) {
+        if (!quotaExhausted) {
+            // The next token would only come after the deadline
+            failDeadline(response, request.url);
+            return response;
+        }
+        response.curlCode = CURLE_OK;
+        response.statusCode = 429;
+        response.error = "Request quota exhausted for " + host;
+        return response;
+    }
+
+    CURL* curl = acquireHandle(host);
+    if (!curl) {
+        response.curlCode = CURLE_FAILED_INIT;
+        response.error = "Failed to initialize CURL";
+        return response;
+    }
+
+    struct curl_slist* headers = prepareHandle(curl, request, deadline, response);
+    finishResponse(curl, curl_easy_perform(curl), response);
+    if (response.timedOut() && deadline.expired()) {
+        failDeadline(response, request.url);
+    }
+
+    curl_slist_free_all(headers);
+    releaseHandle(host, curl);
+
+    if (limiter) {
+        limiter->observe(response);
+    }
+    recordTransfer(request.url, response);
+    return response;
+}
+
+} // namespace api
+} // namespace polymarket_bot
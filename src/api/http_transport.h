@@ -0,0 +1,136 @@
+#pragma once
+
+#include "deadline.h"
+#include <curl/curl.h>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace polymarket_bot {
+namespace api {
+
+class TransportBackend;
+
+struct HttpRequest {
+    std::string method = "GET";
+    std::string url;
+    std::vector<std::string> headers;   // "Name: value" lines
+    std::string body;
+    Deadline deadline;                  // Never by default; the transport's installed deadline applies too
+};
+
+struct HttpResponse {
+    CURLcode curlCode = CURLE_OK;
+    long statusCode = 0;
+    std::string body;
+    std::map<std::string, std::string> headers;  // Header names are lower-cased
+    std::string error;                           // Empty when the transfer completed
+    size_t wireBytes = 0;                        // Body bytes received before content decoding
+    double totalMs = 0.0;                        // Request start to last byte
+
+    bool ok() const { return curlCode == CURLE_OK && error.empty(); }
+    bool timedOut() const { return curlCode == CURLE_OPERATION_TIMEDOUT; }
+};
+
+// Shared HTTP transport used by every API client.
+//
+// Easy handles are kept alive in a per-host pool so that consecutive requests
+// to the same host reuse the open TCP/TLS connection. DNS results and TLS
+// sessions are shared between handles through a CURLSH object, so a handle
+// that was never used for a host still skips the lookup and the full
+// handshake. Every handle advertises all content encodings libcurl supports
+// (gzip, deflate, br, zstd); bodies are decoded as they stream into the
+// response buffer. All methods are safe to call from multiple threads.
+class HttpTransport {
+public:
+    static HttpTransport& getInstance();
+
+    // Goes through the installed backend, or straight to the network when none is installed
+    HttpResponse perform(const HttpRequest& request);
+    HttpResponse performLive(const HttpRequest& request);
+
+    // Deadline applied to every request on top of its own (ScanBudget installs one per scan stage)
+    void setDeadline(const Deadline& deadline);
+    Deadline getDeadline() const;
+    // Earliest of the request's own deadline and the installed one
+    Deadline effectiveDeadline(const HttpRequest& request) const;
+    // Requests failed or aborted because their deadline passed
+    size_t deadlineCancellations() const { return cancelledByDeadline.load(); }
+
+    // Per-request connect and total timeouts; a nearer deadline shortens the total timeout
+    void setTimeouts(long connectTimeoutMs, long requestTimeoutMs);
+
+    // Install a record/replay backend for every client (nullptr restores the live path)
+    void setBackend(std::shared_ptr<TransportBackend> backend);
+    std::shared_ptr<TransportBackend> getBackend() const;
+
+    // Host key ("scheme://host[:port]") used for pooling
+    static std::string hostKey(const std::string& url);
+    // Endpoint key ("scheme://host[:port]/path", no query) used for transfer statistics
+    static std::string endpointKey(const std::string& url);
+
+    // Bytes on the wire vs decoded body bytes, and latency percentiles, per endpoint
+    struct EndpointStats {
+        size_t requests = 0;
+        size_t wireBytes = 0;
+        size_t decodedBytes = 0;
+        std::vector<double> recentMs;  // Latency of the last maxLatencySamples transfers
+
+        double latencyPercentile(double fraction) const;
+    };
+    void recordTransfer(const std::string& url, const HttpResponse& response);
+    std::map<std::string, EndpointStats> getEndpointStats() const;
+    void logEndpointStats() const;
+
+private:
+    friend class AsyncHttpEngine;
+
+    HttpTransport();
+    ~HttpTransport();
+
+    HttpTransport(const HttpTransport&) = delete;
+    HttpTransport& operator=(const HttpTransport&) = delete;
+
+    CURL* acquireHandle(const std::string& host);
+    void releaseHandle(const std::string& host, CURL* handle);
+    void applyDefaults(CURL* handle);
+
+    // Configure a handle for a request; the returned header list must outlive the transfer
+    struct curl_slist* prepareHandle(CURL* handle, const HttpRequest& request, const Deadline& deadline,
+                                     HttpResponse& response);
+    static void finishResponse(CURL* handle, CURLcode code, HttpResponse& response);
+    // Marks `response` as cut off by its deadline and counts it
+    void failDeadline(HttpResponse& response, const std::string& url);
+
+    // libcurl callbacks
+    static size_t writeCallback(void* contents, size_t size, size_t nmemb, void* userp);
+    static size_t headerCallback(char* buffer, size_t size, size_t nitems, void* userp);
+    static void lockShare(CURL* handle, curl_lock_data data, curl_lock_access access, void* userp);
+    static void unlockShare(CURL* handle, curl_lock_data data, void* userp);
+
+    CURLSH* share;
+    std::mutex shareLocks[CURL_LOCK_DATA_LAST];
+
+    mutable std::mutex backendMutex;
+    std::shared_ptr<TransportBackend> backend;
+
+    std::atomic<Deadline::Clock::rep> installedDeadline;
+    std::atomic<long> connectTimeoutMs;
+    std::atomic<long> requestTimeoutMs;
+    std::atomic<size_t> cancelledByDeadline;
+
+    mutable std::mutex statsMutex;
+    std::map<std::string, EndpointStats> endpointStats;
+    static constexpr size_t maxLatencySamples = 1024;
+
+    std::mutex poolMutex;
+    std::unordered_map<std::string, std::vector<CURL*>> idleHandles;
+    size_t maxIdleHandlesPerHost;
+};
+
+} // namespace api
+} // namespace polymarket_bot
@@ -1,20 +1,17 @@
 #include "odds_api_client.h"
+#include "async_http_engine.h"
+#include "rate_limiter.h"
+#include "odds_query_builder.h"
+#include "odds_response_parser.h"
+#include "http_response_cache.h"
 #include <iostream> 
-#include <nlohmann/json.hpp>
-#include <thread>
 #include <chrono>
-#include <curl/curl.h>
-#include <sstream>
-#include <iomanip>
-
-using json = nlohmann::json;
 
 namespace polymarket_bot {
 namespace api {
 
 OddsApiClient::OddsApiClient() 
-    : rateLimit(10), rateLimitRemaining(10), rateLimitResetTime(10),
-      configManager(polymarket_bot::config::ConfigManager::getInstance()) {
+    : configManager(polymarket_bot::config::ConfigManager::getInstance()) {
 }
 
 OddsApiClient::~OddsApiClient() {
@@ -26,103 +23,180 @@ void OddsApiClient::setConfigManager(polymarket_bot::config::ConfigManager& mana
     (void)manager; // Suppress unused parameter warning
 }
 
-// Callback function for libcurl
-size_t OddsApiClient::WriteCallback(void* contents, size_t size, size_t nmemb, std::string* userp) {
-    userp->append((char*)contents, size * nmemb);
-    return size * nmemb;
+HttpRequest OddsApiClient::buildApiRequest(const std::string& sport, const std::string& apiKey, 
+                                           const std::chrono::system_clock::time_point& from, 
+                                           const std::chrono::system_clock::time_point& to) {
+    HttpRequest request;
+    request.url = OddsQueryBuilder::fromConfig(configManager)
+                      .apiKey(apiKey)
+                      .commenceTimeFrom(from)
+                      .commenceTimeTo(to)
+                      .build(sport);
+    return request;
+}
+
+std::vector<polymarket_bot::common::RawOddsGame> OddsApiClient::parseResponse(const std::string& jsonResponse) {
+    // One pass over the bytes, skipping any bookmaker or market the request did not ask for
+    OddsResponseParser parser(OddsResponseParser::filterFromConfig(configManager));
+    return parser.parse(jsonResponse).value_or(std::vector<polymarket_bot::common::RawOddsGame>{});
+}
+
+std::vector<polymarket_bot::common::RawOddsGame> OddsApiClient::fetchOdds(const std::vector<std::string> &sports)
+{
+    // Requests are paced per sport by the odds host's RateLimiter inside the HTTP engine
+    // we need to make a request for each sport, all of them in flight together
+    return fetchAll(sports, buildOddsRequests(sports));
+}
+
+std::vector<HttpRequest> OddsApiClient::buildOddsRequests(const std::vector<std::string> &sports)
+{
+    // lets load the .env for the odds api key from the config manager
+    auto oddsApiKey = configManager.getOddsApiKey();
+    // get todays date and the next week date - save as commenceTimeFrom and commenceTimeTo, ISO 8601 format
+    // The window is aligned to the hour so the URL, and with it the conditional-request cache key, is stable between scans
+    auto commenceTimeFrom = std::chrono::floor<std::chrono::hours>(std::chrono::system_clock::now()) + std::chrono::hours(1);
+    auto commenceTimeTo = commenceTimeFrom + std::chrono::hours(7 * 24);
+
+    // this should return a vector of RawOddsData
+    // lets make the api request - this is what it looks like: https://api.the-odds-api.com/v4/sports/?apiKey=YOUR_API_KEY
+    std::vector<HttpRequest> requests;
+    requests.reserve(sports.size());
+    for (const auto &sport : sports) {
+        std::cout << "Fetching odds for sport: " << sport << std::endl;
+        requests.push_back(buildApiRequest(sport, oddsApiKey, commenceTimeFrom, commenceTimeTo));
+        HttpResponseCache::getInstance().addValidators(requests.back());
+    }
+    return requests;
 }
 
-std::string OddsApiClient::makeApiRequest(const std::string& sport, const std::string& apiKey, 
-                                         const std::chrono::system_clock::time_point& from, 
-                                         const std::chrono::system_clock::time_point& to) {
-    CURL* curl = curl_easy_init();
-    std::string response;
-    
-    if (curl) {
-        // Convert time points to ISO 8601 strings
-        auto from_time_t = std::chrono::system_clock::to_time_t(from);
-        auto to_time_t = std::chrono::system_clock::to_time_t(to);
-        
-        std::stringstream ss;
-        ss << "https://api.the-odds-api.com/v4/sports/" << sport << "/odds"
-           << "?apiKey=" << apiKey
-           << "&regions=us,uk"
-           << "&commenceTimeFrom=" << std::put_time(std::gmtime(&from_time_t), "%Y-%m-%dT%H:%M:%SZ")
-           << "&commenceTimeTo=" << std::put_time(std::gmtime(&to_time_t), "%Y-%m-%dT%H:%M:%SZ");
-        
-        curl_easy_setopt(curl, CURLOPT_URL, ss.str().c_str());
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-        curl_easy_setopt(curl, CURLOPT_USERAGENT, "polymarket-bot/1.0");
-        
-        CURLcode res = curl_easy_perform(curl);
-        curl_easy_cleanup(curl);
-        
-        if (res != CURLE_OK) {
-            return "";
+std::vector<polymarket_bot::common::RawOddsGame> OddsApiClient::fetchOddsForEvents(
+    const std::map<std::string, std::vector<std::string>> &eventIdsBySport)
+{
+    // No commence window: the ids pick the games, including ones starting within the hour
+    auto oddsApiKey = configManager.getOddsApiKey();
+    std::vector<std::string> sports;
+    std::vector<HttpRequest> requests;
+    for (const auto &entry : eventIdsBySport) {
+        if (entry.second.empty()) {
+            continue;
         }
+        std::cout << "Fetching odds for " << entry.second.size() << " " << entry.first << " games" << std::endl;
+        HttpRequest request;
+        request.url = OddsQueryBuilder::fromConfig(configManager).apiKey(oddsApiKey).eventIds(entry.second).build(entry.first);
+        HttpResponseCache::getInstance().addValidators(request);
+        sports.push_back(entry.first);
+        requests.push_back(std::move(request));
     }
-    
-    return response;
+    return fetchAll(sports, std::move(requests));
 }
 
-std::vector<polymarket_bot::common::RawOddsGame> OddsApiClient::parseResponse(const std::string& jsonResponse) {
-    try {
-        json j = json::parse(jsonResponse);
+std::vector<polymarket_bot::common::RawOddsGame> OddsApiClient::parseSportResponse(const std::string &url,
+                                                                                    const HttpResponse &response,
+                                                                                    SportFetchTiming &timing)
+{
+    auto received = std::chrono::steady_clock::now();
+    std::vector<polymarket_bot::common::RawOddsGame> games;
+    timing.bytes = response.body.size();
+    if (!response.ok()) {
+        timing.error = response.error;
+        return games;
+    }
+    if (auto remaining = response.headers.find("x-requests-remaining"); remaining != response.headers.end()) {
+        timing.requestsRemaining = remaining->second;
+    }
 
-        std::vector<polymarket_bot::common::RawOddsGame> games;
-        for (const auto& game : j) {
-            games.push_back(game.get<polymarket_bot::common::RawOddsGame>());
+    // Only the body is cached: the games are moved out to the caller, so a cached vector would have to be
+    // deep-copied on every reply. A 304 re-runs the single-pass parse on the stored body instead.
+    // Anything else (401, 429, 5xx, a 304 with nothing cached, a body that is not a game array) says nothing
+    // about which games exist, so it must not be reported as an empty listing.
+    std::optional<std::vector<polymarket_bot::common::RawOddsGame>> parsed;
+    if (response.statusCode == 200 || response.statusCode == 304) {
+        auto cached = HttpResponseCache::getInstance().notModifiedBody(url, response);
+        if (response.statusCode == 200 || cached) {
+            parsed = OddsResponseParser(OddsResponseParser::filterFromConfig(configManager))
+                         .parse(cached ? *cached : response.body);
+            if (!parsed) {
+                timing.error = "Unexpected odds response structure - expected array";
+                return games;
+            }
         }
+    }
+    if (!parsed) {
+        timing.error = "HTTP " + std::to_string(response.statusCode);
         return games;
-    } catch (const std::exception& e) {
-        return {};
     }
+    games = std::move(*parsed);
+    timing.notModified = response.statusCode == 304;
+    timing.parseMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - received).count();
+    timing.games = games.size();
+    timing.ok = true;
+    return games;
 }
 
-std::vector<polymarket_bot::common::RawOddsGame> OddsApiClient::fetchOdds(const std::vector<std::string> &sports)
+void OddsApiClient::logTiming(const SportFetchTiming &timing)
 {
-    // lets check if the rate limit is exceeded
-    if (rateLimitRemaining <= 0) {
-        // lets wait for the rate limit to reset
-        std::this_thread::sleep_for(std::chrono::seconds(rateLimitResetTime));
-        // lets reset the rate limit
-        rateLimitRemaining = rateLimit;
+    if (!timing.ok) {
+        std::cerr << "Odds request for " << timing.sport << " failed: " << timing.error << std::endl;
+        return;
     }
-    // lets decrement the rate limit
-    rateLimitRemaining--;
+    std::cout << (timing.notModified ? "Reused cached response for " : "Parsed response for ")
+              << timing.sport << ": " << timing.games << " games ("
+              << timing.fetchMs << " ms fetch, " << timing.parseMs << " ms parse, "
+              << timing.bytes << " bytes)" << std::endl;
+    if (!timing.requestsRemaining.empty()) {
+        std::cout << "Odds API requests remaining: " << timing.requestsRemaining << std::endl;
+    }
+}
 
-    // lets load the .env for the odds api key from the config manager
-    auto oddsApiKey = configManager.getOddsApiKey();
-    // get todays date and the next week date - save as commenceTimeFrom and commenceTimeTo, ISO 8601 format
-    auto commenceTimeFrom = std::chrono::system_clock::now() + std::chrono::hours(1);
-    auto commenceTimeTo = commenceTimeFrom + std::chrono::hours(7 * 24);
+Task<OddsApiClient::SportResult> OddsApiClient::fetchSport(std::string sport, HttpRequest request)
+{
+    SportResult result;
+    result.timing.sport = std::move(sport);
+    std::string url = request.url;
+
+    auto submitted = std::chrono::steady_clock::now();
+    HttpResponse response = co_await AsyncHttpEngine::getInstance().fetch(std::move(request));
+    result.timing.fetchMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - submitted).count();
+    result.games = parseSportResponse(url, response, result.timing);
+    co_return result;
+}
 
-    // this should return a vector of RawOddsData
-    // lets make the api request - this is what it looks like: https://api.the-odds-api.com/v4/sports/?apiKey=YOUR_API_KEY
-    // we need to make a request for each sport
+std::vector<polymarket_bot::common::RawOddsGame> OddsApiClient::fetchAll(const std::vector<std::string> &sports,
+                                                                          std::vector<HttpRequest> requests)
+{
+    // Every sport is in flight at once under the host's rate limiter; each is parsed as soon as its response lands
+    std::vector<Task<SportResult>> tasks;
+    tasks.reserve(requests.size());
+    for (size_t i = 0; i < requests.size(); ++i) {
+        tasks.push_back(fetchSport(sports[i], std::move(requests[i])));
+    }
+    std::vector<SportResult> results = syncWait(whenAll(std::move(tasks)));
 
-    std::vector<polymarket_bot::common::RawOddsGame> odds;
+    size_t totalGames = 0;
+    for (const auto &result : results) {
+        totalGames += result.games.size();
+    }
 
-    // Use the passed sports parameter instead of configManager.getSports()
-    for (const auto &sport : sports) {
-        std::cout << "Fetching odds for sport: " << sport << std::endl;
-        // make the api request
-        auto response = makeApiRequest(sport, oddsApiKey, commenceTimeFrom, commenceTimeTo);
-        // parse the response
-        auto parsedResponse = parseResponse(response);
-        std::cout << "Parsed response: " << parsedResponse.size() << std::endl;
-        // add the parsed response to the odds vector
-        odds.insert(odds.end(), parsedResponse.begin(), parsedResponse.end());
+    // Move every sport's games into one preallocated vector, in sport order
+    std::vector<polymarket_bot::common::RawOddsGame> odds;
+    odds.reserve(totalGames);
+    lastFetchTimings.clear();
+    for (auto &result : results) {
+        logTiming(result.timing);
+        odds.insert(odds.end(), std::make_move_iterator(result.games.begin()), std::make_move_iterator(result.games.end()));
+        lastFetchTimings.push_back(std::move(result.timing));
     }
 
     return odds;
 }
 
 void OddsApiClient::setRateLimit(int requestsPerMinute) {
-    //lets set the rate limit
-    rateLimit = requestsPerMinute;
-    rateLimitRemaining = requestsPerMinute;
+    //lets set the rate limit for the odds api host
+    std::string baseUrl = configManager.getOddsApiBaseUrl();
+    RateLimiterRegistry::getInstance().configure(baseUrl.empty() ? "https://api.the-odds-api.com" : baseUrl,
+                                                 requestsPerMinute);
 }
 
 bool OddsApiClient::isHealthy() const {
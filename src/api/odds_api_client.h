@@ -3,6 +3,9 @@
 #include "../config/config_manager.h"
 #include "../config/config_types.h"
 #include "../common/types.h"
+#include "coro_task.h"
+#include "http_transport.h"
+#include <map>
 #include <string>
 #include <vector>
 #include <chrono>
@@ -10,6 +13,19 @@
 namespace polymarket_bot {
 namespace api {
 
+// Per-sport breakdown of the last fetchOdds() call
+struct SportFetchTiming {
+    std::string sport;
+    long long fetchMs = 0;   // Submit to response, including any rate-limit wait
+    long long parseMs = 0;
+    size_t bytes = 0;
+    size_t games = 0;
+    bool ok = false;
+    bool notModified = false;       // Served from the conditional-request cache (HTTP 304)
+    std::string error;
+    std::string requestsRemaining;  // x-requests-remaining, if the server sent it
+};
+
 class OddsApiClient {
 public:
     OddsApiClient();
@@ -17,8 +33,22 @@ public:
 
     // Main API methods
     std::vector<polymarket_bot::common::RawOddsGame> fetchOdds(const std::vector<std::string> &sports);
+    // Current odds for specific games, one request per sport (used by ScanScheduler)
+    std::vector<polymarket_bot::common::RawOddsGame> fetchOddsForEvents(
+        const std::map<std::string, std::vector<std::string>> &eventIdsBySport);
+
+    const std::vector<SportFetchTiming>& getLastFetchTimings() const { return lastFetchTimings; }
+
+    // The pieces of fetchOdds, for callers that submit the requests and handle each response themselves:
+    // one request per sport (in sport order, with cache validators), and the games of one response
+    std::vector<HttpRequest> buildOddsRequests(const std::vector<std::string> &sports);
+    std::vector<polymarket_bot::common::RawOddsGame> parseSportResponse(const std::string &url,
+                                                                       const HttpResponse &response,
+                                                                       SportFetchTiming &timing);
+    static void logTiming(const SportFetchTiming &timing);
 
     // Configuration methods
+    // Budget for the odds API host, enforced by the shared RateLimiterRegistry
     void setRateLimit(int requestsPerMinute);
     bool isHealthy() const;
     
@@ -26,20 +56,23 @@ public:
     void setConfigManager(polymarket_bot::config::ConfigManager& manager);
 
 private:
-    int rateLimit;
-    int rateLimitRemaining;
-    int rateLimitResetTime;
-
     polymarket_bot::config::ConfigManager& configManager;
-
-    // Callback function for libcurl
-    static size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::string* userp);
+    std::vector<SportFetchTiming> lastFetchTimings;
 
     // Helper methods
-    std::string makeApiRequest(const std::string& sport, const std::string& apiKey, 
-                              const std::chrono::system_clock::time_point& from, 
-                              const std::chrono::system_clock::time_point& to);
+    HttpRequest buildApiRequest(const std::string& sport, const std::string& apiKey, 
+                                const std::chrono::system_clock::time_point& from, 
+                                const std::chrono::system_clock::time_point& to);
     
+    struct SportResult {
+        std::vector<polymarket_bot::common::RawOddsGame> games;
+        SportFetchTiming timing;
+    };
+
+    // Runs fetchSport for every sport concurrently; each parses its response as soon as it lands
+    std::vector<polymarket_bot::common::RawOddsGame> fetchAll(const std::vector<std::string> &sports,
+                                                             std::vector<HttpRequest> requests);
+    Task<SportResult> fetchSport(std::string sport, HttpRequest request);
     std::vector<polymarket_bot::common::RawOddsGame> parseResponse(const std::string& jsonResponse);
 };
 
@@ -0,0 +1,138 @@
+#include "odds_query_builder.h"
+#include "../config/config_manager.h"
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+namespace polymarket_bot {
+namespace api {
+
+OddsQueryBuilder OddsQueryBuilder::fromConfig(const config::ConfigManager& configManager) {
+    const auto& oddsApi = configManager.getConfig().apis.oddsApi;
+
+    std::vector<std::string> books = configManager.getSharpBooks();
+    for (const auto& book : oddsApi.extraBookmakers) {
+        if (std::find(books.begin(), books.end(), book) == books.end()) {
+            books.push_back(book);
+        }
+    }
+
+    OddsQueryBuilder builder;
+    if (!oddsApi.baseUrl.empty()) {
+        builder.baseUrl(oddsApi.baseUrl);
+    }
+    builder.apiKey(oddsApi.apiKey)
+        .regions(oddsApi.regions)
+        .bookmakers(books)
+        .markets(oddsApi.markets)
+        .oddsFormat(oddsApi.oddsFormat)
+        .dateFormat(oddsApi.dateFormat);
+    return builder;
+}
+
+OddsQueryBuilder& OddsQueryBuilder::baseUrl(const std::string& url) {
+    base = url;
+    while (!base.empty() && base.back() == '/') {
+        base.pop_back();
+    }
+    return *this;
+}
+
+OddsQueryBuilder& OddsQueryBuilder::apiKey(const std::string& k) {
+    key = k;
+    return *this;
+}
+
+OddsQueryBuilder& OddsQueryBuilder::regions(const std::vector<std::string>& r) {
+    regionKeys = r;
+    return *this;
+}
+
+OddsQueryBuilder& OddsQueryBuilder::bookmakers(const std::vector<std::string>& b) {
+    bookmakerKeys = b;
+    return *this;
+}
+
+OddsQueryBuilder& OddsQueryBuilder::markets(const std::vector<std::string>& m) {
+    marketKeys = m;
+    return *this;
+}
+
+OddsQueryBuilder& OddsQueryBuilder::oddsFormat(const std::string& format) {
+    odds = format;
+    return *this;
+}
+
+OddsQueryBuilder& OddsQueryBuilder::dateFormat(const std::string& format) {
+    dates = format;
+    return *this;
+}
+
+OddsQueryBuilder& OddsQueryBuilder::commenceTimeFrom(std::chrono::system_clock::time_point tp) {
+    from = tp;
+    return *this;
+}
+
+OddsQueryBuilder& OddsQueryBuilder::commenceTimeTo(std::chrono::system_clock::time_point tp) {
+    to = tp;
+    return *this;
+}
+
+OddsQueryBuilder& OddsQueryBuilder::eventIds(const std::vector<std::string>& ids) {
+    eventIdKeys = ids;
+    return *this;
+}
+
+std::string OddsQueryBuilder::join(const std::vector<std::string>& values) {
+    std::string joined;
+    for (const auto& value : values) {
+        if (!joined.empty()) {
+            joined += ",";
+        }
+        joined += value;
+    }
+    return joined;
+}
+
+std::string OddsQueryBuilder::isoTime(std::chrono::system_clock::time_point tp) {
+    auto time = std::chrono::system_clock::to_time_t(tp);
+    std::stringstream ss;
+    ss << std::put_time(std::gmtime(&time), "%Y-%m-%dT%H:%M:%SZ");
+    return ss.str();
+}
+
+std::string OddsQueryBuilder::build(const std::string& sport) const {
+    std::stringstream ss;
+    ss << base << "/sports/" << sport << "/odds"
+       << "?apiKey=" << key;
+
+    // The API ignores regions when bookmakers are given, so send only one of them
+    if (!bookmakerKeys.empty()) {
+        ss << "&bookmakers=" << join(bookmakerKeys);
+    } else if (!regionKeys.empty()) {
+        ss << "&regions=" << join(regionKeys);
+    }
+    if (!marketKeys.empty()) {
+        ss << "&markets=" << join(marketKeys);
+    }
+    if (!odds.empty()) {
+        ss << "&oddsFormat=" << odds;
+    }
+    if (!dates.empty()) {
+        ss << "&dateFormat=" << dates;
+    }
+    if (from != std::chrono::system_clock::time_point{}) {
+        ss << "&commenceTimeFrom=" << isoTime(from);
+    }
+    if (to != std::chrono::system_clock::time_point{}) {
+        ss << "&commenceTimeTo=" << isoTime(to);
+    }
+    if (!eventIdKeys.empty()) {
+        ss << "&eventIds=" << join(eventIdKeys);
+    }
+    return ss.str();
+}
+
+} // namespace api
+} // namespace polymarket_bot
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace polymarket_bot {
+namespace config {
+class ConfigManager;
+}
+
+namespace api {
+
+// Builds /sports/{sport}/odds URLs for The Odds API.
+//
+// Asking only for the bookmakers and markets the bot prices keeps payloads,
+// parse time and quota cost down: when bookmakers are given the API ignores
+// regions and bills per ten bookmakers instead of per region.
+class OddsQueryBuilder {
+public:
+    OddsQueryBuilder() = default;
+
+    // Bookmakers = sharpBooks + oddsApi.extraBookmakers, plus markets/regions/formats from oddsApi
+    static OddsQueryBuilder fromConfig(const config::ConfigManager& configManager);
+
+    OddsQueryBuilder& baseUrl(const std::string& url);
+    OddsQueryBuilder& apiKey(const std::string& key);
+    OddsQueryBuilder& regions(const std::vector<std::string>& regionKeys);
+    OddsQueryBuilder& bookmakers(const std::vector<std::string>& bookmakerKeys);
+    OddsQueryBuilder& markets(const std::vector<std::string>& marketKeys);
+    OddsQueryBuilder& oddsFormat(const std::string& format);
+    OddsQueryBuilder& dateFormat(const std::string& format);
+    OddsQueryBuilder& commenceTimeFrom(std::chrono::system_clock::time_point from);
+    OddsQueryBuilder& commenceTimeTo(std::chrono::system_clock::time_point to);
+    // Only these games; the quota cost is the same, the payload is not
+    OddsQueryBuilder& eventIds(const std::vector<std::string>& ids);
+
+    std::string build(const std::string& sport) const;
+
+private:
+    static std::string join(const std::vector<std::string>& values);
+    static std::string isoTime(std::chrono::system_clock::time_point tp);
+
+    std::string base = "https://api.the-odds-api.com/v4";
+    std::string key;
+    std::vector<std::string> regionKeys = {"us", "uk"};
+    std::vector<std::string> bookmakerKeys;
+    std::vector<std::string> marketKeys;
+    std::vector<std::string> eventIdKeys;
+    std::string odds;
+    std::string dates;
+    std::chrono::system_clock::time_point from{};
+    std::chrono::system_clock::time_point to{};
+};
+
+} // namespace api
+} // namespace polymarket_bot
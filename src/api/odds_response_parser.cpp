@@ -0,0 +1,380 @@
+#include "odds_response_parser.h"
+#include "../common/string_interner.h"
+#include "../config/config_manager.h"
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace polymarket_bot {
+namespace api {
+
+namespace {
+
+// Fills games from SAX events, tracking where in the document each event lands
+class OddsSaxHandler : public json::json_sax_t {
+public:
+    OddsSaxHandler(const OddsResponseParser::KeyIds& filter, std::vector<common::RawOddsGame>& games)
+        : filter(filter), games(games) {}
+
+    bool null() override {
+        if (misplacedValue()) {
+            return false;
+        }
+        field = Field::None;
+        return true;
+    }
+
+    bool boolean(bool) override {
+        if (misplacedValue()) {
+            return false;
+        }
+        field = Field::None;
+        return true;
+    }
+
+    bool number_integer(number_integer_t value) override { return number(static_cast<double>(value), true); }
+    bool number_unsigned(number_unsigned_t value) override { return number(static_cast<double>(value), true); }
+    bool number_float(number_float_t value, const string_t&) override { return number(value, false); }
+
+    bool string(string_t& value) override {
+        if (misplacedValue()) {
+            return false;
+        }
+        if (skipDepth == 0) {
+            if (std::string* target = stringField()) {
+                *target = std::move(value);
+                if (uint32_t* id = idField()) {
+                    *id = interner.intern(*target);
+                    if (field == Field::Key && scopes.back() == Scope::Bookmaker) {
+                        dropBookmaker = !filter.bookmakers.empty() && filter.bookmakers.count(*id) == 0;
+                    } else if (field == Field::Key && scopes.back() == Scope::Market) {
+                        dropMarket = !filter.markets.empty() && filter.markets.count(*id) == 0;
+                    }
+                }
+            }
+        }
+        field = Field::None;
+        return true;
+    }
+
+    bool binary(binary_t&) override { return true; }
+
+    bool key(string_t& name) override {
+        if (skipDepth > 0) {
+            return true;
+        }
+        field = Field::None;
+        switch (scopes.back()) {
+        case Scope::Game:
+            if (name == "id") field = Field::Id;
+            else if (name == "sport_key") field = Field::SportKey;
+            else if (name == "commence_time") field = Field::CommenceTime;
+            else if (name == "home_team") field = Field::HomeTeam;
+            else if (name == "away_team") field = Field::AwayTeam;
+            else if (name == "bookmakers") field = Field::Children;
+            break;
+        case Scope::Bookmaker:
+            if (name == "key") field = Field::Key;
+            else if (name == "title") field = Field::Title;
+            else if (name == "last_update") field = Field::LastUpdate;
+            else if (name == "markets") field = Field::Children;
+            break;
+        case Scope::Market:
+            if (name == "key") field = Field::Key;
+            else if (name == "outcomes") field = Field::Children;
+            break;
+        case Scope::Outcome:
+            if (name == "name") field = Field::Name;
+            else if (name == "price") field = Field::Price;
+            else if (name == "point") field = Field::Point;
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        if (skipDepth > 0) {
+            ++skipDepth;
+            return true;
+        }
+        if (scopes.empty()) {
+            return false;   // An error object rather than a list of games
+        }
+        switch (scopes.back()) {
+        case Scope::Games:
+            games.emplace_back();
+            scopes.push_back(Scope::Game);
+            break;
+        case Scope::Bookmakers:
+            games.back().bookmakers.emplace_back();
+            dropBookmaker = false;
+            scopes.push_back(Scope::Bookmaker);
+            break;
+        case Scope::Markets:
+            games.back().bookmakers.back().markets.emplace_back();
+            dropMarket = false;
+            scopes.push_back(Scope::Market);
+            break;
+        case Scope::Outcomes:
+            games.back().bookmakers.back().markets.back().outcomes.emplace_back();
+            scopes.push_back(Scope::Outcome);
+            break;
+        default:
+            skipDepth = 1;
+            break;
+        }
+        field = Field::None;
+        return true;
+    }
+
+    bool end_object() override {
+        if (skipDepth > 0) {
+            --skipDepth;
+            return true;
+        }
+        Scope closed = scopes.back();
+        scopes.pop_back();
+        if (closed == Scope::Game) {
+            const auto& game = games.back();
+            if (game.id.empty() || game.home_team.empty() || game.away_team.empty()) {
+                games.pop_back();
+            }
+        } else if (closed == Scope::Bookmaker && dropBookmaker) {
+            games.back().bookmakers.pop_back();
+        } else if (closed == Scope::Market && dropMarket) {
+            games.back().bookmakers.back().markets.pop_back();
+        }
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        if (skipDepth > 0) {
+            ++skipDepth;
+            return true;
+        }
+        if (scopes.empty()) {
+            if (sawRoot) {
+                return false;
+            }
+            sawRoot = true;
+            scopes.push_back(Scope::Games);
+        } else if (field == Field::Children && scopes.back() == Scope::Game) {
+            scopes.push_back(Scope::Bookmakers);
+        } else if (field == Field::Children && scopes.back() == Scope::Bookmaker && !dropBookmaker) {
+            scopes.push_back(Scope::Markets);
+        } else if (field == Field::Children && scopes.back() == Scope::Market && !dropMarket) {
+            scopes.push_back(Scope::Outcomes);
+        } else if (scopes.back() == Scope::Games) {
+            return false;   // A list of lists rather than of games
+        } else {
+            // Unknown arrays, and the markets of a bookmaker already known to be filtered out
+            skipDepth = 1;
+        }
+        field = Field::None;
+        return true;
+    }
+
+    bool end_array() override {
+        if (skipDepth > 0) {
+            --skipDepth;
+            return true;
+        }
+        scopes.pop_back();
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override {
+        return false;
+    }
+
+private:
+    enum class Scope { Games, Game, Bookmakers, Bookmaker, Markets, Market, Outcomes, Outcome };
+    enum class Field {
+        None, Id, SportKey, CommenceTime, HomeTeam, AwayTeam, Key, Title, LastUpdate, Name, Price, Point, Children
+    };
+
+    // A bare value or a list of something other than games, which is not an odds response
+    bool misplacedValue() const {
+        return skipDepth == 0 && (scopes.empty() || scopes.back() == Scope::Games);
+    }
+
+    std::string* stringField() {
+        if (field == Field::None || games.empty()) {
+            return nullptr;
+        }
+        auto& game = games.back();
+        switch (field) {
+        case Field::Id: return &game.id;
+        case Field::SportKey: return &game.sport_key;
+        case Field::CommenceTime: return &game.commence_time;
+        case Field::HomeTeam: return &game.home_team;
+        case Field::AwayTeam: return &game.away_team;
+        case Field::Key:
+            return scopes.back() == Scope::Bookmaker ? &game.bookmakers.back().key
+                                                     : &game.bookmakers.back().markets.back().key;
+        case Field::Title: return &game.bookmakers.back().title;
+        case Field::LastUpdate: return &game.bookmakers.back().last_update;
+        case Field::Name: return &game.bookmakers.back().markets.back().outcomes.back().name;
+        default: return nullptr;
+        }
+    }
+
+    // Keys, sport and team names also get an interned id, so the matcher compares integers
+    uint32_t* idField() {
+        if (field == Field::None || games.empty()) {
+            return nullptr;
+        }
+        auto& game = games.back();
+        switch (field) {
+        case Field::SportKey: return &game.sportKeyId;
+        case Field::HomeTeam: return &game.homeTeamId;
+        case Field::AwayTeam: return &game.awayTeamId;
+        case Field::Key:
+            return scopes.back() == Scope::Bookmaker ? &game.bookmakers.back().keyId
+                                                     : &game.bookmakers.back().markets.back().keyId;
+        case Field::Name: return &game.bookmakers.back().markets.back().outcomes.back().nameId;
+        default: return nullptr;
+        }
+    }
+
+    bool number(double value, bool integral) {
+        if (misplacedValue()) {
+            return false;
+        }
+        if (skipDepth == 0) {
+            if (field == Field::Price || field == Field::Point) {
+                auto& outcome = games.back().bookmakers.back().markets.back().outcomes.back();
+                if (field == Field::Price) {
+                    outcome.price = value;
+                } else {
+                    outcome.point = value;
+                }
+            } else if (integral && (field == Field::CommenceTime || field == Field::LastUpdate)) {
+                if (std::string* target = stringField()) {
+                    *target = OddsResponseParser::isoFromUnix(static_cast<std::time_t>(value));
+                }
+            }
+        }
+        field = Field::None;
+        return true;
+    }
+
+    const OddsResponseParser::KeyIds& filter;
+    std::vector<common::RawOddsGame>& games;
+    common::StringInterner& interner = common::StringInterner::getInstance();
+    std::vector<Scope> scopes;
+    Field field = Field::None;
+    size_t skipDepth = 0;       // Nesting depth inside a value being skipped
+    bool sawRoot = false;
+    bool dropBookmaker = false;
+    bool dropMarket = false;
+};
+
+// dateFormat=unix sends epoch seconds; the rest of the bot works with ISO 8601 strings
+void normalizeTimestamps(json& game) {
+    auto toIso = [](json& value) {
+        if (value.is_number()) {
+            value = OddsResponseParser::isoFromUnix(value.get<std::time_t>());
+        }
+    };
+
+    if (game.contains("commence_time")) {
+        toIso(game["commence_time"]);
+    }
+    if (game.contains("bookmakers")) {
+        for (auto& bookmaker : game["bookmakers"]) {
+            if (bookmaker.contains("last_update")) {
+                toIso(bookmaker["last_update"]);
+            }
+            if (bookmaker.contains("markets")) {
+                for (auto& market : bookmaker["markets"]) {
+                    if (market.contains("last_update")) {
+                        toIso(market["last_update"]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void internKeys(common::RawOddsGame& game) {
+    auto& interner = common::StringInterner::getInstance();
+    game.sportKeyId = interner.intern(game.sport_key);
+    game.homeTeamId = interner.intern(game.home_team);
+    game.awayTeamId = interner.intern(game.away_team);
+    for (auto& bookmaker : game.bookmakers) {
+        bookmaker.keyId = interner.intern(bookmaker.key);
+        for (auto& market : bookmaker.markets) {
+            market.keyId = interner.intern(market.key);
+            for (auto& outcome : market.outcomes) {
+                outcome.nameId = interner.intern(outcome.name);
+            }
+        }
+    }
+}
+
+} // namespace
+
+OddsResponseParser::OddsResponseParser(Filter filter) {
+    auto& interner = common::StringInterner::getInstance();
+    for (const auto& book : filter.bookmakers) {
+        filterIds.bookmakers.insert(interner.intern(book));
+    }
+    for (const auto& market : filter.markets) {
+        filterIds.markets.insert(interner.intern(market));
+    }
+}
+
+OddsResponseParser::Filter OddsResponseParser::filterFromConfig(const config::ConfigManager& configManager) {
+    const auto& oddsApi = configManager.getConfig().apis.oddsApi;
+    Filter result;
+    for (const auto& book : configManager.getSharpBooks()) {
+        result.bookmakers.insert(book);
+    }
+    for (const auto& book : oddsApi.extraBookmakers) {
+        result.bookmakers.insert(book);
+    }
+    for (const auto& market : oddsApi.markets) {
+        result.markets.insert(market);
+    }
+    return result;
+}
+
+std::optional<std::vector<common::RawOddsGame>> OddsResponseParser::parse(std::string_view body) const {
+    std::vector<common::RawOddsGame> games;
+    OddsSaxHandler handler(filterIds, games);
+    if (!json::sax_parse(body.begin(), body.end(), &handler)) {
+        return std::nullopt;
+    }
+    return games;
+}
+
+std::optional<std::vector<common::RawOddsGame>> OddsResponseParser::parseDom(const std::string& body) {
+    try {
+        json j = json::parse(body);
+
+        std::vector<common::RawOddsGame> games;
+        games.reserve(j.size());
+        for (auto& game : j) {
+            normalizeTimestamps(game);
+            games.push_back(game.get<common::RawOddsGame>());
+            internKeys(games.back());
+        }
+        return games;
+    } catch (const std::exception& e) {
+        return std::nullopt;
+    }
+}
+
+std::string OddsResponseParser::isoFromUnix(std::time_t seconds) {
+    std::tm utc{};
+    gmtime_r(&seconds, &utc);
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", &utc);
+    return buffer;
+}
+
+} // namespace api
+} // namespace polymarket_bot
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "../common/types.h"
+#include <cstdint>
+#include <ctime>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace polymarket_bot {
+namespace config {
+class ConfigManager;
+}
+
+namespace api {
+
+// Builds RawOddsGame straight from an Odds API response body.
+//
+// nlohmann's SAX interface walks the bytes once and each string is moved into
+// its field as it is read, instead of first building a json DOM and then
+// copying every node out of it. Bookmakers and markets outside the filter are
+// skipped without being stored, and unix dates (dateFormat=unix) become ISO
+// 8601 strings on the way. Sport, bookmaker and market keys, team and outcome
+// names are interned as they are read (the *Id members of the odds structs).
+// Unknown keys are ignored; a game without an id or either team is dropped on
+// its own rather than failing the whole response.
+class OddsResponseParser {
+public:
+    struct Filter {
+        std::unordered_set<std::string> bookmakers;   // Empty keeps every bookmaker
+        std::unordered_set<std::string> markets;      // Empty keeps every market
+    };
+
+    // The filter as interned ids, checked against each key's id as it is read
+    struct KeyIds {
+        std::unordered_set<uint32_t> bookmakers;
+        std::unordered_set<uint32_t> markets;
+    };
+
+    OddsResponseParser() = default;
+    explicit OddsResponseParser(Filter filter);
+
+    // The bookmakers and markets the odds request asks for (sharp books plus extras; none means all)
+    static Filter filterFromConfig(const config::ConfigManager& configManager);
+
+    // Games in the body, or nullopt if it is not valid JSON or not an array of games
+    std::optional<std::vector<common::RawOddsGame>> parse(std::string_view body) const;
+
+    // The two-pass path (json DOM, then get<RawOddsGame>), kept as the benchmark baseline
+    static std::optional<std::vector<common::RawOddsGame>> parseDom(const std::string& body);
+
+    static std::string isoFromUnix(std::time_t seconds);
+
+private:
+    KeyIds filterIds;
+};
+
+} // namespace api
+} // namespace polymarket_bot
@@ -1,5 +1,7 @@
 #include "polymarket_api_client.h"
-#include <curl/curl.h>
+#include "async_http_engine.h"
+#include "http_transport.h"
+#include "http_response_cache.h"
 #include <nlohmann/json.hpp>
 #include <iostream>
 #include <string>
@@ -11,12 +13,6 @@
 using namespace polymarket_bot::api;
 using namespace polymarket_bot::common;
 
-// Callback function for CURL
-static size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::string* userp) {
-    userp->append((char*)contents, size * nmemb);
-    return size * nmemb;
-}
-
 PolymarketApiClient::PolymarketApiClient(const std::string& baseUrl, 
                                          const std::string& gammaBaseUrl,
                                          const std::string& dataBaseUrl,
@@ -34,96 +30,76 @@ PolymarketApiClient::~PolymarketApiClient() {
 }
 
 std::string PolymarketApiClient::makeAuthenticatedRequest(const std::string& endpoint, const std::string& method, const std::string& body) {
-    CURL* curl = curl_easy_init();
-    std::string response;
+    return syncWait(authenticatedRequest(endpoint, method, body));
+}
 
+Task<std::string> PolymarketApiClient::authenticatedRequest(std::string endpoint, std::string method, std::string body) {
     std::cout << "[PolymarketApiClient] HTTP Request Details:" << std::endl;
     std::cout << "[PolymarketApiClient]   Method: " << method << std::endl;
     std::cout << "[PolymarketApiClient]   Endpoint: " << endpoint << std::endl;
     std::cout << "[PolymarketApiClient]   Base URL: " << baseUrl << std::endl;
 
-    if (curl) {
-        std::string url = baseUrl + endpoint;
-        std::cout << "[PolymarketApiClient]   Full URL: " << url << std::endl;
-        
-        struct curl_slist* headers = NULL;
-        headers = curl_slist_append(headers, "Content-Type: application/json");
-        headers = curl_slist_append(headers, "User-Agent: Mozilla/5.0 (Macintosh; Intel Mac OS X 10_15_7) AppleWebKit/537.36");
-        headers = curl_slist_append(headers, ("X-POLYMARKET-ADDRESS: " + address).c_str());
-        headers = curl_slist_append(headers, ("X-POLYMARKET-SIGNATURE: " + signature).c_str());
-        headers = curl_slist_append(headers, ("X-POLYMARKET-TIMESTAMP: " + timestamp).c_str());
-        headers = curl_slist_append(headers, ("X-POLYMARKET-API-KEY: " + apiKey).c_str());
-        headers = curl_slist_append(headers, ("X-POLYMARKET-PASSPHRASE: " + passphrase).c_str());
-        
-        std::cout << "[PolymarketApiClient] API Credentials Being Used:" << std::endl;
-        std::cout << "[PolymarketApiClient]   Address: " << address << std::endl;
-        std::cout << "[PolymarketApiClient]   API Key: " << apiKey << std::endl;
-        std::cout << "[PolymarketApiClient]   Passphrase: " << passphrase << std::endl;
-        std::cout << "[PolymarketApiClient]   Timestamp: " << timestamp << std::endl;
-        std::cout << "[PolymarketApiClient]   Signature (first 20 chars): " << signature.substr(0, 20) << "..." << std::endl;
-
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, method.c_str());
-        
-        if (!body.empty()) {
-            std::cout << "[PolymarketApiClient]   Body length: " << body.length() << " characters" << std::endl;
-            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
-        }
+    HttpRequest request;
+    request.method = method;
+    request.url = baseUrl + endpoint;
+    request.body = body;
+    std::cout << "[PolymarketApiClient]   Full URL: " << request.url << std::endl;
+
+    request.headers = {
+        "Content-Type: application/json",
+        "User-Agent: Mozilla/5.0 (Macintosh; Intel Mac OS X 10_15_7) AppleWebKit/537.36",
+        "X-POLYMARKET-ADDRESS: " + address,
+        "X-POLYMARKET-SIGNATURE: " + signature,
+        "X-POLYMARKET-TIMESTAMP: " + timestamp,
+        "X-POLYMARKET-API-KEY: " + apiKey,
+        "X-POLYMARKET-PASSPHRASE: " + passphrase
+    };
+
+    std::cout << "[PolymarketApiClient] API Credentials Being Used:" << std::endl;
+    std::cout << "[PolymarketApiClient]   Address: " << address << std::endl;
+    std::cout << "[PolymarketApiClient]   API Key: " << apiKey << std::endl;
+    std::cout << "[PolymarketApiClient]   Passphrase: " << passphrase << std::endl;
+    std::cout << "[PolymarketApiClient]   Timestamp: " << timestamp << std::endl;
+    std::cout << "[PolymarketApiClient]   Signature (first 20 chars): " << signature.substr(0, 20) << "..." << std::endl;
+
+    if (!body.empty()) {
+        std::cout << "[PolymarketApiClient]   Body length: " << body.length() << " characters" << std::endl;
+    }
 
-        std::cout << "[PolymarketApiClient] Executing HTTP request..." << std::endl;
-        CURLcode res = curl_easy_perform(curl);
-        
-        long response_code;
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
-        std::cout << "[PolymarketApiClient] HTTP Response Code: " << response_code << std::endl;
-        
-        if (res != CURLE_OK) {
-            std::cout << "[PolymarketApiClient] CURL ERROR: " << curl_easy_strerror(res) << std::endl;
-        } else {
-            std::cout << "[PolymarketApiClient] HTTP request completed successfully" << std::endl;
-        }
+    std::cout << "[PolymarketApiClient] Executing HTTP request..." << std::endl;
+    // Orders resume ahead of any pricing work queued on the pool
+    HttpResponse response = co_await AsyncHttpEngine::getInstance().fetch(std::move(request), common::TaskPriority::Execution);
+    std::cout << "[PolymarketApiClient] HTTP Response Code: " << response.statusCode << std::endl;
 
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
+    if (!response.ok()) {
+        std::cout << "[PolymarketApiClient] CURL ERROR: " << response.error << std::endl;
+    } else {
+        std::cout << "[PolymarketApiClient] HTTP request completed successfully" << std::endl;
     }
 
-    return response;
+    co_return response.body;
 }
 
 std::string PolymarketApiClient::makeGammaRequest(const std::string& endpoint, const std::string& method, const std::string& body) {
-    CURL* curl = curl_easy_init();
-    std::string response;
-
-    if (curl) {
-        std::string url = gammaBaseUrl + endpoint;
-        
-        struct curl_slist* headers = NULL;
-        headers = curl_slist_append(headers, "Content-Type: application/json");
-
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, method.c_str());
-        
-        if (!body.empty()) {
-            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
-        }
-
-        CURLcode res = curl_easy_perform(curl);
-        if (res != CURLE_OK) {
-            std::cerr << "curl_easy_perform() failed: " << curl_easy_strerror(res) << std::endl;
-        }
+    return syncWait(gammaRequest(endpoint, method, body));
+}
 
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
+Task<std::string> PolymarketApiClient::gammaRequest(std::string endpoint, std::string method, std::string body) {
+    HttpRequest request;
+    request.method = method;
+    request.url = gammaBaseUrl + endpoint;
+    request.body = body;
+    request.headers = {"Content-Type: application/json"};
+    HttpResponseCache::getInstance().addValidators(request);
+    std::string url = request.url;
+
+    HttpResponse response = co_await AsyncHttpEngine::getInstance().fetch(std::move(request));
+    if (!response.ok()) {
+        std::cerr << "Gamma request failed: " << response.error << std::endl;
     }
 
-
-    return response;
+    // Unchanged Gamma resources come back as 304 with an empty body
+    co_return HttpResponseCache::getInstance().resolveBody(url, response);
 }
 
 
@@ -295,38 +271,24 @@ polymarket_bot::common::PolymarketOrderResponse PolymarketApiClient::createOrder
 
 std::string PolymarketApiClient::makeDataRequest(const std::string &endpoint, const std::string &method, const std::string &body)
 {
-    CURL *curl = curl_easy_init();
-    std::string response;
+    return syncWait(dataRequest(endpoint, method, body));
+}
 
-    if (curl)
+Task<std::string> PolymarketApiClient::dataRequest(std::string endpoint, std::string method, std::string body)
+{
+    HttpRequest request;
+    request.method = method;
+    request.url = dataBaseUrl + endpoint;
+    request.body = body;
+    request.headers = {"Content-Type: application/json"};
+
+    HttpResponse response = co_await AsyncHttpEngine::getInstance().fetch(std::move(request));
+    if (!response.ok())
     {
-        std::string url = dataBaseUrl + endpoint;
-
-        struct curl_slist *headers = NULL;
-        headers = curl_slist_append(headers, "Content-Type: application/json");
-
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, method.c_str());
-
-        if (!body.empty())
-        {
-            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
-        }
-
-        CURLcode res = curl_easy_perform(curl);
-        if (res != CURLE_OK)
-        {
-            std::cerr << "curl_easy_perform() failed: " << curl_easy_strerror(res) << std::endl;
-        }
-
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
+        std::cerr << "Data API request failed: " << response.error << std::endl;
     }
 
-    return response;
+    co_return response.body;
 }
 
 double PolymarketApiClient::getBalance(const std::string& user) {
@@ -439,12 +401,9 @@ polymarket_bot::common::PolymarketMarket PolymarketApiClient::getMarketInfo(cons
 }
 
 // Gamma Markets API methods
-polymarket_bot::common::GammaMarketsResponse PolymarketApiClient::getGammaMarkets(int page, int limit) {
-    if(limit > 500) {
-        limit = 500;
-    }
-    // Get yesterday's date in ISO format
-    auto now = std::chrono::system_clock::now();
+std::string PolymarketApiClient::gammaMarketsEndpoint(int offset, int limit, int tagId) {
+    // Get yesterday's date in ISO format; aligned to the hour so paged URLs stay cacheable between scans
+    auto now = std::chrono::floor<std::chrono::hours>(std::chrono::system_clock::now());
     auto yesterday = now - std::chrono::hours(24);
     auto time_t = std::chrono::system_clock::to_time_t(yesterday);
     std::tm* tm = std::gmtime(&time_t);
@@ -452,19 +411,28 @@ polymarket_bot::common::GammaMarketsResponse PolymarketApiClient::getGammaMarket
     char date_str[32];
     std::strftime(date_str, sizeof(date_str), "%Y-%m-%dT%H:%M:%SZ", tm);
     
-    // Get two weeks from now in ISO format
-    auto twoWeeksFromNow = now + std::chrono::hours(24 * 7);
-    auto time_t_future = std::chrono::system_clock::to_time_t(twoWeeksFromNow);
+    // Get one week from now in ISO format
+    auto oneWeekFromNow = now + std::chrono::hours(24 * 7);
+    auto time_t_future = std::chrono::system_clock::to_time_t(oneWeekFromNow);
     std::tm* tm_future = std::gmtime(&time_t_future);
     
     char date_str_future[32];
     std::strftime(date_str_future, sizeof(date_str_future), "%Y-%m-%dT%H:%M:%SZ", tm_future);
 
+    std::string tagFilter = tagId > 0 ? "&tag_id=" + std::to_string(tagId) : "";
+    return "/markets?active=true&closed=false&end_date_min=" + std::string(date_str) + "&start_date_max=" + std::string(date_str_future) + tagFilter + "&offset=" + std::to_string(offset) + "&limit=" + std::to_string(limit);
+}
+
+polymarket_bot::common::GammaMarketsResponse PolymarketApiClient::getGammaMarkets(int page, int limit) {
+    if(limit > 500) {
+        limit = 500;
+    }
+
     //lets paginage with offset
 
     int offset = (page - 1) * limit;
     
-    std::string endpoint = "/markets?active=true&closed=false&end_date_min=" + std::string(date_str) + "&start_date_max=" + std::string(date_str_future) + "&offset=" + std::to_string(offset) + "&limit=" + std::to_string(limit) + "&offset=" + std::to_string(offset);
+    std::string endpoint = gammaMarketsEndpoint(offset, limit);
     std::string response = makeGammaRequest(endpoint);
     
     polymarket_bot::common::GammaMarketsResponse result;
@@ -504,62 +472,45 @@ polymarket_bot::common::GammaMarket PolymarketApiClient::getGammaMarket(const st
 
 // Lambda order execution
 polymarket_bot::common::PolymarketOrderResponse PolymarketApiClient::executeLambdaOrder(const std::string& slug, double price, double size, const std::string& outcome, const std::string& side, const std::string& orderType) {
-    CURL* curl = curl_easy_init();
-    std::string response;
     polymarket_bot::common::PolymarketOrderResponse result;
 
-    if (curl) {
-        std::string url = "https://s7raz3kdkgbqtk5eej6hzsbogq0vjvrh.lambda-url.ca-central-1.on.aws/";
-        
-        // Create request payload
-        nlohmann::json payload;
-        payload["slug"] = slug;
-        payload["price"] = price;
-        payload["size"] = size;
-        payload["outcome"] = outcome;
-        payload["side"] = side;
-        payload["order_type"] = orderType;
-        
-        std::string jsonPayload = payload.dump();
-        
-        struct curl_slist* headers = NULL;
-        headers = curl_slist_append(headers, "Content-Type: application/json");
-        
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, jsonPayload.c_str());
-        
-        CURLcode res = curl_easy_perform(curl);
-        
-        long response_code;
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
-        
-        if (res == CURLE_OK && response_code == 200) {
-            try {
-                nlohmann::json j = nlohmann::json::parse(response);
-                result.success = true;
-                result.orderId = j.value("order_id", "");
-                result.errorMsg = "";
-                if (j.contains("transaction_hash")) {
-                    result.orderHashes.push_back(j["transaction_hash"].get<std::string>());
-                }
-            } catch (const std::exception& e) {
-                result.success = false;
-                result.errorMsg = "Failed to parse lambda response: " + std::string(e.what());
+    // Create request payload
+    nlohmann::json payload;
+    payload["slug"] = slug;
+    payload["price"] = price;
+    payload["size"] = size;
+    payload["outcome"] = outcome;
+    payload["side"] = side;
+    payload["order_type"] = orderType;
+
+    HttpRequest request;
+    request.method = "POST";
+    request.url = "https://s7raz3kdkgbqtk5eej6hzsbogq0vjvrh.lambda-url.ca-central-1.on.aws/";
+    request.body = payload.dump();
+    request.headers = {"Content-Type: application/json"};
+
+    HttpResponse response = HttpTransport::getInstance().perform(request);
+
+    if (response.curlCode == CURLE_FAILED_INIT) {
+        result.success = false;
+        result.errorMsg = "Failed to initialize CURL";
+    } else if (response.ok() && response.statusCode == 200) {
+        try {
+            nlohmann::json j = nlohmann::json::parse(response.body);
+            result.success = true;
+            result.orderId = j.value("order_id", "");
+            result.errorMsg = "";
+            if (j.contains("transaction_hash")) {
+                result.orderHashes.push_back(j["transaction_hash"].get<std::string>());
             }
-        } else {
+        } catch (const std::exception& e) {
             result.success = false;
-            result.errorMsg = "Lambda request failed with code: " + std::to_string(response_code);
+            result.errorMsg = "Failed to parse lambda response: " + std::string(e.what());
         }
-        
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
     } else {
         result.success = false;
-        result.errorMsg = "Failed to initialize CURL";
+        result.errorMsg = "Lambda request failed with code: " + std::to_string(response.statusCode);
     }
-    
+
     return result;
 }
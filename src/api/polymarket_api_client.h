@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../common/types.h"
+#include "coro_task.h"
 #include <string>
 #include <vector>
 
@@ -19,7 +20,7 @@ private:
     std::string passphrase;
     int chainId;
 
-    // Helper methods
+    // Helper methods: blocking wrappers around the request coroutines below
     std::string makeAuthenticatedRequest(const std::string& endpoint, const std::string& method = "GET", const std::string& body = "");
     std::string makeGammaRequest(const std::string& endpoint, const std::string& method = "GET", const std::string& body = "");
     std::string makeDataRequest(const std::string& endpoint, const std::string& method = "GET", const std::string& body = "");
@@ -36,6 +37,11 @@ public:
                        int chainId);
     ~PolymarketApiClient();
 
+    // Request coroutines on the shared AsyncHttpEngine; each yields the response body ("" on failure)
+    Task<std::string> authenticatedRequest(std::string endpoint, std::string method = "GET", std::string body = "");
+    Task<std::string> gammaRequest(std::string endpoint, std::string method = "GET", std::string body = "");
+    Task<std::string> dataRequest(std::string endpoint, std::string method = "GET", std::string body = "");
+
     // Polymarket CLOB API methods
     std::vector<common::PolymarketMarket> getCurrentMarkets();
     common::PolymarketOrderResponse executeOrder(const common::PolymarketOpenOrder& order);
@@ -84,6 +90,10 @@ public:
     // Gamma Markets API methods
     common::GammaMarketsResponse getGammaMarkets(int page = 1, int limit = 20);
     common::GammaMarket getGammaMarket(const std::string& marketId);
+    const std::string& getGammaBaseUrl() const { return gammaBaseUrl; }
+    
+    // Active, closing-soon markets page used by getGammaMarkets and the bulk snapshot; tagId > 0 narrows it to one Gamma tag
+    static std::string gammaMarketsEndpoint(int offset, int limit, int tagId = 0);
     
     // CLOB API methods
     common::ClobMarket getClobMarket(const std::string& conditionId);
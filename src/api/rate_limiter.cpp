@@ -0,0 +1,169 @@
+#include "rate_limiter.h"
+#include "../config/config_manager.h"
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+namespace polymarket_bot {
+namespace api {
+
+RateLimiter::RateLimiter(double requestsPerMinute, double burst, Clock::duration quotaRetry)
+    : ratePerSecond(0.0), capacity(1.0), tokens(0.0), lastRefill(Clock::now()), pausedUntil(Clock::time_point::min()),
+      quotaRetry(quotaRetry), quotaCheckedAt() {
+    setRate(requestsPerMinute, burst);
+    tokens = capacity;
+}
+
+void RateLimiter::setRate(double requestsPerMinute, double burst) {
+    std::lock_guard<std::mutex> lock(mutex);
+    ratePerSecond = std::max(requestsPerMinute, 1.0) / 60.0;
+    // Default burst is a tenth of a minute's budget, so a full minute can never be spent at once
+    capacity = burst > 0.0 ? burst : std::max(1.0, requestsPerMinute / 10.0);
+    tokens = std::min(tokens, capacity);
+}
+
+void RateLimiter::refill(Clock::time_point now) {
+    if (now > lastRefill) {
+        double elapsed = std::chrono::duration<double>(now - lastRefill).count();
+        tokens = std::min(capacity, tokens + elapsed * ratePerSecond);
+        lastRefill = now;
+    }
+}
+
+bool RateLimiter::tryAcquire(Clock::time_point now, Clock::duration& wait) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // The figure can reach 0 from local spending while responses that would refresh it are in flight,
+    // so it only holds until quotaRetry after the last figure; then a probe finds out where things stand
+    bool probe = false;
+    if (stats.quotaRemaining && *stats.quotaRemaining <= 0) {
+        if (now - quotaCheckedAt < quotaRetry) {
+            wait = Clock::duration::max();
+            return false;
+        }
+        probe = true;
+    }
+    if (now < pausedUntil) {
+        wait = pausedUntil - now;
+        stats.delayed++;
+        return false;
+    }
+
+    refill(now);
+    if (tokens >= 1.0) {
+        tokens -= 1.0;
+        stats.granted++;
+        if (probe) {
+            quotaCheckedAt = now;   // One probe per quotaRetry
+        } else if (stats.quotaRemaining) {
+            // Spend the quota locally until the next response reports the real figure
+            (*stats.quotaRemaining)--;
+        }
+        return true;
+    }
+
+    wait = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>((1.0 - tokens) / ratePerSecond));
+    stats.delayed++;
+    return false;
+}
+
+bool RateLimiter::acquire(Clock::time_point deadline, bool& quotaExhausted) {
+    quotaExhausted = false;
+    Clock::duration wait{};
+    Clock::time_point now = Clock::now();
+    while (!tryAcquire(now, wait)) {
+        if (wait == Clock::duration::max()) {
+            quotaExhausted = true;
+            return false;
+        }
+        if (deadline != Clock::time_point::max() && deadline - now < wait) {
+            return false;
+        }
+        std::this_thread::sleep_for(wait);
+        now = Clock::now();
+    }
+    return true;
+}
+
+void RateLimiter::observe(const HttpResponse& response) {
+    observe(response, Clock::now());
+}
+
+void RateLimiter::observe(const HttpResponse& response, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto header = [&response](const char* name) -> std::optional<long> {
+        auto it = response.headers.find(name);
+        if (it == response.headers.end()) {
+            return std::nullopt;
+        }
+        try {
+            return std::stol(it->second);
+        } catch (const std::exception&) {
+            return std::nullopt;
+        }
+    };
+
+    if (auto remaining = header("x-requests-remaining")) {
+        stats.quotaRemaining = remaining;
+        quotaCheckedAt = now;
+    }
+    if (auto used = header("x-requests-used")) {
+        stats.quotaUsed = used;
+    }
+
+    if (response.statusCode == 429) {
+        stats.throttled++;
+        long retryAfter = header("retry-after").value_or(1);
+        pausedUntil = now + std::chrono::seconds(std::max(retryAfter, 1L));
+        tokens = 0.0;
+        std::cerr << "[RateLimiter] HTTP 429, pausing host for " << std::max(retryAfter, 1L) << "s" << std::endl;
+    }
+}
+
+RateLimiter::Stats RateLimiter::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+RateLimiterRegistry& RateLimiterRegistry::getInstance() {
+    static RateLimiterRegistry instance;
+    return instance;
+}
+
+void RateLimiterRegistry::configure(const std::string& baseUrl, double requestsPerMinute, double burst) {
+    std::string host = HttpTransport::hostKey(baseUrl);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = limiters.find(host);
+    if (it != limiters.end()) {
+        it->second->setRate(requestsPerMinute, burst);
+        return;
+    }
+    limiters.emplace(host, std::make_shared<RateLimiter>(requestsPerMinute, burst));
+}
+
+void RateLimiterRegistry::configureFromConfig(const config::ConfigManager& configManager) {
+    const auto& apis = configManager.getConfig().apis;
+    if (!apis.oddsApi.baseUrl.empty()) {
+        configure(apis.oddsApi.baseUrl, apis.oddsApi.rateLimitPerMinute);
+    }
+    if (!apis.polymarket.baseUrl.empty()) {
+        configure(apis.polymarket.baseUrl, apis.polymarket.clobRateLimitPerMinute);
+    }
+    if (!apis.polymarket.gammaBaseUrl.empty()) {
+        configure(apis.polymarket.gammaBaseUrl, apis.polymarket.gammaRateLimitPerMinute);
+    }
+    if (!apis.polymarket.dataBaseUrl.empty()) {
+        configure(apis.polymarket.dataBaseUrl, apis.polymarket.dataRateLimitPerMinute);
+    }
+}
+
+std::shared_ptr<RateLimiter> RateLimiterRegistry::find(const std::string& url) const {
+    std::string host = HttpTransport::hostKey(url);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = limiters.find(host);
+    return it == limiters.end() ? nullptr : it->second;
+}
+
+} // namespace api
+} // namespace polymarket_bot
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "http_transport.h"
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace polymarket_bot {
+namespace config {
+class ConfigManager;
+}
+
+namespace api {
+
+// Thread-safe token bucket for one upstream host.
+//
+// Tokens refill continuously at the configured per-minute rate up to a burst
+// capacity. Responses feed back into the bucket: x-requests-remaining (Odds
+// API) caps further requests to the quota the server says is left, and a 429
+// pauses the bucket for Retry-After seconds. An exhausted quota is not final:
+// once quotaRetry has passed since the last figure, one probe request goes
+// through, and its response either reopens the host (the quota was reset) or
+// closes it for another quotaRetry.
+class RateLimiter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit RateLimiter(double requestsPerMinute, double burst = 0.0,
+                         Clock::duration quotaRetry = std::chrono::minutes(1));
+
+    // Take a token if one is available. Otherwise sets `wait` to the time until the next
+    // token, or Clock::duration::max() when the quota is exhausted and no probe is due yet.
+    bool tryAcquire(Clock::time_point now, Clock::duration& wait);
+
+    // Blocking variant for synchronous callers. Returns false when the quota is exhausted
+    // (quotaExhausted is set) or when the next token would only arrive after `deadline`.
+    bool acquire(Clock::time_point deadline, bool& quotaExhausted);
+
+    // Feed response headers and status back into the bucket
+    void observe(const HttpResponse& response);
+    void observe(const HttpResponse& response, Clock::time_point now);
+
+    void setRate(double requestsPerMinute, double burst = 0.0);
+
+    struct Stats {
+        size_t granted = 0;
+        size_t delayed = 0;                 // tryAcquire calls that had to wait
+        size_t throttled = 0;               // 429 responses seen
+        std::optional<long> quotaRemaining; // From x-requests-remaining
+        std::optional<long> quotaUsed;      // From x-requests-used
+    };
+    Stats getStats() const;
+
+private:
+    void refill(Clock::time_point now);
+
+    mutable std::mutex mutex;
+    double ratePerSecond;
+    double capacity;
+    double tokens;
+    Clock::time_point lastRefill;
+    Clock::time_point pausedUntil;
+    Clock::duration quotaRetry;
+    Clock::time_point quotaCheckedAt;   // Last quota figure from the server, or last probe sent
+    Stats stats;
+};
+
+// Per-host rate limiters shared by HttpTransport and AsyncHttpEngine.
+// Hosts without a configured budget are not limited.
+class RateLimiterRegistry {
+public:
+    static RateLimiterRegistry& getInstance();
+
+    // Create or retune the limiter for the host of `baseUrl`
+    void configure(const std::string& baseUrl, double requestsPerMinute, double burst = 0.0);
+
+    // Budgets for the Odds, CLOB, Gamma and Data hosts from the loaded configuration
+    void configureFromConfig(const config::ConfigManager& configManager);
+
+    // Limiter for the host of `url`, or nullptr if the host is unlimited
+    std::shared_ptr<RateLimiter> find(const std::string& url) const;
+
+private:
+    RateLimiterRegistry() = default;
+
+    RateLimiterRegistry(const RateLimiterRegistry&) = delete;
+    RateLimiterRegistry& operator=(const RateLimiterRegistry&) = delete;
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<RateLimiter>> limiters;
+};
+
+} // namespace api
+} // namespace polymarket_bot
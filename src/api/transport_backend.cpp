@@ -0,0 +1,314 @@
+#include "transport_backend.h"
+#include "async_http_engine.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+
+namespace polymarket_bot {
+namespace api {
+
+namespace {
+
+const char archiveMagic[] = "PMBARCH1";
+
+void writeU32(std::ostream& out, uint32_t value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void writeI64(std::ostream& out, int64_t value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void writeString(std::ostream& out, const std::string& value) {
+    writeU32(out, static_cast<uint32_t>(value.size()));
+    out.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+bool readU32(std::istream& in, uint32_t& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+bool readI64(std::istream& in, int64_t& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+bool readString(std::istream& in, std::string& value) {
+    uint32_t size = 0;
+    if (!readU32(in, size)) {
+        return false;
+    }
+    value.resize(size);
+    return size == 0 || static_cast<bool>(in.read(value.data(), size));
+}
+
+} // namespace
+
+// ---- CurlBackend ----
+
+HttpResponse CurlBackend::perform(const HttpRequest& request) {
+    return HttpTransport::getInstance().performLive(request);
+}
+
+void CurlBackend::performAsync(HttpRequest request, Callback callback) {
+    AsyncHttpEngine::getInstance().submitLive(std::move(request), std::move(callback));
+}
+
+// ---- ExchangeArchive ----
+
+std::string ExchangeArchive::redactUrl(const std::string& url) {
+    std::string redacted = url;
+    size_t pos = redacted.find("apiKey=");
+    while (pos != std::string::npos) {
+        size_t valueStart = pos + 7;
+        size_t valueEnd = redacted.find('&', valueStart);
+        redacted.replace(valueStart, (valueEnd == std::string::npos ? redacted.size() : valueEnd) - valueStart, "REDACTED");
+        pos = redacted.find("apiKey=", valueStart);
+    }
+    return redacted;
+}
+
+std::string ExchangeArchive::key(const std::string& method, const std::string& url, const std::string& body) {
+    return method + " " + redactUrl(url) + "\n" + body;
+}
+
+std::string ExchangeArchive::looseKey(const std::string& method, const std::string& url, const std::string& body) {
+    static const char* windowParams[] = {"commenceTimeFrom=", "commenceTimeTo=", "end_date_min=", "start_date_max="};
+
+    std::string stripped = redactUrl(url);
+    for (const char* param : windowParams) {
+        size_t pos = stripped.find(param);
+        if (pos == std::string::npos) {
+            continue;
+        }
+        size_t valueEnd = stripped.find('&', pos);
+        stripped.erase(pos, (valueEnd == std::string::npos ? stripped.size() : valueEnd + 1) - pos);
+    }
+    return method + " " + stripped + "\n" + body;
+}
+
+bool ExchangeArchive::writeHeader(std::ostream& out) {
+    out.write(archiveMagic, sizeof(archiveMagic) - 1);
+    return static_cast<bool>(out);
+}
+
+void ExchangeArchive::write(std::ostream& out, const RecordedExchange& exchange) {
+    writeString(out, exchange.method);
+    writeString(out, exchange.url);
+    writeString(out, exchange.requestBody);
+    writeI64(out, static_cast<int64_t>(exchange.response.curlCode));
+    writeI64(out, static_cast<int64_t>(exchange.response.statusCode));
+    writeI64(out, static_cast<int64_t>(exchange.latency.count()));
+    writeString(out, exchange.response.error);
+    writeU32(out, static_cast<uint32_t>(exchange.response.headers.size()));
+    for (const auto& header : exchange.response.headers) {
+        writeString(out, header.first);
+        writeString(out, header.second);
+    }
+    writeString(out, exchange.response.body);
+}
+
+bool ExchangeArchive::readAll(const std::string& path, std::vector<RecordedExchange>& exchanges) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "[ExchangeArchive] Cannot open archive: " << path << std::endl;
+        return false;
+    }
+
+    std::string magic(sizeof(archiveMagic) - 1, '\0');
+    if (!in.read(magic.data(), static_cast<std::streamsize>(magic.size())) || magic != archiveMagic) {
+        std::cerr << "[ExchangeArchive] Not a transport archive: " << path << std::endl;
+        return false;
+    }
+
+    while (in.peek() != std::char_traits<char>::eof()) {
+        RecordedExchange exchange;
+        int64_t curlCode = 0;
+        int64_t statusCode = 0;
+        int64_t latency = 0;
+        uint32_t headerCount = 0;
+        bool ok = readString(in, exchange.method) && readString(in, exchange.url) &&
+                  readString(in, exchange.requestBody) && readI64(in, curlCode) && readI64(in, statusCode) &&
+                  readI64(in, latency) && readString(in, exchange.response.error) && readU32(in, headerCount);
+        for (uint32_t i = 0; ok && i < headerCount; ++i) {
+            std::string name;
+            std::string value;
+            ok = readString(in, name) && readString(in, value);
+            exchange.response.headers[name] = value;
+        }
+        ok = ok && readString(in, exchange.response.body);
+        if (!ok) {
+            // A session cut short mid-write leaves a truncated tail; keep everything before it
+            std::cerr << "[ExchangeArchive] Truncated record in " << path << ", ignoring the rest" << std::endl;
+            break;
+        }
+        exchange.response.curlCode = static_cast<CURLcode>(curlCode);
+        exchange.response.statusCode = static_cast<long>(statusCode);
+        exchange.response.wireBytes = exchange.response.body.size();
+        exchange.latency = std::chrono::microseconds(latency);
+        exchanges.push_back(std::move(exchange));
+    }
+    return true;
+}
+
+// ---- RecordingBackend ----
+
+RecordingBackend::RecordingBackend(std::shared_ptr<TransportBackend> inner, const std::string& archivePath)
+    : inner(std::move(inner)), out(archivePath, std::ios::binary | std::ios::trunc), count(0) {
+    if (!out || !ExchangeArchive::writeHeader(out)) {
+        std::cerr << "[RecordingBackend] Cannot write archive: " << archivePath << std::endl;
+        out.close();
+    }
+}
+
+size_t RecordingBackend::recorded() const {
+    std::lock_guard<std::mutex> lock(fileMutex);
+    return count;
+}
+
+void RecordingBackend::record(const HttpRequest& request, const HttpResponse& response, std::chrono::microseconds latency) {
+    RecordedExchange exchange;
+    exchange.method = request.method;
+    exchange.url = ExchangeArchive::redactUrl(request.url);
+    exchange.requestBody = request.body;
+    exchange.response = response;
+    exchange.latency = latency;
+
+    std::lock_guard<std::mutex> lock(fileMutex);
+    if (!out.is_open()) {
+        return;
+    }
+    ExchangeArchive::write(out, exchange);
+    out.flush();
+    count++;
+}
+
+HttpResponse RecordingBackend::perform(const HttpRequest& request) {
+    auto start = std::chrono::steady_clock::now();
+    HttpResponse response = inner->perform(request);
+    record(request, response,
+           std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start));
+    return response;
+}
+
+void RecordingBackend::performAsync(HttpRequest request, Callback callback) {
+    auto start = std::chrono::steady_clock::now();
+    HttpRequest copy = request;
+    inner->performAsync(std::move(request), [this, copy = std::move(copy), callback = std::move(callback), start](HttpResponse response) {
+        record(copy, response,
+               std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start));
+        if (callback) {
+            callback(std::move(response));
+        }
+    });
+}
+
+// ---- ReplayBackend ----
+
+ReplayBackend::ReplayBackend(const std::string& archivePath, bool realTime)
+    : realTime(realTime), loaded(false), exchangeCount(0), missCount(0), stopping(false) {
+    std::vector<RecordedExchange> all;
+    loaded = ExchangeArchive::readAll(archivePath, all);
+    exchangeCount = all.size();
+    for (auto& exchange : all) {
+        looseExchanges[ExchangeArchive::looseKey(exchange.method, exchange.url, exchange.requestBody)].answers.push_back(exchange);
+        auto& recorded = exchanges[ExchangeArchive::key(exchange.method, exchange.url, exchange.requestBody)];
+        recorded.answers.push_back(std::move(exchange));
+    }
+    std::cout << "[ReplayBackend] Loaded " << exchangeCount << " exchanges (" << exchanges.size()
+              << " distinct requests) from " << archivePath << std::endl;
+
+    timerThread = std::thread(&ReplayBackend::timerLoop, this);
+}
+
+ReplayBackend::~ReplayBackend() {
+    {
+        std::lock_guard<std::mutex> lock(timerMutex);
+        stopping = true;
+    }
+    timerCv.notify_all();
+    if (timerThread.joinable()) {
+        timerThread.join();
+    }
+}
+
+size_t ReplayBackend::misses() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return missCount;
+}
+
+RecordedExchange ReplayBackend::lookup(const HttpRequest& request) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = exchanges.find(ExchangeArchive::key(request.method, request.url, request.body));
+    if (it == exchanges.end()) {
+        it = looseExchanges.find(ExchangeArchive::looseKey(request.method, request.url, request.body));
+        if (it == looseExchanges.end()) {
+            it = exchanges.end();
+        }
+    }
+    if (it == exchanges.end() || it->second.answers.empty()) {
+        missCount++;
+        RecordedExchange miss;
+        miss.response.statusCode = 404;
+        miss.response.error = "No recorded response for " + ExchangeArchive::redactUrl(request.url);
+        return miss;
+    }
+    auto& recorded = it->second;
+    const RecordedExchange& answer = recorded.answers[std::min(recorded.next, recorded.answers.size() - 1)];
+    if (recorded.next < recorded.answers.size()) {
+        recorded.next++;
+    }
+    return answer;
+}
+
+HttpResponse ReplayBackend::perform(const HttpRequest& request) {
+    RecordedExchange answer = lookup(request);
+    if (realTime && answer.latency.count() > 0) {
+        std::this_thread::sleep_for(answer.latency);
+    }
+    return std::move(answer.response);
+}
+
+void ReplayBackend::performAsync(HttpRequest request, Callback callback) {
+    RecordedExchange answer = lookup(request);
+    auto due = std::chrono::steady_clock::now() + (realTime ? answer.latency : std::chrono::microseconds(0));
+    {
+        std::lock_guard<std::mutex> lock(timerMutex);
+        timers.emplace(due, [response = std::move(answer.response), callback = std::move(callback)]() mutable {
+            if (callback) {
+                callback(std::move(response));
+            }
+        });
+    }
+    timerCv.notify_one();
+}
+
+void ReplayBackend::timerLoop() {
+    std::unique_lock<std::mutex> lock(timerMutex);
+    while (true) {
+        if (timers.empty()) {
+            if (stopping) {
+                return;
+            }
+            timerCv.wait(lock);
+            continue;
+        }
+        auto next = timers.begin();
+        // Deliver everything still queued on shutdown so no future is left waiting
+        if (!stopping && next->first > std::chrono::steady_clock::now()) {
+            timerCv.wait_until(lock, next->first);
+            continue;
+        }
+        auto deliver = std::move(next->second);
+        timers.erase(next);
+        lock.unlock();
+        try {
+            deliver();
+        } catch (const std::exception& e) {
+            std::cerr << "[ReplayBackend] Completion callback threw: " << e.what() << std::endl;
+        }
+        lock.lock();
+    }
+}
+
+} // namespace api
+} // namespace polymarket_bot
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "http_transport.h"
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace polymarket_bot {
+namespace api {
+
+// Where HttpTransport::perform and AsyncHttpEngine::submit send requests.
+//
+// No backend installed means the live curl path. Install one with
+// HttpTransport::setBackend() to record a session to an archive or to replay
+// an archive offline; every client goes through the two entry points above,
+// so the whole scan pipeline follows the installed backend.
+class TransportBackend {
+public:
+    using Callback = std::function<void(HttpResponse)>;
+
+    virtual ~TransportBackend() = default;
+
+    virtual HttpResponse perform(const HttpRequest& request) = 0;
+    virtual void performAsync(HttpRequest request, Callback callback) = 0;
+    virtual const char* name() const = 0;
+};
+
+// Live network through the pooled curl transport and the curl_multi engine
+class CurlBackend : public TransportBackend {
+public:
+    HttpResponse perform(const HttpRequest& request) override;
+    void performAsync(HttpRequest request, Callback callback) override;
+    const char* name() const override { return "live"; }
+};
+
+// One request/response pair in a record/replay archive
+struct RecordedExchange {
+    std::string method;
+    std::string url;     // apiKey query values are redacted
+    std::string requestBody;
+    HttpResponse response;
+    std::chrono::microseconds latency{0};
+};
+
+// Compact binary archive: length-prefixed fields, no JSON, appended as exchanges complete
+class ExchangeArchive {
+public:
+    static bool writeHeader(std::ostream& out);
+    static void write(std::ostream& out, const RecordedExchange& exchange);
+    static bool readAll(const std::string& path, std::vector<RecordedExchange>& exchanges);
+
+    // Lookup key shared by recorder and replayer
+    static std::string key(const std::string& method, const std::string& url, const std::string& body);
+    static std::string redactUrl(const std::string& url);
+    // Key without the clock-derived window parameters, so an archive replays on a later day
+    static std::string looseKey(const std::string& method, const std::string& url, const std::string& body);
+};
+
+// Forwards to another backend and appends every exchange to an archive file
+class RecordingBackend : public TransportBackend {
+public:
+    RecordingBackend(std::shared_ptr<TransportBackend> inner, const std::string& archivePath);
+
+    HttpResponse perform(const HttpRequest& request) override;
+    void performAsync(HttpRequest request, Callback callback) override;
+    const char* name() const override { return "record"; }
+
+    bool isOpen() const { return out.is_open(); }
+    size_t recorded() const;
+
+private:
+    void record(const HttpRequest& request, const HttpResponse& response, std::chrono::microseconds latency);
+
+    std::shared_ptr<TransportBackend> inner;
+    mutable std::mutex fileMutex;
+    std::ofstream out;
+    size_t count;
+};
+
+// Serves exchanges from an archive without touching the network.
+//
+// Repeated requests for the same key are answered in recording order (the
+// last answer repeats); requests that differ only in their time-window
+// parameters fall back to the same request recorded at another time.
+// Unknown requests get a 404 with an error. With realTime on, each answer is
+// delayed by its recorded latency; otherwise answers come back at memory
+// speed. Async answers are delivered from a single timer thread.
+class ReplayBackend : public TransportBackend {
+public:
+    ReplayBackend(const std::string& archivePath, bool realTime);
+    ~ReplayBackend() override;
+
+    HttpResponse perform(const HttpRequest& request) override;
+    void performAsync(HttpRequest request, Callback callback) override;
+    const char* name() const override { return "replay"; }
+
+    bool isLoaded() const { return loaded; }
+    size_t size() const { return exchangeCount; }
+    size_t misses() const;
+
+private:
+    struct Recorded {
+        std::vector<RecordedExchange> answers;
+        size_t next = 0;
+    };
+
+    RecordedExchange lookup(const HttpRequest& request);
+    void timerLoop();
+
+    bool realTime;
+    bool loaded;
+    size_t exchangeCount;
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, Recorded> exchanges;
+    std::unordered_map<std::string, Recorded> looseExchanges;
+    size_t missCount;
+
+    // Async delivery queue: due time -> completion
+    std::mutex timerMutex;
+    std::condition_variable timerCv;
+    std::multimap<std::chrono::steady_clock::time_point, std::function<void()>> timers;
+    bool stopping;
+    std::thread timerThread;
+};
+
+} // namespace api
+} // namespace polymarket_bot
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+namespace polymarket_bot {
+namespace common {
+
+// Depth and wait counters of one BoundedQueue
+struct QueueStats {
+    size_t capacity = 0;
+    size_t pushed = 0;
+    size_t maxDepth = 0;
+    double meanDepth = 0.0;     // Depth right after each push
+    double pushWaitMs = 0.0;    // Producers blocked on a full queue (backpressure)
+    double popWaitMs = 0.0;     // Consumers waiting on an empty queue
+};
+
+// Fixed-capacity multi-producer, multi-consumer queue.
+//
+// push() blocks while the queue is full, which is how a slow consumer slows
+// down whatever feeds it instead of letting work pile up in memory. pop()
+// blocks until an item arrives, and returns nothing once the queue has been
+// closed and drained.
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : capacity(std::max<size_t>(1, capacity)) {}
+
+    // Returns false if the queue was closed before the item got in
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (items.size() >= capacity && !closed) {
+            auto waitStart = Clock::now();
+            notFull.wait(lock, [this] { return items.size() < capacity || closed; });
+            pushWait += Clock::now() - waitStart;
+        }
+        if (closed) {
+            return false;
+        }
+        items.push_back(std::move(item));
+        pushed++;
+        depthSum += items.size();
+        maxDepth = std::max(maxDepth, items.size());
+        notEmpty.notify_one();
+        return true;
+    }
+
+    std::optional<T> pop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (items.empty() && !closed) {
+            auto waitStart = Clock::now();
+            notEmpty.wait(lock, [this] { return !items.empty() || closed; });
+            popWait += Clock::now() - waitStart;
+        }
+        if (items.empty()) {
+            return std::nullopt;
+        }
+        T item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return item;
+    }
+
+    // No more pushes; consumers drain what is left, blocked producers give up
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return items.size();
+    }
+
+    QueueStats stats() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        QueueStats result;
+        result.capacity = capacity;
+        result.pushed = pushed;
+        result.maxDepth = maxDepth;
+        result.meanDepth = pushed ? static_cast<double>(depthSum) / pushed : 0.0;
+        result.pushWaitMs = std::chrono::duration<double, std::milli>(pushWait).count();
+        result.popWaitMs = std::chrono::duration<double, std::milli>(popWait).count();
+        return result;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    const size_t capacity;
+    mutable std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::deque<T> items;
+    bool closed = false;
+
+    size_t pushed = 0;
+    size_t maxDepth = 0;
+    size_t depthSum = 0;
+    Clock::duration pushWait{0};
+    Clock::duration popWait{0};
+};
+
+} // namespace common
+} // namespace polymarket_bot
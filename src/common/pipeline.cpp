@@ -0,0 +1,94 @@
+#include "pipeline.h"
+#include <iomanip>
+#include <thread>
+
+namespace polymarket_bot {
+namespace common {
+
+Pipeline::Stage& Pipeline::addStage(const std::string& name, size_t workers) {
+    auto stage = std::make_unique<Stage>();
+    stage->name = name;
+    stage->workers = std::max<size_t>(1, workers);
+    stages.push_back(std::move(stage));
+    return *stages.back();
+}
+
+void Pipeline::finishItem(Stage& stage, Clock::time_point started) {
+    auto now = Clock::now();
+    stage.busyUs += std::chrono::duration_cast<std::chrono::microseconds>(now - started).count();
+    long long sinceRun = std::chrono::duration_cast<std::chrono::microseconds>(now - runStarted).count();
+    long long unset = -1;
+    stage.firstDoneUs.compare_exchange_strong(unset, sinceRun);
+    long long last = stage.lastDoneUs.load();
+    while (last < sinceRun && !stage.lastDoneUs.compare_exchange_weak(last, sinceRun)) {
+    }
+}
+
+void Pipeline::run() {
+    runStarted = Clock::now();
+    std::vector<std::thread> threads;
+    for (auto& stage : stages) {
+        stage->running = stage->workers;
+        for (size_t w = 0; w < stage->workers; ++w) {
+            threads.emplace_back([&stage]() {
+                stage->body();
+                if (--stage->running == 0) {
+                    stage->done();
+                }
+            });
+        }
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    runMs = std::chrono::duration<double, std::milli>(Clock::now() - runStarted).count();
+}
+
+std::vector<Pipeline::StageStats> Pipeline::stageStats() const {
+    std::vector<StageStats> result;
+    for (const auto& stage : stages) {
+        StageStats stats;
+        stats.name = stage->name;
+        stats.workers = stage->workers;
+        stats.processed = stage->processed;
+        stats.emitted = stage->emitted;
+        stats.errors = stage->errors;
+        stats.busyMs = stage->busyUs / 1000.0;
+        stats.firstDoneMs = stage->firstDoneUs < 0 ? -1.0 : stage->firstDoneUs / 1000.0;
+        stats.lastDoneMs = stage->lastDoneUs < 0 ? -1.0 : stage->lastDoneUs / 1000.0;
+        result.push_back(stats);
+    }
+    return result;
+}
+
+std::vector<std::pair<std::string, QueueStats>> Pipeline::queueStats() const {
+    std::vector<std::pair<std::string, QueueStats>> result;
+    for (const auto& queue : queues) {
+        result.emplace_back(queue.name, queue.stats());
+    }
+    return result;
+}
+
+void Pipeline::logStats() const {
+    std::cout << "[Pipeline] Finished in " << std::fixed << std::setprecision(0) << runMs << " ms" << std::endl;
+    for (const auto& stage : stageStats()) {
+        std::cout << "[Pipeline]   stage " << stage.name << ": " << stage.workers << " workers, " << stage.processed
+                  << " items, " << stage.emitted << " emitted, " << stage.errors << " errors, busy "
+                  << stage.busyMs << " ms";
+        if (stage.firstDoneMs >= 0) {
+            std::cout << ", first done at " << stage.firstDoneMs << " ms, last at " << stage.lastDoneMs << " ms";
+        }
+        std::cout << std::endl;
+    }
+    for (const auto& queue : queueStats()) {
+        std::cout << "[Pipeline]   queue " << queue.first << ": " << queue.second.pushed << " items, depth max "
+                  << queue.second.maxDepth << "/" << queue.second.capacity << " mean " << std::setprecision(1)
+                  << queue.second.meanDepth << std::setprecision(0) << ", producers blocked "
+                  << queue.second.pushWaitMs << " ms, consumers waiting " << queue.second.popWaitMs << " ms"
+                  << std::endl;
+    }
+    std::cout << std::defaultfloat;
+}
+
+} // namespace common
+} // namespace polymarket_bot
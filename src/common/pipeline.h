@@ -0,0 +1,152 @@
+#pragma once
+
+#include "bounded_queue.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace polymarket_bot {
+namespace common {
+
+// Stages with their own worker threads, connected by BoundedQueues.
+//
+// Each stage pops from its input queue, processes one item at a time on each
+// of its workers and emits any number of items into its output queue, so an
+// item moves on as soon as its stage is done with it rather than when the
+// whole batch is. Full queues block the stage feeding them (backpressure).
+// When the last worker of a stage finishes, its output queue is closed and
+// the next stage drains it and finishes in turn. Queues and stages must be
+// added before run().
+class Pipeline {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    template <typename T>
+    using Emit = std::function<void(T)>;
+
+    template <typename T>
+    std::shared_ptr<BoundedQueue<T>> queue(const std::string& name, size_t capacity) {
+        auto created = std::make_shared<BoundedQueue<T>>(capacity);
+        queues.push_back({name, [created]() { return created->stats(); }});
+        return created;
+    }
+
+    // A stage with no input: `produce` runs once on each worker
+    template <typename Out>
+    void source(const std::string& name, size_t workers, std::shared_ptr<BoundedQueue<Out>> out,
+                std::function<void(const Emit<Out>&)> produce) {
+        Stage& stage = addStage(name, workers);
+        stage.body = [this, &stage, out, produce]() {
+            Emit<Out> emit = [&stage, out](Out item) {
+                stage.emitted++;
+                out->push(std::move(item));
+            };
+            auto started = Clock::now();
+            try {
+                produce(emit);
+            } catch (const std::exception& e) {
+                stage.errors++;
+                std::cerr << "[Pipeline] " << stage.name << ": " << e.what() << std::endl;
+            }
+            stage.processed++;
+            finishItem(stage, started);
+        };
+        stage.done = [out]() { out->close(); };
+    }
+
+    template <typename In, typename Out>
+    void stage(const std::string& name, size_t workers, std::shared_ptr<BoundedQueue<In>> in,
+               std::shared_ptr<BoundedQueue<Out>> out, std::function<void(In, const Emit<Out>&)> process) {
+        Stage& stage = addStage(name, workers);
+        stage.body = [this, &stage, in, out, process]() {
+            Emit<Out> emit = [&stage, out](Out item) {
+                stage.emitted++;
+                out->push(std::move(item));
+            };
+            while (auto item = in->pop()) {
+                auto started = Clock::now();
+                try {
+                    process(std::move(*item), emit);
+                } catch (const std::exception& e) {
+                    stage.errors++;
+                    std::cerr << "[Pipeline] " << stage.name << ": " << e.what() << std::endl;
+                }
+                stage.processed++;
+                finishItem(stage, started);
+            }
+        };
+        stage.done = [out]() { out->close(); };
+    }
+
+    template <typename In>
+    void sink(const std::string& name, size_t workers, std::shared_ptr<BoundedQueue<In>> in,
+              std::function<void(In)> consume) {
+        Stage& stage = addStage(name, workers);
+        stage.body = [this, &stage, in, consume]() {
+            while (auto item = in->pop()) {
+                auto started = Clock::now();
+                try {
+                    consume(std::move(*item));
+                } catch (const std::exception& e) {
+                    stage.errors++;
+                    std::cerr << "[Pipeline] " << stage.name << ": " << e.what() << std::endl;
+                }
+                stage.processed++;
+                finishItem(stage, started);
+            }
+        };
+        stage.done = []() {};
+    }
+
+    // Starts every worker of every stage and returns once the last one has finished
+    void run();
+
+    struct StageStats {
+        std::string name;
+        size_t workers = 0;
+        size_t processed = 0;
+        size_t emitted = 0;
+        size_t errors = 0;
+        double busyMs = 0.0;           // Summed over workers, including time blocked on a full output queue
+        double firstDoneMs = -1.0;     // From run() to the first finished item, -1 if none
+        double lastDoneMs = -1.0;
+    };
+    std::vector<StageStats> stageStats() const;
+    std::vector<std::pair<std::string, QueueStats>> queueStats() const;
+    void logStats() const;
+
+private:
+    struct Stage {
+        std::string name;
+        size_t workers = 1;
+        std::function<void()> body;
+        std::function<void()> done;       // Run by the last worker to finish
+        std::atomic<size_t> running{0};
+        std::atomic<size_t> processed{0};
+        std::atomic<size_t> emitted{0};
+        std::atomic<size_t> errors{0};
+        std::atomic<long long> busyUs{0};
+        std::atomic<long long> firstDoneUs{-1};
+        std::atomic<long long> lastDoneUs{-1};
+    };
+
+    struct NamedQueue {
+        std::string name;
+        std::function<QueueStats()> stats;
+    };
+
+    Stage& addStage(const std::string& name, size_t workers);
+    void finishItem(Stage& stage, Clock::time_point started);
+
+    std::vector<std::unique_ptr<Stage>> stages;
+    std::vector<NamedQueue> queues;
+    Clock::time_point runStarted;
+    double runMs = 0.0;
+};
+
+} // namespace common
+} // namespace polymarket_bot
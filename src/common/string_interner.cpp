@@ -0,0 +1,78 @@
+#include "string_interner.h"
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+
+namespace polymarket_bot {
+namespace common {
+
+StringInterner& StringInterner::getInstance() {
+    static StringInterner instance;
+    return instance;
+}
+
+StringInterner::StringInterner() {
+    strings.emplace_back();
+    ids.emplace(strings.front(), emptyId);
+
+    // A bookmaker key repeated, or equal to a seeded key, would hand the interned:: ids to the wrong strings
+    auto seed = [this](std::string_view key, Id expected) {
+        if (intern(key) != expected) {
+            throw std::logic_error("StringInterner seed key " + std::string(key) + " did not get id " +
+                                   std::to_string(expected));
+        }
+    };
+    for (size_t book = 0; book < sportsBookCount; ++book) {
+        seed(sportsBookKey(static_cast<SportsBook>(book)), interned::bookmaker(static_cast<SportsBook>(book)));
+    }
+    for (std::string_view key : interned::seededKeys) {
+        seed(key, interned::seeded(key));
+    }
+}
+
+StringInterner::Id StringInterner::intern(std::string_view text) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = ids.find(text);
+        if (it != ids.end()) {
+            return it->second;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto it = ids.find(text);   // Another thread may have added it in between
+    if (it != ids.end()) {
+        return it->second;
+    }
+    Id id = static_cast<Id>(strings.size());
+    strings.emplace_back(text);
+    ids.emplace(strings.back(), id);
+    bytes += text.size();
+    return id;
+}
+
+std::optional<StringInterner::Id> StringInterner::find(std::string_view text) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    auto it = ids.find(text);
+    if (it == ids.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+std::string_view StringInterner::view(Id id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return id < strings.size() ? std::string_view(strings[id]) : std::string_view();
+}
+
+size_t StringInterner::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return strings.size();
+}
+
+void StringInterner::logStats() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    std::cout << "[StringInterner] " << strings.size() << " strings, " << bytes / 1024 << " KiB of text" << std::endl;
+}
+
+} // namespace common
+} // namespace polymarket_bot
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "types.h"
+
+namespace polymarket_bot {
+namespace common {
+
+// Process-wide table of strings that recur across scans, each stored once
+// and named by a dense 32-bit id.
+//
+// Ids are stable for the life of the process, so records can hold them in
+// place of std::string and compare or hash them as integers. Id 0 is always
+// the empty string, which lets a zero-initialized field mean "missing". The
+// keys in `interned` below are added first, so code can branch on them as
+// constants.
+//
+// Nothing is ever removed, so the table only grows. Sport, bookmaker and
+// market keys, team names and outcome names come from small sets and level
+// off within the first scans. Market slugs, market ids and CLOB token ids do
+// not: every market that appears adds about four strings (roughly half a
+// kilobyte with the index), and they stay after the game is over. At a few
+// hundred new sports markets a day that is well under a megabyte a day;
+// logStats() reports the size so a long-running process can be watched.
+// Never intern free-form text such as questions or descriptions.
+class StringInterner {
+public:
+    using Id = uint32_t;
+    static constexpr Id emptyId = 0;
+
+    static StringInterner& getInstance();
+
+    Id intern(std::string_view text);
+    // The id of text if it was interned before, without adding it
+    std::optional<Id> find(std::string_view text) const;
+    // Valid for the life of the process
+    std::string_view view(Id id) const;
+    size_t size() const;
+    void logStats() const;
+
+private:
+    StringInterner();
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    mutable std::shared_mutex mutex;
+    std::deque<std::string> strings;                 // Indexed by id; a deque never moves its elements
+    std::unordered_map<std::string_view, Id> ids;    // Views into strings
+    size_t bytes = 0;                                // Characters held, not counting the index
+};
+
+// Ids of the keys seeded into every interner: one per SportsBook (in enum order), then seededKeys in order.
+// The constants are derived from that table, so they cannot drift from the seeding order.
+namespace interned {
+
+inline constexpr std::string_view seededKeys[] = {
+    "h2h", "spreads", "totals", "basketball_nba", "basketball_nba_summer_league", "icehockey_nhl", "baseball_mlb"
+};
+
+constexpr StringInterner::Id bookmaker(SportsBook book) { return 1 + static_cast<StringInterner::Id>(book); }
+
+// Id of a key in seededKeys; not a constant expression (so a compile error) for any other key
+constexpr StringInterner::Id seeded(std::string_view key) {
+    for (size_t i = 0; i < std::size(seededKeys); ++i) {
+        if (seededKeys[i] == key) {
+            return static_cast<StringInterner::Id>(1 + sportsBookCount + i);
+        }
+    }
+    throw "not a seeded key";
+}
+
+constexpr bool seededKeysDistinct() {
+    for (size_t i = 0; i < std::size(seededKeys); ++i) {
+        for (size_t j = i + 1; j < std::size(seededKeys); ++j) {
+            if (seededKeys[i] == seededKeys[j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+static_assert(seededKeysDistinct(), "a repeated seeded key would shift every id after it");
+
+constexpr StringInterner::Id h2h = seeded("h2h");
+constexpr StringInterner::Id spreads = seeded("spreads");
+constexpr StringInterner::Id totals = seeded("totals");
+constexpr StringInterner::Id basketballNba = seeded("basketball_nba");
+constexpr StringInterner::Id basketballNbaSummerLeague = seeded("basketball_nba_summer_league");
+constexpr StringInterner::Id icehockeyNhl = seeded("icehockey_nhl");
+constexpr StringInterner::Id baseballMlb = seeded("baseball_mlb");
+
+} // namespace interned
+
+} // namespace common
+} // namespace polymarket_bot
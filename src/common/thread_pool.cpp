@@ -0,0 +1,160 @@
+#include "thread_pool.h"
+#include <algorithm>
+#include <iostream>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace polymarket_bot {
+namespace common {
+
+namespace {
+
+std::mutex settingsMutex;
+ThreadPool::Settings pendingSettings;
+bool started = false;
+
+// Which pool and worker the current thread belongs to, so posts from a worker stay local
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local size_t currentWorker = 0;
+
+} // namespace
+
+void ThreadPool::configure(const Settings& settings) {
+    std::lock_guard<std::mutex> lock(settingsMutex);
+    if (started) {
+        std::cerr << "[ThreadPool] Already running, ignoring new settings" << std::endl;
+        return;
+    }
+    pendingSettings = settings;
+}
+
+ThreadPool& ThreadPool::getInstance() {
+    static ThreadPool instance([]() {
+        std::lock_guard<std::mutex> lock(settingsMutex);
+        started = true;
+        return pendingSettings;
+    }());
+    return instance;
+}
+
+ThreadPool::ThreadPool(const Settings& settings) {
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    // Two at least: a task blocked on the network must not stall coroutine resumption
+    size_t count = std::max<size_t>(2, settings.threads > 0 ? settings.threads : cores);
+    for (size_t i = 0; i < count; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < count; ++i) {
+        threads.emplace_back(&ThreadPool::run, this, i);
+#ifdef __linux__
+        if (settings.pinThreads) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(i % cores, &cpus);
+            if (pthread_setaffinity_np(threads.back().native_handle(), sizeof(cpus), &cpus) != 0) {
+                std::cerr << "[ThreadPool] Could not pin worker " << i << " to core " << i % cores << std::endl;
+            }
+        }
+#endif
+    }
+    std::cout << "[ThreadPool] Started " << count << " workers" << (settings.pinThreads ? " pinned to cores" : "")
+              << std::endl;
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeup.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::post(TaskPriority priority, std::function<void()> task) {
+    size_t index = currentPool == this ? currentWorker : nextWorker++ % workers.size();
+    {
+        std::lock_guard<std::mutex> lock(workers[index]->mutex);
+        workers[index]->queues[static_cast<size_t>(priority)].push_back(std::move(task));
+        queued++;   // Under the worker lock, so no thief can decrement it first
+    }
+    {
+        // Taking the lock orders this post against a worker that just found nothing and is about to sleep
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wakeup.notify_one();
+}
+
+bool ThreadPool::takeTask(size_t index, std::function<void()>& task) {
+    for (size_t priority = 0; priority < 3; ++priority) {
+        {
+            Worker& own = *workers[index];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            auto& queue = own.queues[priority];
+            if (!queue.empty()) {
+                task = std::move(queue.back());
+                queue.pop_back();
+                queued--;
+                executed[priority]++;
+                return true;
+            }
+        }
+        for (size_t offset = 1; offset < workers.size(); ++offset) {
+            Worker& victim = *workers[(index + offset) % workers.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            auto& queue = victim.queues[priority];
+            if (!queue.empty()) {
+                task = std::move(queue.front());
+                queue.pop_front();
+                queued--;
+                executed[priority]++;
+                stolen++;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run(size_t index) {
+    currentPool = this;
+    currentWorker = index;
+    while (true) {
+        std::function<void()> task;
+        if (takeTask(index, task)) {
+            try {
+                task();
+            } catch (const std::exception& e) {
+                std::cerr << "[ThreadPool] Task failed: " << e.what() << std::endl;
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeup.wait(lock, [this]() { return stopping || queued > 0; });
+        if (stopping && queued == 0) {
+            return;
+        }
+    }
+}
+
+ThreadPool::Stats ThreadPool::stats() const {
+    Stats result;
+    for (size_t priority = 0; priority < 3; ++priority) {
+        result.executed[priority] = executed[priority];
+    }
+    result.stolen = stolen;
+    return result;
+}
+
+void ThreadPool::logStats() const {
+    Stats current = stats();
+    std::cout << "[ThreadPool] " << workers.size() << " workers ran " << current.executed[0] << " execution, "
+              << current.executed[1] << " pricing and " << current.executed[2] << " background tasks, "
+              << current.stolen << " stolen" << std::endl;
+}
+
+} // namespace common
+} // namespace polymarket_bot
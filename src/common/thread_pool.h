@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace polymarket_bot {
+namespace common {
+
+// Lower values run first: an order waiting to go out beats a price update, which beats housekeeping
+enum class TaskPriority {
+    Execution = 0,
+    Pricing = 1,
+    Background = 2
+};
+
+// Work-stealing pool shared by every subsystem, sized once for the whole process.
+//
+// Each worker owns a deque per priority. Tasks posted from a worker go to its
+// own deques and are taken newest first, while they are still in cache; tasks
+// posted from any other thread are dealt round-robin. A worker with nothing of
+// a given priority steals the oldest task of that priority from the others
+// before it looks at lower priorities, so priorities hold across the pool, not
+// just per worker. Tasks should not block for long: a worker stuck waiting is
+// a core the rest of the bot cannot use.
+class ThreadPool {
+public:
+    struct Settings {
+        size_t threads = 0;         // 0 = one per core
+        bool pinThreads = false;    // Pin worker i to core i (Linux only)
+    };
+
+    // Takes effect only before the first getInstance()
+    static void configure(const Settings& settings);
+    static ThreadPool& getInstance();
+
+    void post(TaskPriority priority, std::function<void()> task);
+
+    template <typename F>
+    auto submit(TaskPriority priority, F fn) -> std::future<std::invoke_result_t<F>> {
+        using Result = std::invoke_result_t<F>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::move(fn));
+        auto future = task->get_future();
+        post(priority, [task]() { (*task)(); });
+        return future;
+    }
+
+    size_t size() const { return workers.size(); }
+
+    struct Stats {
+        std::array<size_t, 3> executed{};   // By priority
+        size_t stolen = 0;
+    };
+    Stats stats() const;
+    void logStats() const;
+
+private:
+    explicit ThreadPool(const Settings& settings);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    struct Worker {
+        std::mutex mutex;
+        std::array<std::deque<std::function<void()>>, 3> queues;
+    };
+
+    void run(size_t index);
+    bool takeTask(size_t index, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+    std::atomic<size_t> nextWorker{0};
+    std::atomic<size_t> queued{0};
+    std::mutex sleepMutex;
+    std::condition_variable wakeup;
+    bool stopping = false;
+
+    std::array<std::atomic<size_t>, 3> executed{};
+    std::atomic<size_t> stolen{0};
+};
+
+} // namespace common
+} // namespace polymarket_bot
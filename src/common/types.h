@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
@@ -31,16 +32,46 @@ enum class SportsBook {
     WILLIAMHILL_US
 };
 
+inline constexpr size_t sportsBookCount = static_cast<size_t>(SportsBook::WILLIAMHILL_US) + 1;
+
+// The Odds API bookmaker key for each SportsBook
+inline const char* sportsBookKey(SportsBook book) {
+    switch (book) {
+        case SportsBook::PINNACLE: return "pinnacle";
+        case SportsBook::BETFAIR: return "betfair_ex_eu";
+        case SportsBook::BET365: return "bet365";
+        case SportsBook::DRAFTKINGS: return "draftkings";
+        case SportsBook::FANDUEL: return "fanduel";
+        case SportsBook::FOX_BET: return "foxbet";
+        case SportsBook::MGM: return "mgm";
+        case SportsBook::BETMGM: return "betmgm";
+        case SportsBook::BETRIVIAL: return "betrivial";
+        case SportsBook::UNIBET: return "unibet";
+        case SportsBook::CAESARS: return "caesars";
+        case SportsBook::SUGARHOUSE: return "sugarhouse";
+        case SportsBook::POINTSBETUS: return "pointsbetus";
+        case SportsBook::BETONLINEAG: return "betonlineag";
+        case SportsBook::BETRIVERS: return "betrivers";
+        case SportsBook::BARSTOOL: return "barstool";
+        case SportsBook::BOVADA: return "bovada";
+        case SportsBook::WILLIAMHILL_US: return "williamhill_us";
+    }
+    return "";
+}
+
 // Raw Odds API Response Structures
+// The *Id members are StringInterner ids of the matching strings, set by OddsResponseParser (0 if unset)
 struct OddsOutcome {
     std::string name;
     double price;  // Decimal odds format (e.g., 1.7, 5.0)
     std::optional<double> point;  // Optional, for spreads/totals
+    uint32_t nameId = 0;
 };
 
 struct OddsMarket {
     std::string key;  // e.g., "h2h", "spreads", "totals"
     std::vector<OddsOutcome> outcomes;
+    uint32_t keyId = 0;
 };
 
 struct OddsBookmaker {
@@ -48,6 +79,7 @@ struct OddsBookmaker {
     std::string title;  // e.g., "Unibet", "Caesars"
     std::string last_update;  // ISO 8601 timestamp
     std::vector<OddsMarket> markets;
+    uint32_t keyId = 0;
 };
 
 struct RawOddsGame {
@@ -57,6 +89,9 @@ struct RawOddsGame {
     std::string home_team;
     std::string away_team;
     std::vector<OddsBookmaker> bookmakers;
+    uint32_t sportKeyId = 0;
+    uint32_t homeTeamId = 0;
+    uint32_t awayTeamId = 0;
 };
 
 struct RawOddsResponse {
@@ -59,6 +59,11 @@ public:
                     const char* oddsApiKey = std::getenv("ODDS_API_KEY");
                     config.apis.oddsApi.apiKey = oddsApiKey ? oddsApiKey : "";
                     config.apis.oddsApi.rateLimitPerMinute = oddsApi["rateLimitPerMinute"];
+                    config.apis.oddsApi.regions = oddsApi.value("regions", std::vector<std::string>{"us", "uk"});
+                    config.apis.oddsApi.markets = oddsApi.value("markets", std::vector<std::string>{"h2h"});
+                    config.apis.oddsApi.extraBookmakers = oddsApi.value("extraBookmakers", std::vector<std::string>{"betfair_ex_eu", "draftkings"});
+                    config.apis.oddsApi.oddsFormat = oddsApi.value("oddsFormat", std::string("decimal"));
+                    config.apis.oddsApi.dateFormat = oddsApi.value("dateFormat", std::string("unix"));
                 }
                 
                 if (apis.contains("polymarket")) {
@@ -91,9 +96,17 @@ public:
 
                     
                     config.apis.polymarket.chainId = polymarket["chainId"];
+                    config.apis.polymarket.clobRateLimitPerMinute = polymarket.value("clobRateLimitPerMinute", 600);
+                    config.apis.polymarket.gammaRateLimitPerMinute = polymarket.value("gammaRateLimitPerMinute", 600);
+                    config.apis.polymarket.dataRateLimitPerMinute = polymarket.value("dataRateLimitPerMinute", 300);
+                    config.apis.polymarket.marketWsUrl = polymarket.value("marketWsUrl",
+                        std::string("wss://ws-subscriptions-clob.polymarket.com/ws/market"));
 
                 }
 
+                config.apis.connectTimeoutMs = apis.value("connectTimeoutMs", 5000);
+                config.apis.requestTimeoutMs = apis.value("requestTimeoutMs", 30000);
+
 
             }
 
@@ -143,6 +156,15 @@ public:
                 auto& matching = j["matching"];
                 config.matching.minConfidenceScore = matching["minConfidenceScore"];
                 config.matching.maxTimeDifference = matching["maxTimeDifference"];
+                config.matching.parallelSlugResolution = matching.value("parallelSlugResolution", true);
+                config.matching.maxConcurrentRequests = matching.value("maxConcurrentRequests", 5);
+                config.matching.useGammaSnapshot = matching.value("useGammaSnapshot", true);
+                if (matching.contains("gammaTagIds")) {
+                    config.matching.gammaTagIds = matching["gammaTagIds"].get<std::vector<int>>();
+                }
+                config.matching.negativeCacheTtl = matching.value("negativeCacheTtl", 900);
+                config.matching.pipelinedScan = matching.value("pipelinedScan", true);
+                config.matching.pipelineQueueCapacity = matching.value("pipelineQueueCapacity", 64);
             }
 
             // Parse sync
@@ -151,6 +173,23 @@ public:
                 config.sync.positionSyncInterval = sync["positionSyncInterval"];
                 config.sync.accountSyncInterval = sync["accountSyncInterval"];
                 config.sync.priceUpdateInterval = sync["priceUpdateInterval"];
+                config.sync.scanBudgetMs = sync.value("scanBudgetMs", 120000);
+                config.sync.warmupLeadSeconds = sync.value("warmupLeadSeconds", 5);
+                config.sync.warmupConnectionsPerHost = sync.value("warmupConnectionsPerHost", 4);
+                config.sync.discoveryIntervalSeconds = sync.value("discoveryIntervalSeconds", 1800);
+                if (sync.contains("pollBuckets")) {
+                    config.sync.pollBuckets.clear();
+                    for (const auto& bucket : sync["pollBuckets"]) {
+                        config.sync.pollBuckets.push_back({bucket["maxMinutesToStart"], bucket["intervalSeconds"]});
+                    }
+                }
+            }
+
+            // Parse thread pool
+            if (j.contains("threadPool")) {
+                auto& threadPool = j["threadPool"];
+                config.threadPool.threads = threadPool.value("threads", 0);
+                config.threadPool.pinThreads = threadPool.value("pinThreads", false);
             }
 
             return true;
@@ -177,6 +216,21 @@ public:
             return false;
         }
         
+        if (config.apis.oddsApi.markets.empty()) {
+            lastError = "At least one odds market must be requested";
+            return false;
+        }
+        
+        if (config.apis.oddsApi.oddsFormat != "decimal") {
+            lastError = "Odds format must be decimal (prices are compared as decimal odds)";
+            return false;
+        }
+        
+        if (config.apis.oddsApi.dateFormat != "unix" && config.apis.oddsApi.dateFormat != "iso") {
+            lastError = "Odds date format must be unix or iso";
+            return false;
+        }
+        
         if (config.apis.polymarket.baseUrl.empty()) {
             lastError = "Polymarket base URL is required";
             return false;
@@ -211,6 +265,18 @@ public:
             lastError = "Polymarket chain ID must be positive";
             return false;
         }
+        
+        if (config.apis.polymarket.clobRateLimitPerMinute <= 0 ||
+            config.apis.polymarket.gammaRateLimitPerMinute <= 0 ||
+            config.apis.polymarket.dataRateLimitPerMinute <= 0) {
+            lastError = "Polymarket rate limits must be positive";
+            return false;
+        }
+
+        if (config.apis.connectTimeoutMs <= 0 || config.apis.requestTimeoutMs <= 0) {
+            lastError = "HTTP connect and request timeouts must be positive";
+            return false;
+        }
 
         // Validate database configuration
         if (config.database.path.empty()) {
@@ -265,6 +331,28 @@ public:
             lastError = "Maximum time difference must be positive";
             return false;
         }
+        
+        if (config.matching.maxConcurrentRequests <= 0) {
+            lastError = "Maximum concurrent requests must be positive";
+            return false;
+        }
+        
+        if (config.matching.negativeCacheTtl < 0) {
+            lastError = "Negative cache TTL must not be negative";
+            return false;
+        }
+        
+        for (int tagId : config.matching.gammaTagIds) {
+            if (tagId <= 0) {
+                lastError = "Gamma tag ids must be positive";
+                return false;
+            }
+        }
+        
+        if (config.matching.pipelineQueueCapacity <= 0) {
+            lastError = "Pipeline queue capacity must be positive";
+            return false;
+        }
 
         // Validate sync intervals
         if (config.sync.positionSyncInterval <= 0) {
@@ -281,6 +369,40 @@ public:
             lastError = "Price update interval must be positive";
             return false;
         }
+        
+        if (config.sync.scanBudgetMs < 0) {
+            lastError = "Scan budget must not be negative";
+            return false;
+        }
+
+        // Past 60 seconds the DNS cache entries from the warm-up expire before the scan starts
+        if (config.sync.warmupLeadSeconds < 0 || config.sync.warmupLeadSeconds > 60) {
+            lastError = "Warm-up lead time must be between 0 and 60 seconds";
+            return false;
+        }
+
+        if (config.sync.warmupConnectionsPerHost < 1) {
+            lastError = "Warm-up must open at least one connection per host";
+            return false;
+        }
+
+        if (config.sync.pollBuckets.empty() || config.sync.discoveryIntervalSeconds <= 0) {
+            lastError = "Poll buckets and discovery interval are required";
+            return false;
+        }
+        for (size_t i = 0; i < config.sync.pollBuckets.size(); ++i) {
+            const auto& bucket = config.sync.pollBuckets[i];
+            if (bucket.intervalSeconds <= 0 ||
+                (i > 0 && bucket.maxMinutesToStart <= config.sync.pollBuckets[i - 1].maxMinutesToStart)) {
+                lastError = "Poll buckets need positive intervals and increasing maxMinutesToStart";
+                return false;
+            }
+        }
+
+        if (config.threadPool.threads < 0) {
+            lastError = "Thread pool size must not be negative";
+            return false;
+        }
 
         // Validate sharp books
         if (config.sharpBooks.empty()) {
@@ -345,6 +467,22 @@ std::string ConfigManager::getOddsApiKey() const {
     return pImpl->config.apis.oddsApi.apiKey;
 }
 
+std::string ConfigManager::getOddsApiBaseUrl() const {
+    return pImpl->config.apis.oddsApi.baseUrl;
+}
+
+int ConfigManager::getOddsApiRateLimitPerMinute() const {
+    return pImpl->config.apis.oddsApi.rateLimitPerMinute;
+}
+
+int ConfigManager::getConnectTimeoutMs() const {
+    return pImpl->config.apis.connectTimeoutMs;
+}
+
+int ConfigManager::getRequestTimeoutMs() const {
+    return pImpl->config.apis.requestTimeoutMs;
+}
+
 // Polymarket credentials getters
 std::string ConfigManager::getPolymarketAddress() const {
     return pImpl->config.apis.polymarket.address;
@@ -378,6 +516,10 @@ std::string ConfigManager::getPolymarketDataBaseUrl() const {
     return pImpl->config.apis.polymarket.dataBaseUrl;
 }
 
+std::string ConfigManager::getPolymarketMarketWsUrl() const {
+    return pImpl->config.apis.polymarket.marketWsUrl;
+}
+
 int ConfigManager::getPolymarketChainId() const {
     return pImpl->config.apis.polymarket.chainId;
 }
@@ -441,6 +583,34 @@ int ConfigManager::getMaxTimeDifference() const {
     return pImpl->config.matching.maxTimeDifference;
 }
 
+bool ConfigManager::isParallelSlugResolution() const {
+    return pImpl->config.matching.parallelSlugResolution;
+}
+
+int ConfigManager::getMaxConcurrentRequests() const {
+    return pImpl->config.matching.maxConcurrentRequests;
+}
+
+bool ConfigManager::useGammaSnapshot() const {
+    return pImpl->config.matching.useGammaSnapshot;
+}
+
+int ConfigManager::getNegativeCacheTtl() const {
+    return pImpl->config.matching.negativeCacheTtl;
+}
+
+bool ConfigManager::isPipelinedScan() const {
+    return pImpl->config.matching.pipelinedScan;
+}
+
+const std::vector<int>& ConfigManager::getGammaTagIds() const {
+    return pImpl->config.matching.gammaTagIds;
+}
+
+int ConfigManager::getPipelineQueueCapacity() const {
+    return pImpl->config.matching.pipelineQueueCapacity;
+}
+
 int ConfigManager::getPositionSyncInterval() const {
     return pImpl->config.sync.positionSyncInterval;
 }
@@ -453,6 +623,34 @@ int ConfigManager::getPriceUpdateInterval() const {
     return pImpl->config.sync.priceUpdateInterval;
 }
 
+int ConfigManager::getScanBudgetMs() const {
+    return pImpl->config.sync.scanBudgetMs;
+}
+
+int ConfigManager::getWarmupLeadSeconds() const {
+    return pImpl->config.sync.warmupLeadSeconds;
+}
+
+int ConfigManager::getWarmupConnectionsPerHost() const {
+    return pImpl->config.sync.warmupConnectionsPerHost;
+}
+
+const std::vector<PollBucket>& ConfigManager::getPollBuckets() const {
+    return pImpl->config.sync.pollBuckets;
+}
+
+int ConfigManager::getDiscoveryIntervalSeconds() const {
+    return pImpl->config.sync.discoveryIntervalSeconds;
+}
+
+int ConfigManager::getThreadPoolSize() const {
+    return pImpl->config.threadPool.threads;
+}
+
+bool ConfigManager::isThreadPoolPinned() const {
+    return pImpl->config.threadPool.pinThreads;
+}
+
 void ConfigManager::addValidationCallback(ValidationCallback callback) {
     pImpl->validationCallbacks.push_back(callback);
 }
@@ -26,11 +26,16 @@ public:
     
     // API credentials management
     std::string getOddsApiKey() const;
+    std::string getOddsApiBaseUrl() const;
+    int getOddsApiRateLimitPerMinute() const;
+    int getConnectTimeoutMs() const;
+    int getRequestTimeoutMs() const;
     
     // Polymarket credentials management
     std::string getPolymarketBaseUrl() const;
     std::string getPolymarketGammaBaseUrl() const;
     std::string getPolymarketDataBaseUrl() const;
+    std::string getPolymarketMarketWsUrl() const;
     std::string getPolymarketAddress() const;
     std::string getPolymarketSignature() const;
     std::string getPolymarketTimestamp() const;
@@ -62,11 +67,27 @@ public:
     // Market matching parameters
     double getMinConfidenceScore() const;
     int getMaxTimeDifference() const;
+    bool isParallelSlugResolution() const;
+    int getMaxConcurrentRequests() const;
+    bool useGammaSnapshot() const;
+    int getNegativeCacheTtl() const;
+    bool isPipelinedScan() const;
+    int getPipelineQueueCapacity() const;
+    const std::vector<int>& getGammaTagIds() const;
     
     // Sync intervals
     int getPositionSyncInterval() const;
     int getAccountSyncInterval() const;
     int getPriceUpdateInterval() const;
+    int getScanBudgetMs() const;
+    int getWarmupLeadSeconds() const;
+    int getWarmupConnectionsPerHost() const;
+    const std::vector<PollBucket>& getPollBuckets() const;
+    int getDiscoveryIntervalSeconds() const;
+    
+    // Shared worker pool
+    int getThreadPoolSize() const;
+    bool isThreadPoolPinned() const;
     
     // Configuration validation callbacks
     using ValidationCallback = std::function<bool(const Config&)>;
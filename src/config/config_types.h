@@ -13,6 +13,12 @@ struct OddsApiConfig {
     std::string baseUrl;
     std::string apiKey;
     int rateLimitPerMinute;
+    std::vector<std::string> regions = {"us", "uk"};  // Only used when no bookmakers are configured
+    std::vector<std::string> markets = {"h2h"};
+    // Requested in addition to sharpBooks; the matcher prices from these when no sharp book quotes a game
+    std::vector<std::string> extraBookmakers = {"betfair_ex_eu", "draftkings"};
+    std::string oddsFormat = "decimal";
+    std::string dateFormat = "unix";
 };
 
 struct PolymarketConfig {
@@ -25,11 +31,17 @@ struct PolymarketConfig {
     std::string apiKey;
     std::string passphrase;
     int chainId;
+    int clobRateLimitPerMinute = 600;   // Request budgets per host
+    int gammaRateLimitPerMinute = 600;
+    int dataRateLimitPerMinute = 300;
+    std::string marketWsUrl = "wss://ws-subscriptions-clob.polymarket.com/ws/market";  // Live prices; empty = poll only
 };
 
 struct ApiConfig {
     OddsApiConfig oddsApi;
     PolymarketConfig polymarket;
+    int connectTimeoutMs = 5000;    // Per-request limits for every HTTP call
+    int requestTimeoutMs = 30000;
 };
 
 // Database Configuration
@@ -58,6 +70,19 @@ struct RiskConfig {
 struct MatchingConfig {
     double minConfidenceScore;
     int maxTimeDifference;
+    bool parallelSlugResolution = true;  // Resolve games concurrently instead of one after another
+    int maxConcurrentRequests = 5;       // Cap on games being resolved at the same time
+    bool useGammaSnapshot = true;        // Match slugs against a bulk Gamma snapshot instead of per-slug requests
+    std::vector<int> gammaTagIds = {745, 899, 100381};  // Gamma tags the snapshot lists (NBA, NHL, MLB); empty lists everything
+    int negativeCacheTtl = 900;          // Seconds a slug with no market is skipped before being probed again
+    bool pipelinedScan = true;           // Stream games through fetch, parse, match, price and execute stages
+    int pipelineQueueCapacity = 64;      // Items buffered between two pipeline stages before the earlier one blocks
+};
+
+// Polling cadence for games starting within maxMinutesToStart (games further out use the last bucket)
+struct PollBucket {
+    int maxMinutesToStart;
+    int intervalSeconds;
 };
 
 // Synchronization Configuration
@@ -65,6 +90,17 @@ struct SyncConfig {
     int positionSyncInterval;
     int accountSyncInterval;
     int priceUpdateInterval;
+    int scanBudgetMs = 120000;   // Latency budget for one scan cycle (0 = unlimited)
+    int warmupLeadSeconds = 5;   // Open connections this long before each scan (0 = no warm-up)
+    int warmupConnectionsPerHost = 4;
+    std::vector<PollBucket> pollBuckets = {{60, 30}, {360, 120}, {1440, 600}, {10080, 1800}};
+    int discoveryIntervalSeconds = 1800;  // Full re-listing of every sport, to pick up new games
+};
+
+// Worker threads shared by matching, parsing, order execution and background work
+struct ThreadPoolConfig {
+    int threads = 0;            // 0 = one per core
+    bool pinThreads = false;    // Pin each worker to its own core
 };
 
 // Main Configuration Structure
@@ -77,6 +113,7 @@ struct Config {
     RiskConfig risk;
     MatchingConfig matching;
     SyncConfig sync;
+    ThreadPoolConfig threadPool;
 };
 
 } // namespace config
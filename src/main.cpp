@@ -3,6 +3,8 @@
 #include <algorithm>
 #include "api/odds_api_client.h"
 #include "api/polymarket_api_client.h"
+#include "api/rate_limiter.h"
+#include "api/http_transport.h"
 #include "config/config_manager.h"
 #include "market/market_matcher.h"
 #include <fstream>
@@ -90,8 +92,10 @@ int main(int argc, char* argv[]) {
         }
         std::cout << std::endl;
         
-        // Set rate limit
-        client.setRateLimit(10); // 10 requests per minute
+        // Set per-host rate limits and per-request timeouts
+        polymarket_bot::api::RateLimiterRegistry::getInstance().configureFromConfig(configManager);
+        polymarket_bot::api::HttpTransport::getInstance().setTimeouts(configManager.getConnectTimeoutMs(),
+                                                                      configManager.getRequestTimeoutMs());
         
         std::cout << "Bot is ready to fetch odds data" << std::endl;
 
@@ -0,0 +1,243 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "api/gamma_market_decoder.h"
+#include "api/odds_response_parser.h"
+
+using polymarket_bot::api::GammaMarketDecoder;
+using polymarket_bot::api::GammaProjection;
+using polymarket_bot::api::OddsResponseParser;
+using polymarket_bot::common::RawOddsGame;
+
+namespace {
+
+// An odds response shaped like the real one: every game quoted by many books across h2h, spreads and totals
+std::string syntheticResponse(int games, int bookmakers) {
+    nlohmann::json body = nlohmann::json::array();
+    long long commence = 1767225600;
+    for (int g = 0; g < games; ++g) {
+        std::string home = "Home Team " + std::to_string(g);
+        std::string away = "Away Team " + std::to_string(g);
+        nlohmann::json books = nlohmann::json::array();
+        for (int b = 0; b < bookmakers; ++b) {
+            double base = 1.5 + 0.01 * ((g * 7 + b * 3) % 100);
+            nlohmann::json markets = nlohmann::json::array();
+            markets.push_back({{"key", "h2h"}, {"last_update", commence - 600},
+                               {"outcomes", {{{"name", home}, {"price", base}},
+                                             {{"name", away}, {"price", 1.0 / (1.0 - 1.0 / base) + 0.05}}}}});
+            markets.push_back({{"key", "spreads"}, {"last_update", commence - 600},
+                               {"outcomes", {{{"name", home}, {"price", 1.91}, {"point", -3.5}},
+                                             {{"name", away}, {"price", 1.91}, {"point", 3.5}}}}});
+            markets.push_back({{"key", "totals"}, {"last_update", commence - 600},
+                               {"outcomes", {{{"name", "Over"}, {"price", 1.87}, {"point", 45.5}},
+                                             {{"name", "Under"}, {"price", 1.95}, {"point", 45.5}}}}});
+            books.push_back({{"key", "book" + std::to_string(b)}, {"title", "Book " + std::to_string(b)},
+                             {"last_update", commence - 600}, {"markets", markets}});
+        }
+        body.push_back({{"id", "event" + std::to_string(g)}, {"sport_key", "americanfootball_nfl"},
+                        {"sport_title", "NFL"}, {"commence_time", commence + g * 900},
+                        {"home_team", home}, {"away_team", away}, {"bookmakers", books}});
+    }
+    return body.dump();
+}
+
+// A Gamma /markets page: every market carries the full field set the listing returns
+std::string syntheticGammaPage(int markets) {
+    nlohmann::json page = nlohmann::json::array();
+    for (int m = 0; m < markets; ++m) {
+        std::string n = std::to_string(m);
+        std::string slug = "nfl-home" + n + "-away" + n + "-2026-01-01";
+        double price = 0.05 + 0.9 * ((m * 37) % 100) / 100.0;
+        std::string prices = "[\"" + std::to_string(price) + "\", \"" + std::to_string(1.0 - price) + "\"]";
+        std::string tokens = "[\"" + std::string(70, '1') + n + "\", \"" + std::string(70, '2') + n + "\"]";
+        page.push_back({
+            {"id", std::to_string(500000 + m)}, {"question", "Home " + n + " vs. Away " + n},
+            {"conditionId", "0x" + std::string(60, 'a') + n}, {"slug", slug},
+            {"resolutionSource", "https://www.nfl.com/"}, {"endDate", "2026-01-01T20:00:00Z"},
+            {"liquidity", "15234.55"}, {"startDate", "2025-12-20T12:00:00Z"},
+            {"image", "https://polymarket-upload.s3.us-east-2.amazonaws.com/nfl-" + n + ".png"},
+            {"icon", "https://polymarket-upload.s3.us-east-2.amazonaws.com/nfl-" + n + "-icon.png"},
+            {"description", "In the upcoming NFL game, scheduled for January 1, 2026, the \"Home " + n +
+                                "\" face the \"Away " + n + "\". If the Home team wins, the market will resolve "
+                                "to \"Home\". Otherwise it will resolve to \"Away\". If the game is postponed, "
+                                "this market will remain open until the game has been completed.\nResolution "
+                                "source: the official NFL website."},
+            {"outcomes", "[\"Home " + n + "\", \"Away " + n + "\"]"}, {"outcomePrices", prices},
+            {"volume", "48211.21"}, {"active", true}, {"closed", false},
+            {"marketMakerAddress", ""}, {"createdAt", "2025-12-18T09:13:45.123Z"},
+            {"updatedAt", "2025-12-31T23:59:01.456Z"}, {"new", false}, {"featured", false},
+            {"submitted_by", "0x91430CaD2d3975766499717fA0D66A78D814E5c5"}, {"archived", false},
+            {"resolvedBy", "0x6A9D222616C90FcA5754cd1333cFD9b7fb6a4F74"}, {"restricted", true},
+            {"groupItemTitle", ""}, {"groupItemThreshold", "0"}, {"questionID", "0x" + std::string(62, 'b') + n},
+            {"enableOrderBook", true}, {"orderPriceMinTickSize", 0.01}, {"orderMinSize", 5},
+            {"volumeNum", 48211.21}, {"liquidityNum", 15234.55}, {"endDateIso", "2026-01-01"},
+            {"startDateIso", "2025-12-20"}, {"hasReviewedDates", true}, {"volume24hr", 3120.5},
+            {"volume1wk", 20110.2}, {"volume1mo", 48211.21}, {"volume1yr", 48211.21},
+            {"clobTokenIds", tokens}, {"umaBond", "500"}, {"umaReward", "2"}, {"volume24hrClob", 3120.5},
+            {"volume1wkClob", 20110.2}, {"volume1moClob", 48211.21}, {"volume1yrClob", 48211.21},
+            {"volumeClob", 48211.21}, {"liquidityClob", 15234.55}, {"acceptingOrders", true},
+            {"negRisk", false}, {"ready", false}, {"funded", false},
+            {"acceptingOrdersTimestamp", "2025-12-18T09:20:11Z"}, {"cyom", false}, {"competitive", 0.93},
+            {"pagerDutyNotificationEnabled", false}, {"approved", true}, {"rewardsMinSize", 50},
+            {"rewardsMaxSpread", 3.5}, {"spread", 0.01}, {"umaResolutionStatuses", "[]"},
+            {"oneDayPriceChange", -0.015}, {"oneWeekPriceChange", 0.04}, {"oneMonthPriceChange", 0.11},
+            {"lastTradePrice", price}, {"bestBid", price - 0.005}, {"bestAsk", price + 0.005},
+            {"automaticallyActive", true}, {"clearBookOnStart", true}, {"manualActivation", false},
+            {"negRiskOther", false}, {"pendingDeployment", false}, {"deploying", false}, {"rfqEnabled", false},
+            {"events", {{{"id", std::to_string(90000 + m)}, {"ticker", slug}, {"slug", slug},
+                         {"title", "Home " + n + " vs. Away " + n}, {"active", true}, {"closed", false}}}},
+        });
+    }
+    return page.dump();
+}
+
+size_t outcomeCount(const std::vector<RawOddsGame>& games) {
+    size_t count = 0;
+    for (const auto& game : games) {
+        for (const auto& book : game.bookmakers) {
+            for (const auto& market : book.markets) {
+                count += market.outcomes.size();
+            }
+        }
+    }
+    return count;
+}
+
+std::string describe(const std::vector<RawOddsGame>& games) {
+    return std::to_string(games.size()) + " games, " + std::to_string(outcomeCount(games)) + " outcomes";
+}
+
+template <typename Market>
+std::string describe(const std::vector<Market>& markets) {
+    return std::to_string(markets.size()) + " markets";
+}
+
+template <typename Parse>
+void run(const std::string& label, const std::string& body, int iterations, Parse parse) {
+    typename std::invoke_result_t<Parse>::value_type results;
+    auto started = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        auto parsed = parse();
+        if (!parsed) {
+            std::cerr << label << ": parse failed" << std::endl;
+            return;
+        }
+        results = std::move(*parsed);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    double megabytes = static_cast<double>(body.size()) * iterations / 1e6;
+    std::cout << std::left << std::setw(24) << label << std::right << std::fixed << std::setprecision(1)
+              << std::setw(9) << megabytes / seconds << " MB/s" << std::setw(10) << seconds * 1000.0 / iterations
+              << " ms/response  " << describe(results) << std::endl;
+}
+
+bool readFile(const std::string& path, std::string& body) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Cannot read " << path << std::endl;
+        return false;
+    }
+    body.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string inputPath;
+    std::string gammaInputPath;
+    int games = 300;
+    int gammaMarkets = 500;
+    int bookmakers = 20;
+    int iterations = 20;
+    std::vector<std::string> keepBooks = {"book0", "book1", "book2"};
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--input" && hasValue) {
+                inputPath = argv[++i];
+            } else if (arg == "--games" && hasValue) {
+                games = std::stoi(argv[++i]);
+            } else if (arg == "--bookmakers" && hasValue) {
+                bookmakers = std::stoi(argv[++i]);
+            } else if (arg == "--gamma-input" && hasValue) {
+                gammaInputPath = argv[++i];
+            } else if (arg == "--gamma-markets" && hasValue) {
+                gammaMarkets = std::stoi(argv[++i]);
+            } else if (arg == "--iterations" && hasValue) {
+                iterations = std::max(1, std::stoi(argv[++i]));
+            } else if (arg == "--keep-books" && hasValue) {
+                keepBooks.clear();
+                std::stringstream list(argv[++i]);
+                for (std::string book; std::getline(list, book, ',');) {
+                    keepBooks.push_back(book);
+                }
+            } else if (arg == "--help" || arg == "-h") {
+                std::cout << "Usage: " << argv[0] << " [options]" << std::endl;
+                std::cout << "Options:" << std::endl;
+                std::cout << "  --input FILE          Parse a saved odds response instead of synthetic data" << std::endl;
+                std::cout << "  --games N             Synthetic games (default: 300)" << std::endl;
+                std::cout << "  --bookmakers N        Synthetic bookmakers per game (default: 20)" << std::endl;
+                std::cout << "  --gamma-input FILE    Parse a saved Gamma /markets page instead of synthetic data" << std::endl;
+                std::cout << "  --gamma-markets N     Synthetic markets per Gamma page (default: 500)" << std::endl;
+                std::cout << "  --iterations N        Parses per parser (default: 20)" << std::endl;
+                std::cout << "  --keep-books A,B      Bookmakers kept by the filtered run (default: book0,book1,book2)" << std::endl;
+                return 0;
+            } else {
+                std::cerr << "Unknown option: " << arg << std::endl;
+                return 1;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid option value: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::string body;
+    if (inputPath.empty()) {
+        body = syntheticResponse(games, bookmakers);
+    } else if (!readFile(inputPath, body)) {
+        return 1;
+    }
+    std::cout << "Odds response: " << body.size() << " bytes, " << iterations << " iterations" << std::endl;
+
+    OddsResponseParser unfiltered;
+    OddsResponseParser::Filter filter;
+    filter.bookmakers.insert(keepBooks.begin(), keepBooks.end());
+    filter.markets.insert("h2h");
+    OddsResponseParser filtered(filter);
+
+    run("dom + get<RawOddsGame>", body, iterations, [&]() { return OddsResponseParser::parseDom(body); });
+    run("sax", body, iterations, [&]() { return unfiltered.parse(body); });
+    run("sax, filtered", body, iterations, [&]() { return filtered.parse(body); });
+
+    std::string gammaPage;
+    if (gammaInputPath.empty()) {
+        gammaPage = syntheticGammaPage(gammaMarkets);
+    } else if (!readFile(gammaInputPath, gammaPage)) {
+        return 1;
+    }
+    std::cout << std::endl << "Gamma page: " << gammaPage.size() << " bytes, " << iterations << " iterations" << std::endl;
+
+    // What a slug lookup needs to price a market, without keeping the raw JSON
+    GammaProjection idsOnly({"id", "slug", "conditionId", "outcomes", "outcomePrices", "clobTokenIds"}, false);
+    run("dom + from_json", gammaPage, iterations, [&]() { return GammaMarketDecoder::decodePageDom(gammaPage); });
+    run("projected, all fields", gammaPage, iterations,
+        [&]() { return GammaMarketDecoder::decodePage(gammaPage, GammaProjection::all()); });
+    run("projected, matching", gammaPage, iterations,
+        [&]() { return GammaMarketDecoder::decodePage(gammaPage, GammaProjection::matching()); });
+    run("projected, pricing only", gammaPage, iterations,
+        [&]() { return GammaMarketDecoder::decodePage(gammaPage, idsOnly); });
+    return 0;
+}
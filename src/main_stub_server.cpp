@@ -0,0 +1,96 @@
+#include <iostream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <signal.h>
+
+#include "stub/stub_api_server.h"
+
+// Global flag for graceful shutdown
+volatile bool g_running = true;
+
+void signalHandler(int) {
+    g_running = false;
+}
+
+int main(int argc, char* argv[]) {
+    signal(SIGINT, signalHandler);
+    signal(SIGTERM, signalHandler);
+
+    polymarket_bot::stub::StubServerOptions options;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--host" && hasValue) {
+                options.host = argv[++i];
+            } else if (arg == "--port" && hasValue) {
+                options.port = std::stoi(argv[++i]);
+            } else if (arg == "--games" && hasValue) {
+                options.gamesPerSport = std::stoi(argv[++i]);
+            } else if (arg == "--filler-markets" && hasValue) {
+                options.fillerMarkets = std::stoi(argv[++i]);
+            } else if (arg == "--archive" && hasValue) {
+                options.archivePath = argv[++i];
+            } else if (arg == "--ws-frames" && hasValue) {
+                options.wsFramesPath = argv[++i];
+            } else if (arg == "--ws-interval-ms" && hasValue) {
+                options.wsIntervalMs = std::stoi(argv[++i]);
+            } else if (arg == "--latency-ms" && hasValue) {
+                options.latencyMs = std::stoi(argv[++i]);
+            } else if (arg == "--jitter-ms" && hasValue) {
+                options.jitterMs = std::stoi(argv[++i]);
+            } else if (arg == "--error-rate" && hasValue) {
+                options.errorRate = std::stod(argv[++i]);
+            } else if (arg == "--throttle-rate" && hasValue) {
+                options.throttleRate = std::stod(argv[++i]);
+            } else if (arg == "--max-rps" && hasValue) {
+                options.maxRequestsPerSecond = std::stoi(argv[++i]);
+            } else if (arg == "--retry-after" && hasValue) {
+                options.retryAfterSeconds = std::stoi(argv[++i]);
+            } else if (arg == "--odds-quota" && hasValue) {
+                options.oddsQuota = std::stoi(argv[++i]);
+            } else if (arg == "--help" || arg == "-h") {
+                std::cout << "Usage: " << argv[0] << " [options]" << std::endl;
+                std::cout << "Options:" << std::endl;
+                std::cout << "  --host ADDRESS        Listen address (default: 127.0.0.1)" << std::endl;
+                std::cout << "  --port PORT           Listen port (default: 8900)" << std::endl;
+                std::cout << "  --games N             Odds games per sport (default: 150)" << std::endl;
+                std::cout << "  --filler-markets N    Extra Gamma markets for paging (default: 2000)" << std::endl;
+                std::cout << "  --archive FILE        Serve responses recorded with --record first" << std::endl;
+                std::cout << "  --ws-frames FILE      Replay market channel frames recorded with --record-ws" << std::endl;
+                std::cout << "  --ws-interval-ms MS   Synthetic price change cadence on /ws/market (default: 1000)" << std::endl;
+                std::cout << "  --latency-ms MS       Latency added to every response" << std::endl;
+                std::cout << "  --jitter-ms MS        Uniform extra latency up to MS" << std::endl;
+                std::cout << "  --error-rate P        Fraction of requests answered with 500" << std::endl;
+                std::cout << "  --throttle-rate P     Fraction of requests answered with 429" << std::endl;
+                std::cout << "  --max-rps N           Answer 429 above N requests per second" << std::endl;
+                std::cout << "  --retry-after SECONDS Retry-After sent with 429 (default: 1)" << std::endl;
+                std::cout << "  --odds-quota N        Starting x-requests-remaining (default: 20000)" << std::endl;
+                std::cout << "  -h, --help            Show this help message" << std::endl;
+                return 0;
+            } else {
+                std::cerr << "Unknown option: " << arg << " (see --help)" << std::endl;
+                return 1;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid option value: " << e.what() << std::endl;
+        return 1;
+    }
+
+    polymarket_bot::stub::StubApiServer server(options);
+    if (!server.start()) {
+        return 1;
+    }
+    std::cout << "Point config/config_loadtest.json at this server. Press Ctrl+C to stop" << std::endl;
+
+    while (g_running) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+
+    server.stop();
+    server.logStats();
+    return 0;
+}
@@ -1,13 +1,25 @@
+#include <algorithm>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <chrono>
 #include <signal.h>
 
 #include "api/odds_api_client.h"
 #include "api/polymarket_api_client.h"
+#include "api/rate_limiter.h"
+#include "api/http_transport.h"
+#include "api/http_response_cache.h"
+#include "api/transport_backend.h"
+#include "api/deadline.h"
+#include "api/connection_warmer.h"
+#include "api/clob_market_feed.h"
+#include "common/string_interner.h"
+#include "common/thread_pool.h"
 #include "config/config_manager.h"
 #include "market/market_matcher.h"
+#include "market/scan_scheduler.h"
 #include "trading/trade_executor.h"
 #include "trading/trade_manager.h"
 #include "cli/trade_dashboard.h"
@@ -44,6 +56,12 @@ int main(int argc, char* argv[]) {
             "config/config_test.json",
             "config/config.json"
         };
+        // --config is read before everything else so the clients are built against it
+        for (int i = 1; i + 1 < argc; ++i) {
+            if (std::string(argv[i]) == "--config") {
+                configPaths = {argv[i + 1]};
+            }
+        }
         
         bool configLoaded = false;
         for (const auto& path : configPaths) {
@@ -64,6 +82,10 @@ int main(int argc, char* argv[]) {
             return 1;
         }
         
+        // One pool for every subsystem, sized before anything starts using it
+        polymarket_bot::common::ThreadPool::configure(
+            {static_cast<size_t>(configManager.getThreadPoolSize()), configManager.isThreadPoolPinned()});
+        
         // Initialize API clients
         std::cout << "Initializing API clients..." << std::endl;
         
@@ -72,7 +94,10 @@ int main(int argc, char* argv[]) {
             std::cerr << "Odds API client is not healthy" << std::endl;
             return 1;
         }
-        oddsClient.setRateLimit(10);
+        // Per-host request budgets for the Odds, CLOB, Gamma and Data APIs, and per-request timeouts
+        polymarket_bot::api::RateLimiterRegistry::getInstance().configureFromConfig(configManager);
+        polymarket_bot::api::HttpTransport::getInstance().setTimeouts(configManager.getConnectTimeoutMs(),
+                                                                      configManager.getRequestTimeoutMs());
         
         auto polyClient = std::make_shared<polymarket_bot::api::PolymarketApiClient>(
             configManager.getPolymarketBaseUrl(),
@@ -109,6 +134,7 @@ int main(int argc, char* argv[]) {
         
         // Create market matcher
         MarketMatcher matcher(*polyClient, oddsClient, configManager);
+        std::shared_ptr<polymarket_bot::api::ClobMarketFeed> marketFeed;
         
         // Create dashboard
         auto dashboard = std::make_unique<polymarket_bot::cli::TradeDashboard>(
@@ -124,6 +150,11 @@ int main(int argc, char* argv[]) {
         bool interactiveMode = false;
         bool dryRun = false;
         int scanInterval = 300; // 5 minutes default
+        int scanBudgetMs = configManager.getScanBudgetMs();
+        std::string recordPath;
+        std::string replayPath;
+        std::string recordWsPath;
+        bool replayRealTime = false;
         
         for (int i = 1; i < argc; ++i) {
             std::string arg = argv[i];
@@ -133,17 +164,65 @@ int main(int argc, char* argv[]) {
                 dryRun = true;
             } else if (arg == "--interval" && i + 1 < argc) {
                 scanInterval = std::stoi(argv[++i]);
+            } else if (arg == "--scan-budget" && i + 1 < argc) {
+                scanBudgetMs = std::stoi(argv[++i]);
+            } else if (arg == "--config" && i + 1 < argc) {
+                ++i; // Already applied before the config was loaded
+            } else if (arg == "--record" && i + 1 < argc) {
+                recordPath = argv[++i];
+            } else if (arg == "--replay" && i + 1 < argc) {
+                replayPath = argv[++i];
+            } else if (arg == "--record-ws" && i + 1 < argc) {
+                recordWsPath = argv[++i];
+            } else if (arg == "--replay-realtime") {
+                replayRealTime = true;
             } else if (arg == "--help" || arg == "-h") {
                 std::cout << "Usage: " << argv[0] << " [options]" << std::endl;
                 std::cout << "Options:" << std::endl;
                 std::cout << "  -i, --interactive    Run in interactive mode" << std::endl;
                 std::cout << "  -d, --dry-run       Scan for opportunities but don't execute trades" << std::endl;
-                std::cout << "  --interval SECONDS  Set scan interval (default: 300)" << std::endl;
+                std::cout << "  --interval SECONDS  Base scan interval; caps the scheduled poll rate (default: 300)" << std::endl;
+                std::cout << "  --scan-budget MS    Latency budget per scan, 0 for none (default: from config)" << std::endl;
+                std::cout << "  --config FILE       Load configuration from FILE" << std::endl;
+                std::cout << "  --record FILE       Record every API exchange to FILE" << std::endl;
+                std::cout << "  --replay FILE       Serve API calls from a recorded FILE (no network)" << std::endl;
+                std::cout << "  --replay-realtime   Replay with the recorded latencies" << std::endl;
+                std::cout << "  --record-ws FILE    Record CLOB market channel frames to FILE (stub --ws-frames)" << std::endl;
                 std::cout << "  -h, --help          Show this help message" << std::endl;
                 return 0;
             }
         }
         
+        if (!replayPath.empty()) {
+            auto replay = std::make_shared<polymarket_bot::api::ReplayBackend>(replayPath, replayRealTime);
+            if (!replay->isLoaded()) {
+                return 1;
+            }
+            polymarket_bot::api::HttpTransport::getInstance().setBackend(replay);
+            std::cout << "Replaying API traffic from " << replayPath << std::endl;
+        } else if (!recordPath.empty()) {
+            auto recorder = std::make_shared<polymarket_bot::api::RecordingBackend>(
+                std::make_shared<polymarket_bot::api::CurlBackend>(), recordPath);
+            if (!recorder->isOpen()) {
+                return 1;
+            }
+            polymarket_bot::api::HttpTransport::getInstance().setBackend(recorder);
+            std::cout << "Recording API traffic to " << recordPath << std::endl;
+        }
+        
+        // Live quotes for matched markets; a replayed session stays on recorded prices
+        std::string marketWsUrl = configManager.getPolymarketMarketWsUrl();
+        if (replayPath.empty() && !marketWsUrl.empty()) {
+            auto feed = std::make_shared<polymarket_bot::api::ClobMarketFeed>(marketWsUrl);
+            if (!recordWsPath.empty() && feed->recordTo(recordWsPath)) {
+                std::cout << "Recording market channel frames to " << recordWsPath << std::endl;
+            }
+            if (feed->start()) {
+                marketFeed = feed;
+                matcher.setMarketFeed(marketFeed);
+            }
+        }
+        
         if (dryRun) {
             std::cout << "Running in DRY RUN mode - no trades will be executed" << std::endl;
         }
@@ -154,67 +233,179 @@ int main(int argc, char* argv[]) {
         } else {
             // Automated trading loop
             std::cout << "Starting automated trading loop..." << std::endl;
-            std::cout << "Scan interval: " << scanInterval << " seconds" << std::endl;
+            std::cout << "Base scan interval: " << scanInterval << " seconds" << std::endl;
             std::cout << "Press Ctrl+C to stop" << std::endl;
             
+            // Connections are opened shortly before each scan so it starts without DNS or TLS setup
+            int warmupLead = std::min(configManager.getWarmupLeadSeconds(), scanInterval);
+            polymarket_bot::api::ConnectionWarmer warmer({
+                configManager.getOddsApiBaseUrl(),
+                configManager.getPolymarketBaseUrl(),
+                configManager.getPolymarketGammaBaseUrl(),
+                configManager.getPolymarketDataBaseUrl()
+            }, static_cast<size_t>(configManager.getWarmupConnectionsPerHost()));
+            
+            // Display opportunities and execute them unless this is a dry run.
+            // The pipelined scan calls this from its execute stage, so calls are serialized
+            std::mutex tradingMutex;
+            auto handleOpportunities = [&](const std::vector<ArbitrageOpportunity>& opportunities) {
+                std::lock_guard<std::mutex> lock(tradingMutex);
+                dashboard->displayOpportunities(opportunities);
+                
+                if (dryRun) {
+                    std::cout << "DRY RUN: Would have attempted to execute " 
+                             << opportunities.size() << " trades" << std::endl;
+                    return;
+                }
+                
+                std::cout << "Executing trades..." << std::endl;
+                auto results = tradeManager->executeOpportunities(opportunities);
+                
+                int successful = 0;
+                int blocked = 0;
+                int failed = 0;
+                
+                for (const auto& result : results) {
+                    if (result.success) {
+                        successful++;
+                        std::cout << "✓ Trade executed: " << result.tradeId 
+                                 << " (Stake: $" << result.executedStake << ")" << std::endl;
+                    } else if (result.status == "BLOCKED") {
+                        blocked++;
+                    } else {
+                        failed++;
+                        std::cout << "✗ Trade failed: " << result.errorMessage << std::endl;
+                    }
+                }
+                
+                std::cout << "Execution summary: " << successful << " successful, " 
+                         << blocked << " blocked, " << failed << " failed" << std::endl;
+            };
+            
+            // Between scans, markets whose live quotes moved are re-priced straight away
+            auto checkLivePrices = [&]() {
+                if (!marketFeed) {
+                    return;
+                }
+                try {
+                    auto moved = matcher.reevaluateChanged(0.02);
+                    if (!moved.empty()) {
+                        std::cout << "Found " << moved.size() << " opportunities after live price changes" << std::endl;
+                        handleOpportunities(moved);
+                    }
+                } catch (const std::exception& e) {
+                    std::cerr << "Error re-evaluating live prices: " << e.what() << std::endl;
+                }
+            };
+            
+            // Games are re-priced on their own schedule by time to commence; a full listing runs every discovery interval
+            ScanScheduler scheduler(configManager.getPollBuckets(), std::chrono::seconds(scanInterval),
+                                    std::chrono::seconds(configManager.getDiscoveryIntervalSeconds()));
+            // Connections idle for less than this are still open, so short gaps skip the warm-up
+            const auto warmupMinGap = std::chrono::seconds(60);
+            
             int loopCount = 0;
             while (g_running) {
                 loopCount++;
-                std::cout << "\n--- Scan #" << loopCount << " ---" << std::endl;
+                bool discovery = scheduler.discoveryDue(ScanScheduler::Clock::now());
+                std::cout << "\n--- Scan #" << loopCount << (discovery ? " (discovery)" : "") << " ---" << std::endl;
+                polymarket_bot::api::ScanBudget budget{std::chrono::milliseconds(scanBudgetMs)};
                 
                 try {
-                    // Load market data
-                    std::cout << "Loading market data..." << std::endl;
-                    matcher.loadAll();
-                    
-                    // Find arbitrage opportunities
-                    std::cout << "Scanning for arbitrage opportunities..." << std::endl;
-                    auto opportunities = matcher.findArbitrageOpportunities(0.02); // 2% minimum edge
-                    
-                    std::cout << "Found " << opportunities.size() << " potential opportunities" << std::endl;
-                    
-                    if (!opportunities.empty()) {
-                        // Display opportunities
-                        dashboard->displayOpportunities(opportunities);
+                    std::vector<ArbitrageOpportunity> opportunities;
+                    bool pipelined = discovery && configManager.isPipelinedScan();
+                    if (pipelined) {
+                        // Orders go out from inside the pipeline, so no stage deadline is installed;
+                        // the pipeline itself stops taking on new games once the scan budget runs out
+                        auto stage = budget.unbounded("pipelined scan");
+                        std::cout << "Scanning for arbitrage opportunities..." << std::endl;
+                        size_t found = 0;
+                        matcher.scanPipelined(0.02, budget.deadline(), [&](const ArbitrageOpportunity& opportunity) {
+                            found++;
+                            handleOpportunities({opportunity});
+                        });
+                        std::cout << "Found and handled " << found << " opportunities" << std::endl;
+                    } else if (discovery) {
+                        {
+                            // Market data gets at most half the budget so matching always has time left
+                            auto stage = budget.stage("load market data", 0.5);
+                            std::cout << "Loading market data..." << std::endl;
+                            matcher.loadAll();
+                        }
                         
-                        if (!dryRun) {
-                            // Execute profitable opportunities
-                            std::cout << "Executing trades..." << std::endl;
-                            auto results = tradeManager->executeOpportunities(opportunities);
-                            
-                            int successful = 0;
-                            int blocked = 0;
-                            int failed = 0;
-                            
-                            for (const auto& result : results) {
-                                if (result.success) {
-                                    successful++;
-                                    std::cout << "✓ Trade executed: " << result.tradeId 
-                                             << " (Stake: $" << result.executedStake << ")" << std::endl;
-                                } else if (result.status == "BLOCKED") {
-                                    blocked++;
-                                } else {
-                                    failed++;
-                                    std::cout << "✗ Trade failed: " << result.errorMessage << std::endl;
-                                }
+                        // Find arbitrage opportunities
+                        {
+                            auto stage = budget.stage("match markets");
+                            std::cout << "Scanning for arbitrage opportunities..." << std::endl;
+                            opportunities = matcher.findArbitrageOpportunities(0.02); // 2% minimum edge
+                        }
+                    }
+                    if (discovery) {
+                        auto polledAt = ScanScheduler::Clock::now();
+                        std::vector<std::string> polled;
+                        for (const auto& game : matcher.getOddsGames()) {
+                            polled.push_back(game.id);
+                        }
+                        scheduler.updateGames(matcher.getOddsGames(), polledAt);
+                        scheduler.markPolled(polled, polledAt);
+                        scheduler.markDiscovered(polledAt);
+                    } else {
+                        auto due = scheduler.takeDue(ScanScheduler::Clock::now());
+                        std::vector<std::string> dueIds;
+                        for (const auto& sport : due) {
+                            dueIds.insert(dueIds.end(), sport.second.begin(), sport.second.end());
+                        }
+                        if (!dueIds.empty()) {
+                            {
+                                auto stage = budget.stage("load market data", 0.5);
+                                std::cout << "Refreshing odds for " << dueIds.size() << " due games..." << std::endl;
+                                matcher.refreshGames(due);
+                            }
+                            {
+                                auto stage = budget.stage("match markets");
+                                opportunities = matcher.findOpportunitiesForGames(dueIds, 0.02);
                             }
-                            
-                            std::cout << "Execution summary: " << successful << " successful, " 
-                                     << blocked << " blocked, " << failed << " failed" << std::endl;
-                        } else {
-                            std::cout << "DRY RUN: Would have attempted to execute " 
-                                     << opportunities.size() << " trades" << std::endl;
                         }
                     }
                     
+                    if (!pipelined) {
+                        std::cout << "Found " << opportunities.size() << " potential opportunities" << std::endl;
+                    }
                     
+                    if (!opportunities.empty()) {
+                        // Orders are never cut off mid-request; they only get the per-request timeout
+                        auto stage = budget.unbounded("execute trades");
+                        handleOpportunities(opportunities);
+                    }
+                    
+                    budget.logReport();
+                    scheduler.logReport(ScanScheduler::Clock::now());
+                    polymarket_bot::api::HttpTransport::getInstance().logEndpointStats();
+                    polymarket_bot::api::HttpResponseCache::getInstance().logStats();
+                    polymarket_bot::common::ThreadPool::getInstance().logStats();
+                    polymarket_bot::common::StringInterner::getInstance().logStats();
+                    if (marketFeed) {
+                        marketFeed->logStats();
+                    }
                 } catch (const std::exception& e) {
                     std::cerr << "Error in trading loop: " << e.what() << std::endl;
                 }
                 
-                // Wait for next scan
-                for (int i = 0; i < scanInterval && g_running; ++i) {
-                    std::this_thread::sleep_for(std::chrono::seconds(1));
+                // Wait for the next due game or discovery scan, warming connections first after a long gap
+                auto wakeAt = std::min(scheduler.nextDue(), scheduler.nextDiscovery());
+                bool warm = warmupLead > 0 && wakeAt - ScanScheduler::Clock::now() > warmupMinGap;
+                auto warmAt = warm ? wakeAt - std::chrono::seconds(warmupLead) : wakeAt;
+                for (auto now = ScanScheduler::Clock::now(); now < warmAt && g_running; now = ScanScheduler::Clock::now()) {
+                    std::this_thread::sleep_for(std::min<ScanScheduler::Clock::duration>(warmAt - now, std::chrono::seconds(1)));
+                    checkLivePrices();
+                }
+                if (warm && g_running) {
+                    auto scanStart = polymarket_bot::api::Deadline::in(
+                        std::chrono::duration_cast<std::chrono::milliseconds>(wakeAt - ScanScheduler::Clock::now()));
+                    warmer.logResult(warmer.warm(scanStart));
+                    while (g_running && !scanStart.expired()) {
+                        std::this_thread::sleep_for(std::min<std::chrono::milliseconds>(scanStart.remaining(), std::chrono::seconds(1)));
+                    }
                 }
             }
         }
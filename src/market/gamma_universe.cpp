@@ -0,0 +1,163 @@
+#include "market/gamma_universe.h"
+
+#include <algorithm>
+#include <iostream>
+#include <future>
+
+#include "api/async_http_engine.h"
+#include "api/gamma_market_decoder.h"
+#include "api/http_response_cache.h"
+#include "api/polymarket_api_client.h"
+
+GammaUniverse::GammaUniverse(std::string gammaBaseUrl, std::vector<std::string> slugPrefixes,
+                             std::vector<int> tagIds)
+    : gammaBaseUrl(std::move(gammaBaseUrl)), slugPrefixes(std::move(slugPrefixes)), tagIds(std::move(tagIds)),
+      loaded(false)
+{
+}
+
+bool GammaUniverse::keepMarket(const polymarket_bot::common::GammaMarket& market) const
+{
+    if (!market.slug) {
+        return false;
+    }
+    if (slugPrefixes.empty()) {
+        return true;
+    }
+    for (const auto& prefix : slugPrefixes) {
+        if (market.slug->rfind(prefix, 0) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool GammaUniverse::refresh(int concurrentPages, int pageSize, int maxPages, const polymarket_bot::api::Deadline& deadline)
+{
+    auto start = std::chrono::steady_clock::now();
+    auto& engine = polymarket_bot::api::AsyncHttpEngine::getInstance();
+    auto& cache = polymarket_bot::api::HttpResponseCache::getInstance();
+
+    // One listing per tag (or the whole listing), paged side by side and sharing the page budget per wave
+    struct Listing {
+        int tagId;
+        int nextPage = 0;
+        bool lastPageSeen = false;
+    };
+    std::vector<Listing> listings;
+    for (int tagId : tagIds.empty() ? std::vector<int>{0} : tagIds) {
+        listings.push_back({tagId});
+    }
+    int pagesPerListing = std::max(1, (std::max(1, concurrentPages) + static_cast<int>(listings.size()) - 1) /
+                                          static_cast<int>(listings.size()));
+
+    MarketStore fresh;
+    int pagesFetched = 0;
+
+    // The listings have no total count, so pages go out in waves until each one comes back short
+    for (;;) {
+        struct PendingPage {
+            Listing* listing;
+            int page;
+            std::string url;
+            std::future<polymarket_bot::api::HttpResponse> response;
+        };
+        std::vector<PendingPage> pages;
+        for (auto& listing : listings) {
+            int wave = std::min(pagesPerListing, maxPages - listing.nextPage);
+            for (int p = 0; !listing.lastPageSeen && p < wave; ++p) {
+                polymarket_bot::api::HttpRequest request;
+                request.url = gammaBaseUrl + polymarket_bot::api::PolymarketApiClient::gammaMarketsEndpoint(
+                                                 (listing.nextPage + p) * pageSize, pageSize, listing.tagId);
+                request.deadline = deadline;
+                cache.addValidators(request);
+                std::string url = request.url;
+                pages.push_back({&listing, listing.nextPage + p, std::move(url), engine.submit(std::move(request))});
+            }
+            listing.nextPage += std::max(0, wave);
+        }
+        if (pages.empty()) {
+            break;
+        }
+
+        bool failed = false;
+        for (auto& pending : pages) {
+            auto response = pending.response.get();
+            if (failed || pending.listing->lastPageSeen) {
+                continue;
+            }
+            if (!response.ok() || (response.statusCode != 200 && response.statusCode != 304)) {
+                std::cerr << "[GammaUniverse] Page request failed: "
+                          << (response.error.empty() ? "HTTP " + std::to_string(response.statusCode) : response.error)
+                          << std::endl;
+                failed = true;
+                continue;
+            }
+
+            // Only the page body is cached. Keeping the decoded markets as well would hold every market a third
+            // time next to that body and the store's cold copy, so an unchanged page (304) is decoded again
+            std::optional<std::string> unchanged = cache.notModifiedBody(pending.url, response);
+            if (response.statusCode == 304 && !unchanged) {
+                std::cerr << "[GammaUniverse] Page " << pending.page << " returned no data" << std::endl;
+                failed = true;
+                continue;
+            }
+            auto page = polymarket_bot::api::GammaMarketDecoder::decodePage(
+                unchanged ? *unchanged : response.body, polymarket_bot::api::GammaProjection::matching());
+            if (!page) {
+                std::cerr << "[GammaUniverse] Page " << pending.page
+                          << ": unexpected Gamma markets response structure - expected array" << std::endl;
+                failed = true;
+                continue;
+            }
+            // The store takes the kept markets' JSON as its cold rows; the rest is freed with the page
+            for (const auto& market : *page) {
+                if (keepMarket(market.market)) {
+                    fresh.add(market);
+                }
+            }
+            pagesFetched++;
+            if (static_cast<int>(page->size()) < pageSize) {
+                pending.listing->lastPageSeen = true;
+            }
+        }
+
+        if (failed) {
+            std::cerr << "[GammaUniverse] Refresh aborted, keeping previous snapshot ("
+                      << store.size() << " markets)" << std::endl;
+            return false;
+        }
+    }
+
+    for (const auto& listing : listings) {
+        if (!listing.lastPageSeen) {
+            std::cout << "[GammaUniverse] Warning: stopped after " << maxPages << " pages";
+            if (listing.tagId > 0) {
+                std::cout << " of tag " << listing.tagId;
+            }
+            std::cout << ", snapshot may be incomplete" << std::endl;
+        }
+    }
+
+    store = std::move(fresh);
+    size_t unusable = std::count_if(store.records().begin(), store.records().end(), [](const MarketRecord& record) {
+        return record.outcomeError != polymarket_bot::api::OutcomeError::None;
+    });
+    loaded = true;
+    lastRefresh = std::chrono::steady_clock::now();
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(lastRefresh - start).count();
+    std::cout << "[GammaUniverse] Loaded " << store.size() << " markets from " << pagesFetched
+              << " pages in " << elapsed << " ms";
+    if (unusable > 0) {
+        std::cout << " (" << unusable << " with unusable outcomes)";
+    }
+    std::cout << std::endl;
+    return true;
+}
+
+std::optional<polymarket_bot::common::GammaMarket> GammaUniverse::fullBySlug(const std::string& slug) const
+{
+    const auto* record = store.findBySlug(slug);
+    return record ? store.coldFields(*record) : std::nullopt;
+}
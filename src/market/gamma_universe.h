@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "api/deadline.h"
+#include "market/market_store.h"
+
+// In-memory snapshot of the active Gamma market universe.
+//
+// refresh() pages the Gamma /markets listing several pages at a time through
+// the async HTTP engine into a MarketStore indexed by slug, condition id and
+// CLOB token id, so slug matching becomes a hash lookup instead of one HTTP
+// probe per candidate slug. With tag ids set, one listing per tag is paged
+// (the server filters to those sports) instead of every active market. Pages are decoded to the fields the matcher reads
+// (GammaProjection::matching()) and kept as compact MarketRecords;
+// fullBySlug() decodes the rest on demand. Lookups return pointers into the
+// snapshot that stay valid until the next refresh(). Nothing is locked:
+// refresh() must not run while another thread reads the snapshot.
+class GammaUniverse
+{
+public:
+    explicit GammaUniverse(std::string gammaBaseUrl,
+                           std::vector<std::string> slugPrefixes = {},
+                           std::vector<int> tagIds = {});
+
+    // Re-download the universe; returns false (and keeps the old snapshot) if any page failed.
+    // Each wave sends about concurrentPages pages across the listings; maxPages applies to each listing.
+    // Page requests are cut off at `deadline`, which fails the refresh.
+    bool refresh(int concurrentPages = 5, int pageSize = 500, int maxPages = 200,
+                 const polymarket_bot::api::Deadline& deadline = polymarket_bot::api::Deadline::never());
+
+    const MarketRecord* findBySlug(const std::string& slug) const { return store.findBySlug(slug); }
+    const MarketRecord* findByConditionId(const std::string& conditionId) const { return store.findByConditionId(conditionId); }
+    const MarketRecord* findByTokenId(const std::string& tokenId) const { return store.findByTokenId(tokenId); }
+
+    // Every field of the market, not just the projected ones
+    std::optional<polymarket_bot::common::GammaMarket> fullBySlug(const std::string& slug) const;
+
+    bool isLoaded() const { return loaded; }
+    size_t size() const { return store.size(); }
+    std::chrono::steady_clock::time_point loadedAt() const { return lastRefresh; }
+
+private:
+    bool keepMarket(const polymarket_bot::common::GammaMarket& market) const;
+
+    std::string gammaBaseUrl;
+    std::vector<std::string> slugPrefixes;  // Only markets whose slug starts with one of these are kept (all if empty)
+    std::vector<int> tagIds;                // Gamma tags to list, one listing each (the whole listing if empty)
+
+    MarketStore store;
+
+    bool loaded;
+    std::chrono::steady_clock::time_point lastRefresh;
+};
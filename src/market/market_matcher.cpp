@@ -7,19 +7,22 @@
 #include <algorithm>
 #include <limits>
 #include <mutex>
-#include <curl/curl.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <condition_variable>
+#include <deque>
+#include <future>
 #include "market/market_matcher.h"
+#include "api/http_transport.h"
+#include "api/async_http_engine.h"
+#include "api/gamma_market_decoder.h"
+#include "api/http_response_cache.h"
+#include "common/pipeline.h"
 #include "nlohmann/json.hpp"
 
 using json = nlohmann::json;
 
-// Helper for libcurl to accumulate response
-size_t MarketMatcher::writeCallback(void *contents, size_t size, size_t nmemb, void *userp)
-{
-    ((std::string *)userp)->append((char *)contents, size * nmemb);
-    return size * nmemb;
-}
-
 // Extract YYYY-MM-DD from ISO timestamp
 std::string MarketMatcher::dateOnly(const std::string &iso)
 {
@@ -81,37 +84,46 @@ std::string MarketMatcher::slugToQuestion(const std::string &slug)
     return "will " + normalized + " happen?";
 }
 
-// Fetch single embedding
-std::vector<double> MarketMatcher::getEmbedding(const std::string &text)
+// Build an OpenAI embeddings request for a single text or a batch
+polymarket_bot::api::HttpRequest MarketMatcher::buildEmbeddingRequest(const nlohmann::json &input)
 {
-    std::cout << "[Embedding] Starting embedding request for text: "
-              << (text.size() > 50 ? text.substr(0, 50) + "..." : text) << std::endl;
     const char *api_key = std::getenv("OPENAI_API_KEY");
     if (!api_key)
         throw std::runtime_error("OPENAI_API_KEY not set");
-    CURL *curl = curl_easy_init();
-    if (!curl)
-        throw std::runtime_error("Failed to init curl");
-    std::string readBuffer;
-    curl_easy_setopt(curl, CURLOPT_URL, "https://api.openai.com/v1/embeddings");
-    curl_easy_setopt(curl, CURLOPT_POST, 1L);
-    json body = {{"model", "text-embedding-ada-002"}, {"input", text}};
-    std::string bodyStr = body.dump();
-    struct curl_slist *headers = nullptr;
-    headers = curl_slist_append(headers, ("Authorization: Bearer " + std::string(api_key)).c_str());
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, bodyStr.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
-    CURLcode res = curl_easy_perform(curl);
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
-    if (res != CURLE_OK)
+    polymarket_bot::api::HttpRequest request;
+    request.method = "POST";
+    request.url = "https://api.openai.com/v1/embeddings";
+    json body = {{"model", "text-embedding-ada-002"}, {"input", input}};
+    request.body = body.dump();
+    request.headers = {"Authorization: Bearer " + std::string(api_key), "Content-Type: application/json"};
+    return request;
+}
+
+// Extract embeddings from an OpenAI embeddings response
+std::vector<std::vector<double>> MarketMatcher::parseEmbeddingResponse(const polymarket_bot::api::HttpResponse &response)
+{
+    if (!response.ok())
         throw std::runtime_error("curl_easy_perform() failed");
-    auto resp = json::parse(readBuffer);
-    auto arr = resp["data"][0]["embedding"];
-    return {arr.begin(), arr.end()};
+    auto resp = json::parse(response.body);
+    std::vector<std::vector<double>> embs;
+    for (auto &item : resp["data"])
+    {
+        auto arr = item["embedding"];
+        embs.emplace_back(arr.begin(), arr.end());
+    }
+    return embs;
+}
+
+// Fetch single embedding
+std::vector<double> MarketMatcher::getEmbedding(const std::string &text)
+{
+    std::cout << "[Embedding] Starting embedding request for text: "
+              << (text.size() > 50 ? text.substr(0, 50) + "..." : text) << std::endl;
+    auto response = polymarket_bot::api::HttpTransport::getInstance().perform(buildEmbeddingRequest(text));
+    auto embs = parseEmbeddingResponse(response);
+    if (embs.empty())
+        throw std::runtime_error("Embedding response contained no data");
+    return embs.front();
 }
 
 // Fetch embedding with logging (thread-safe)
@@ -126,20 +138,26 @@ std::vector<double> MarketMatcher::getEmbeddingWithLogging(const std::string &te
     return getEmbedding(text);
 }
 
-// Batch embeddings
+// Batch embeddings - every batch is submitted at once and collected in order
 std::vector<std::vector<double>> MarketMatcher::getBatchEmbeddings(const std::vector<std::string> &texts)
 {
     if (texts.empty())
         return {};
     constexpr size_t MAX_BATCH = 100;
-    std::vector<std::vector<double>> all;
+    std::vector<std::future<polymarket_bot::api::HttpResponse>> batches;
     for (size_t i = 0; i < texts.size(); i += MAX_BATCH)
     {
         auto begin = texts.begin() + i;
         auto end = (i + MAX_BATCH < texts.size() ? begin + MAX_BATCH : texts.end());
         std::vector<std::string> batch(begin, end);
-        auto sub = getBatchEmbeddingsSingle(batch);
-        all.insert(all.end(), sub.begin(), sub.end());
+        batches.push_back(polymarket_bot::api::AsyncHttpEngine::getInstance().submit(buildEmbeddingRequest(batch)));
+    }
+    std::vector<std::vector<double>> all;
+    all.reserve(texts.size());
+    for (auto &batch : batches)
+    {
+        auto sub = parseEmbeddingResponse(batch.get());
+        all.insert(all.end(), std::make_move_iterator(sub.begin()), std::make_move_iterator(sub.end()));
     }
     return all;
 }
@@ -147,37 +165,8 @@ std::vector<std::vector<double>> MarketMatcher::getBatchEmbeddings(const std::ve
 // Single batch call
 std::vector<std::vector<double>> MarketMatcher::getBatchEmbeddingsSingle(const std::vector<std::string> &texts)
 {
-    const char *api_key = std::getenv("OPENAI_API_KEY");
-    if (!api_key)
-        throw std::runtime_error("OPENAI_API_KEY not set");
-    CURL *curl = curl_easy_init();
-    if (!curl)
-        throw std::runtime_error("Failed to init curl");
-    std::string readBuffer;
-    curl_easy_setopt(curl, CURLOPT_URL, "https://api.openai.com/v1/embeddings");
-    curl_easy_setopt(curl, CURLOPT_POST, 1L);
-    json body = {{"model", "text-embedding-ada-002"}, {"input", texts}};
-    std::string bodyStr = body.dump();
-    struct curl_slist *headers = nullptr;
-    headers = curl_slist_append(headers, ("Authorization: Bearer " + std::string(api_key)).c_str());
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, bodyStr.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
-    CURLcode res = curl_easy_perform(curl);
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
-    if (res != CURLE_OK)
-        throw std::runtime_error("curl_easy_perform() failed");
-    auto resp = json::parse(readBuffer);
-    std::vector<std::vector<double>> embs;
-    for (auto &item : resp["data"])
-    {
-        auto arr = item["embedding"];
-        embs.emplace_back(arr.begin(), arr.end());
-    }
-    return embs;
+    auto response = polymarket_bot::api::HttpTransport::getInstance().perform(buildEmbeddingRequest(texts));
+    return parseEmbeddingResponse(response);
 }
 
 // Cosine similarity
@@ -198,7 +187,10 @@ double MarketMatcher::cosineSimilarity(const std::vector<double> &A,
 MarketMatcher::MarketMatcher(polymarket_bot::api::PolymarketApiClient polyClient,
                              polymarket_bot::api::OddsApiClient oddsClient,
                              const polymarket_bot::config::ConfigManager &configManager)
-    : polyClient(polyClient), oddsClient(oddsClient), configManager(configManager), maxConcurrentRequests(5)
+    : polyClient(polyClient), oddsClient(oddsClient), configManager(configManager),
+      gammaUniverse(this->polyClient.getGammaBaseUrl(), {"nba-", "nhl-", "mlb-"}, configManager.getGammaTagIds()),
+      slugCache(std::chrono::seconds(configManager.getNegativeCacheTtl())),
+      maxConcurrentRequests(configManager.getMaxConcurrentRequests())
 {
     initializeTeamMappings();
 }
@@ -206,113 +198,118 @@ MarketMatcher::MarketMatcher(polymarket_bot::api::PolymarketApiClient polyClient
 
 void MarketMatcher::loadAll()
 {
-    // Only load odds games - we'll fetch Polymarket markets individually by slug
     oddsGames = oddsClient.fetchOdds(configManager.getSports());
     std::cout << "Loaded " << oddsGames.size() << " odds games\n";
+    
+    // Snapshot mode pages the Gamma universe once; otherwise markets are fetched individually by slug
+    if (configManager.useGammaSnapshot() && !oddsGames.empty()) {
+        gammaUniverse.refresh(maxConcurrentRequests);
+    }
 }
 
 // Initialize team mappings for NBA, NHL, and MLB
 void MarketMatcher::initializeTeamMappings()
 {
+    auto& interner = polymarket_bot::common::StringInterner::getInstance();
     // NBA Teams
-    nbaTeams["Atlanta Hawks"] = {"Atlanta Hawks", "atl", "Atlanta Hawks"};
-    nbaTeams["Boston Celtics"] = {"Boston Celtics", "bos", "Boston Celtics"};
-    nbaTeams["Brooklyn Nets"] = {"Brooklyn Nets", "bkn", "Brooklyn Nets"};
-    nbaTeams["Charlotte Hornets"] = {"Charlotte Hornets", "cha", "Charlotte Hornets"};
-    nbaTeams["Chicago Bulls"] = {"Chicago Bulls", "chi", "Chicago Bulls"};
-    nbaTeams["Cleveland Cavaliers"] = {"Cleveland Cavaliers", "cle", "Cleveland Cavaliers"};
-    nbaTeams["Dallas Mavericks"] = {"Dallas Mavericks", "dal", "Dallas Mavericks"};
-    nbaTeams["Denver Nuggets"] = {"Denver Nuggets", "den", "Denver Nuggets"};
-    nbaTeams["Detroit Pistons"] = {"Detroit Pistons", "det", "Detroit Pistons"};
-    nbaTeams["Golden State Warriors"] = {"Golden State Warriors", "gsw", "Golden State Warriors"};
-    nbaTeams["Houston Rockets"] = {"Houston Rockets", "hou", "Houston Rockets"};
-    nbaTeams["Indiana Pacers"] = {"Indiana Pacers", "ind", "Indiana Pacers"};
-    nbaTeams["LA Clippers"] = {"LA Clippers", "lac", "LA Clippers"};
-    nbaTeams["Los Angeles Clippers"] = {"Los Angeles Clippers", "lac", "Los Angeles Clippers"};
-    nbaTeams["LA Lakers"] = {"LA Lakers", "lal", "LA Lakers"};
-    nbaTeams["Los Angeles Lakers"] = {"Los Angeles Lakers", "lal", "Los Angeles Lakers"};
-    nbaTeams["Memphis Grizzlies"] = {"Memphis Grizzlies", "mem", "Memphis Grizzlies"};
-    nbaTeams["Miami Heat"] = {"Miami Heat", "mia", "Miami Heat"};
-    nbaTeams["Milwaukee Bucks"] = {"Milwaukee Bucks", "mil", "Milwaukee Bucks"};
-    nbaTeams["Minnesota Timberwolves"] = {"Minnesota Timberwolves", "min", "Minnesota Timberwolves"};
-    nbaTeams["New Orleans Pelicans"] = {"New Orleans Pelicans", "nop", "New Orleans Pelicans"};
-    nbaTeams["New York Knicks"] = {"New York Knicks", "nyk", "New York Knicks"};
-    nbaTeams["Oklahoma City Thunder"] = {"Oklahoma City Thunder", "okc", "Oklahoma City Thunder"};
-    nbaTeams["Orlando Magic"] = {"Orlando Magic", "orl", "Orlando Magic"};
-    nbaTeams["Philadelphia 76ers"] = {"Philadelphia 76ers", "phi", "Philadelphia 76ers"};
-    nbaTeams["Phoenix Suns"] = {"Phoenix Suns", "phx", "Phoenix Suns"};
-    nbaTeams["Portland Trail Blazers"] = {"Portland Trail Blazers", "por", "Portland Trail Blazers"};
-    nbaTeams["Sacramento Kings"] = {"Sacramento Kings", "sac", "Sacramento Kings"};
-    nbaTeams["San Antonio Spurs"] = {"San Antonio Spurs", "sas", "San Antonio Spurs"};
-    nbaTeams["Toronto Raptors"] = {"Toronto Raptors", "tor", "Toronto Raptors"};
-    nbaTeams["Utah Jazz"] = {"Utah Jazz", "uta", "Utah Jazz"};
-    nbaTeams["Washington Wizards"] = {"Washington Wizards", "was", "Washington Wizards"};
+    nbaTeams[interner.intern("Atlanta Hawks")] = {"Atlanta Hawks", "atl", "Atlanta Hawks"};
+    nbaTeams[interner.intern("Boston Celtics")] = {"Boston Celtics", "bos", "Boston Celtics"};
+    nbaTeams[interner.intern("Brooklyn Nets")] = {"Brooklyn Nets", "bkn", "Brooklyn Nets"};
+    nbaTeams[interner.intern("Charlotte Hornets")] = {"Charlotte Hornets", "cha", "Charlotte Hornets"};
+    nbaTeams[interner.intern("Chicago Bulls")] = {"Chicago Bulls", "chi", "Chicago Bulls"};
+    nbaTeams[interner.intern("Cleveland Cavaliers")] = {"Cleveland Cavaliers", "cle", "Cleveland Cavaliers"};
+    nbaTeams[interner.intern("Dallas Mavericks")] = {"Dallas Mavericks", "dal", "Dallas Mavericks"};
+    nbaTeams[interner.intern("Denver Nuggets")] = {"Denver Nuggets", "den", "Denver Nuggets"};
+    nbaTeams[interner.intern("Detroit Pistons")] = {"Detroit Pistons", "det", "Detroit Pistons"};
+    nbaTeams[interner.intern("Golden State Warriors")] = {"Golden State Warriors", "gsw", "Golden State Warriors"};
+    nbaTeams[interner.intern("Houston Rockets")] = {"Houston Rockets", "hou", "Houston Rockets"};
+    nbaTeams[interner.intern("Indiana Pacers")] = {"Indiana Pacers", "ind", "Indiana Pacers"};
+    nbaTeams[interner.intern("LA Clippers")] = {"LA Clippers", "lac", "LA Clippers"};
+    nbaTeams[interner.intern("Los Angeles Clippers")] = {"Los Angeles Clippers", "lac", "Los Angeles Clippers"};
+    nbaTeams[interner.intern("LA Lakers")] = {"LA Lakers", "lal", "LA Lakers"};
+    nbaTeams[interner.intern("Los Angeles Lakers")] = {"Los Angeles Lakers", "lal", "Los Angeles Lakers"};
+    nbaTeams[interner.intern("Memphis Grizzlies")] = {"Memphis Grizzlies", "mem", "Memphis Grizzlies"};
+    nbaTeams[interner.intern("Miami Heat")] = {"Miami Heat", "mia", "Miami Heat"};
+    nbaTeams[interner.intern("Milwaukee Bucks")] = {"Milwaukee Bucks", "mil", "Milwaukee Bucks"};
+    nbaTeams[interner.intern("Minnesota Timberwolves")] = {"Minnesota Timberwolves", "min", "Minnesota Timberwolves"};
+    nbaTeams[interner.intern("New Orleans Pelicans")] = {"New Orleans Pelicans", "nop", "New Orleans Pelicans"};
+    nbaTeams[interner.intern("New York Knicks")] = {"New York Knicks", "nyk", "New York Knicks"};
+    nbaTeams[interner.intern("Oklahoma City Thunder")] = {"Oklahoma City Thunder", "okc", "Oklahoma City Thunder"};
+    nbaTeams[interner.intern("Orlando Magic")] = {"Orlando Magic", "orl", "Orlando Magic"};
+    nbaTeams[interner.intern("Philadelphia 76ers")] = {"Philadelphia 76ers", "phi", "Philadelphia 76ers"};
+    nbaTeams[interner.intern("Phoenix Suns")] = {"Phoenix Suns", "phx", "Phoenix Suns"};
+    nbaTeams[interner.intern("Portland Trail Blazers")] = {"Portland Trail Blazers", "por", "Portland Trail Blazers"};
+    nbaTeams[interner.intern("Sacramento Kings")] = {"Sacramento Kings", "sac", "Sacramento Kings"};
+    nbaTeams[interner.intern("San Antonio Spurs")] = {"San Antonio Spurs", "sas", "San Antonio Spurs"};
+    nbaTeams[interner.intern("Toronto Raptors")] = {"Toronto Raptors", "tor", "Toronto Raptors"};
+    nbaTeams[interner.intern("Utah Jazz")] = {"Utah Jazz", "uta", "Utah Jazz"};
+    nbaTeams[interner.intern("Washington Wizards")] = {"Washington Wizards", "was", "Washington Wizards"};
 
     // NHL Teams
-    nhlTeams["Anaheim Ducks"] = {"Anaheim Ducks", "ana", "Anaheim Ducks"};
-    nhlTeams["Arizona Coyotes"] = {"Arizona Coyotes", "ari", "Arizona Coyotes"};
-    nhlTeams["Boston Bruins"] = {"Boston Bruins", "bos", "Boston Bruins"};
-    nhlTeams["Buffalo Sabres"] = {"Buffalo Sabres", "buf", "Buffalo Sabres"};
-    nhlTeams["Calgary Flames"] = {"Calgary Flames", "cgy", "Calgary Flames"};
-    nhlTeams["Carolina Hurricanes"] = {"Carolina Hurricanes", "car", "Carolina Hurricanes"};
-    nhlTeams["Chicago Blackhawks"] = {"Chicago Blackhawks", "chi", "Chicago Blackhawks"};
-    nhlTeams["Colorado Avalanche"] = {"Colorado Avalanche", "col", "Colorado Avalanche"};
-    nhlTeams["Columbus Blue Jackets"] = {"Columbus Blue Jackets", "cbj", "Columbus Blue Jackets"};
-    nhlTeams["Dallas Stars"] = {"Dallas Stars", "dal", "Dallas Stars"};
-    nhlTeams["Detroit Red Wings"] = {"Detroit Red Wings", "det", "Detroit Red Wings"};
-    nhlTeams["Edmonton Oilers"] = {"Edmonton Oilers", "edm", "Edmonton Oilers"};
-    nhlTeams["Florida Panthers"] = {"Florida Panthers", "fla", "Florida Panthers"};
-    nhlTeams["Los Angeles Kings"] = {"Los Angeles Kings", "lak", "Los Angeles Kings"};
-    nhlTeams["Minnesota Wild"] = {"Minnesota Wild", "min", "Minnesota Wild"};
-    nhlTeams["Montreal Canadiens"] = {"Montreal Canadiens", "mtl", "Montreal Canadiens"};
-    nhlTeams["Nashville Predators"] = {"Nashville Predators", "nsh", "Nashville Predators"};
-    nhlTeams["New Jersey Devils"] = {"New Jersey Devils", "njd", "New Jersey Devils"};
-    nhlTeams["New York Islanders"] = {"New York Islanders", "nyi", "New York Islanders"};
-    nhlTeams["New York Rangers"] = {"New York Rangers", "nyr", "New York Rangers"};
-    nhlTeams["Ottawa Senators"] = {"Ottawa Senators", "ott", "Ottawa Senators"};
-    nhlTeams["Philadelphia Flyers"] = {"Philadelphia Flyers", "phi", "Philadelphia Flyers"};
-    nhlTeams["Pittsburgh Penguins"] = {"Pittsburgh Penguins", "pit", "Pittsburgh Penguins"};
-    nhlTeams["San Jose Sharks"] = {"San Jose Sharks", "sjs", "San Jose Sharks"};
-    nhlTeams["Seattle Kraken"] = {"Seattle Kraken", "sea", "Seattle Kraken"};
-    nhlTeams["St. Louis Blues"] = {"St. Louis Blues", "stl", "St. Louis Blues"};
-    nhlTeams["Tampa Bay Lightning"] = {"Tampa Bay Lightning", "tbl", "Tampa Bay Lightning"};
-    nhlTeams["Toronto Maple Leafs"] = {"Toronto Maple Leafs", "tor", "Toronto Maple Leafs"};
-    nhlTeams["Vancouver Canucks"] = {"Vancouver Canucks", "van", "Vancouver Canucks"};
-    nhlTeams["Vegas Golden Knights"] = {"Vegas Golden Knights", "vgk", "Vegas Golden Knights"};
-    nhlTeams["Washington Capitals"] = {"Washington Capitals", "was", "Washington Capitals"};
-    nhlTeams["Winnipeg Jets"] = {"Winnipeg Jets", "wpg", "Winnipeg Jets"};
+    nhlTeams[interner.intern("Anaheim Ducks")] = {"Anaheim Ducks", "ana", "Anaheim Ducks"};
+    nhlTeams[interner.intern("Arizona Coyotes")] = {"Arizona Coyotes", "ari", "Arizona Coyotes"};
+    nhlTeams[interner.intern("Boston Bruins")] = {"Boston Bruins", "bos", "Boston Bruins"};
+    nhlTeams[interner.intern("Buffalo Sabres")] = {"Buffalo Sabres", "buf", "Buffalo Sabres"};
+    nhlTeams[interner.intern("Calgary Flames")] = {"Calgary Flames", "cgy", "Calgary Flames"};
+    nhlTeams[interner.intern("Carolina Hurricanes")] = {"Carolina Hurricanes", "car", "Carolina Hurricanes"};
+    nhlTeams[interner.intern("Chicago Blackhawks")] = {"Chicago Blackhawks", "chi", "Chicago Blackhawks"};
+    nhlTeams[interner.intern("Colorado Avalanche")] = {"Colorado Avalanche", "col", "Colorado Avalanche"};
+    nhlTeams[interner.intern("Columbus Blue Jackets")] = {"Columbus Blue Jackets", "cbj", "Columbus Blue Jackets"};
+    nhlTeams[interner.intern("Dallas Stars")] = {"Dallas Stars", "dal", "Dallas Stars"};
+    nhlTeams[interner.intern("Detroit Red Wings")] = {"Detroit Red Wings", "det", "Detroit Red Wings"};
+    nhlTeams[interner.intern("Edmonton Oilers")] = {"Edmonton Oilers", "edm", "Edmonton Oilers"};
+    nhlTeams[interner.intern("Florida Panthers")] = {"Florida Panthers", "fla", "Florida Panthers"};
+    nhlTeams[interner.intern("Los Angeles Kings")] = {"Los Angeles Kings", "lak", "Los Angeles Kings"};
+    nhlTeams[interner.intern("Minnesota Wild")] = {"Minnesota Wild", "min", "Minnesota Wild"};
+    nhlTeams[interner.intern("Montreal Canadiens")] = {"Montreal Canadiens", "mtl", "Montreal Canadiens"};
+    nhlTeams[interner.intern("Nashville Predators")] = {"Nashville Predators", "nsh", "Nashville Predators"};
+    nhlTeams[interner.intern("New Jersey Devils")] = {"New Jersey Devils", "njd", "New Jersey Devils"};
+    nhlTeams[interner.intern("New York Islanders")] = {"New York Islanders", "nyi", "New York Islanders"};
+    nhlTeams[interner.intern("New York Rangers")] = {"New York Rangers", "nyr", "New York Rangers"};
+    nhlTeams[interner.intern("Ottawa Senators")] = {"Ottawa Senators", "ott", "Ottawa Senators"};
+    nhlTeams[interner.intern("Philadelphia Flyers")] = {"Philadelphia Flyers", "phi", "Philadelphia Flyers"};
+    nhlTeams[interner.intern("Pittsburgh Penguins")] = {"Pittsburgh Penguins", "pit", "Pittsburgh Penguins"};
+    nhlTeams[interner.intern("San Jose Sharks")] = {"San Jose Sharks", "sjs", "San Jose Sharks"};
+    nhlTeams[interner.intern("Seattle Kraken")] = {"Seattle Kraken", "sea", "Seattle Kraken"};
+    nhlTeams[interner.intern("St. Louis Blues")] = {"St. Louis Blues", "stl", "St. Louis Blues"};
+    nhlTeams[interner.intern("Tampa Bay Lightning")] = {"Tampa Bay Lightning", "tbl", "Tampa Bay Lightning"};
+    nhlTeams[interner.intern("Toronto Maple Leafs")] = {"Toronto Maple Leafs", "tor", "Toronto Maple Leafs"};
+    nhlTeams[interner.intern("Vancouver Canucks")] = {"Vancouver Canucks", "van", "Vancouver Canucks"};
+    nhlTeams[interner.intern("Vegas Golden Knights")] = {"Vegas Golden Knights", "vgk", "Vegas Golden Knights"};
+    nhlTeams[interner.intern("Washington Capitals")] = {"Washington Capitals", "was", "Washington Capitals"};
+    nhlTeams[interner.intern("Winnipeg Jets")] = {"Winnipeg Jets", "wpg", "Winnipeg Jets"};
 
     // MLB Teams
-    mlbTeams["Arizona Diamondbacks"] = {"Arizona Diamondbacks", "ari", "Arizona Diamondbacks"};
-    mlbTeams["Atlanta Braves"] = {"Atlanta Braves", "atl", "Atlanta Braves"};
-    mlbTeams["Baltimore Orioles"] = {"Baltimore Orioles", "bal", "Baltimore Orioles"};
-    mlbTeams["Boston Red Sox"] = {"Boston Red Sox", "bos", "Boston Red Sox"};
-    mlbTeams["Chicago Cubs"] = {"Chicago Cubs", "chc", "Chicago Cubs"};
-    mlbTeams["Chicago White Sox"] = {"Chicago White Sox", "cws", "Chicago White Sox"};
-    mlbTeams["Cincinnati Reds"] = {"Cincinnati Reds", "cin", "Cincinnati Reds"};
-    mlbTeams["Cleveland Guardians"] = {"Cleveland Guardians", "cle", "Cleveland Guardians"};
-    mlbTeams["Colorado Rockies"] = {"Colorado Rockies", "col", "Colorado Rockies"};
-    mlbTeams["Detroit Tigers"] = {"Detroit Tigers", "det", "Detroit Tigers"};
-    mlbTeams["Houston Astros"] = {"Houston Astros", "hou", "Houston Astros"};
-    mlbTeams["Kansas City Royals"] = {"Kansas City Royals", "kan", "Kansas City Royals"};
-    mlbTeams["Los Angeles Angels"] = {"Los Angeles Angels", "laa", "Los Angeles Angels"};
-    mlbTeams["Los Angeles Dodgers"] = {"Los Angeles Dodgers", "lad", "Los Angeles Dodgers"};
-    mlbTeams["Miami Marlins"] = {"Miami Marlins", "mia", "Miami Marlins"};
-    mlbTeams["Milwaukee Brewers"] = {"Milwaukee Brewers", "mil", "Milwaukee Brewers"};
-    mlbTeams["Minnesota Twins"] = {"Minnesota Twins", "min", "Minnesota Twins"};
-    mlbTeams["New York Mets"] = {"New York Mets", "nym", "New York Mets"};
-    mlbTeams["New York Yankees"] = {"New York Yankees", "nyy", "New York Yankees"};
-    mlbTeams["Oakland Athletics"] = {"Oakland Athletics", "oak", "Oakland Athletics"};
-    mlbTeams["Philadelphia Phillies"] = {"Philadelphia Phillies", "phi", "Philadelphia Phillies"};
-    mlbTeams["Pittsburgh Pirates"] = {"Pittsburgh Pirates", "pit", "Pittsburgh Pirates"};
-    mlbTeams["San Diego Padres"] = {"San Diego Padres", "sd", "San Diego Padres"};
-    mlbTeams["San Francisco Giants"] = {"San Francisco Giants", "sf", "San Francisco Giants"};
-    mlbTeams["Seattle Mariners"] = {"Seattle Mariners", "sea", "Seattle Mariners"};
-    mlbTeams["St. Louis Cardinals"] = {"St. Louis Cardinals", "stl", "St. Louis Cardinals"};
-    mlbTeams["Tampa Bay Rays"] = {"Tampa Bay Rays", "tb", "Tampa Bay Rays"};
-    mlbTeams["Texas Rangers"] = {"Texas Rangers", "tex", "Texas Rangers"};
-    mlbTeams["Toronto Blue Jays"] = {"Toronto Blue Jays", "tor", "Toronto Blue Jays"};
-    mlbTeams["Washington Nationals"] = {"Washington Nationals", "was", "Washington Nationals"};
+    mlbTeams[interner.intern("Arizona Diamondbacks")] = {"Arizona Diamondbacks", "ari", "Arizona Diamondbacks"};
+    mlbTeams[interner.intern("Atlanta Braves")] = {"Atlanta Braves", "atl", "Atlanta Braves"};
+    mlbTeams[interner.intern("Baltimore Orioles")] = {"Baltimore Orioles", "bal", "Baltimore Orioles"};
+    mlbTeams[interner.intern("Boston Red Sox")] = {"Boston Red Sox", "bos", "Boston Red Sox"};
+    mlbTeams[interner.intern("Chicago Cubs")] = {"Chicago Cubs", "chc", "Chicago Cubs"};
+    mlbTeams[interner.intern("Chicago White Sox")] = {"Chicago White Sox", "cws", "Chicago White Sox"};
+    mlbTeams[interner.intern("Cincinnati Reds")] = {"Cincinnati Reds", "cin", "Cincinnati Reds"};
+    mlbTeams[interner.intern("Cleveland Guardians")] = {"Cleveland Guardians", "cle", "Cleveland Guardians"};
+    mlbTeams[interner.intern("Colorado Rockies")] = {"Colorado Rockies", "col", "Colorado Rockies"};
+    mlbTeams[interner.intern("Detroit Tigers")] = {"Detroit Tigers", "det", "Detroit Tigers"};
+    mlbTeams[interner.intern("Houston Astros")] = {"Houston Astros", "hou", "Houston Astros"};
+    mlbTeams[interner.intern("Kansas City Royals")] = {"Kansas City Royals", "kan", "Kansas City Royals"};
+    mlbTeams[interner.intern("Los Angeles Angels")] = {"Los Angeles Angels", "laa", "Los Angeles Angels"};
+    mlbTeams[interner.intern("Los Angeles Dodgers")] = {"Los Angeles Dodgers", "lad", "Los Angeles Dodgers"};
+    mlbTeams[interner.intern("Miami Marlins")] = {"Miami Marlins", "mia", "Miami Marlins"};
+    mlbTeams[interner.intern("Milwaukee Brewers")] = {"Milwaukee Brewers", "mil", "Milwaukee Brewers"};
+    mlbTeams[interner.intern("Minnesota Twins")] = {"Minnesota Twins", "min", "Minnesota Twins"};
+    mlbTeams[interner.intern("New York Mets")] = {"New York Mets", "nym", "New York Mets"};
+    mlbTeams[interner.intern("New York Yankees")] = {"New York Yankees", "nyy", "New York Yankees"};
+    mlbTeams[interner.intern("Oakland Athletics")] = {"Oakland Athletics", "oak", "Oakland Athletics"};
+    mlbTeams[interner.intern("Philadelphia Phillies")] = {"Philadelphia Phillies", "phi", "Philadelphia Phillies"};
+    mlbTeams[interner.intern("Pittsburgh Pirates")] = {"Pittsburgh Pirates", "pit", "Pittsburgh Pirates"};
+    mlbTeams[interner.intern("San Diego Padres")] = {"San Diego Padres", "sd", "San Diego Padres"};
+    mlbTeams[interner.intern("San Francisco Giants")] = {"San Francisco Giants", "sf", "San Francisco Giants"};
+    mlbTeams[interner.intern("Seattle Mariners")] = {"Seattle Mariners", "sea", "Seattle Mariners"};
+    mlbTeams[interner.intern("St. Louis Cardinals")] = {"St. Louis Cardinals", "stl", "St. Louis Cardinals"};
+    mlbTeams[interner.intern("Tampa Bay Rays")] = {"Tampa Bay Rays", "tb", "Tampa Bay Rays"};
+    mlbTeams[interner.intern("Texas Rangers")] = {"Texas Rangers", "tex", "Texas Rangers"};
+    mlbTeams[interner.intern("Toronto Blue Jays")] = {"Toronto Blue Jays", "tor", "Toronto Blue Jays"};
+    mlbTeams[interner.intern("Washington Nationals")] = {"Washington Nationals", "was", "Washington Nationals"};
 
     std::cout << "[MarketMatcher] Initialized team mappings: " 
               << nbaTeams.size() << " NBA, " 
@@ -329,47 +326,41 @@ std::string MarketMatcher::formatDateForSlug(const std::string &iso)
 // Generate slug for a game based on sport, teams, and date
 std::string MarketMatcher::generateSlugForGame(const polymarket_bot::common::RawOddsGame& game)
 {
-    std::string sport = game.sport_key;
-    std::string awayTeam = game.away_team;
-    std::string homeTeam = game.home_team;
+    namespace interned = polymarket_bot::common::interned;
+    const std::string& awayTeam = game.away_team;
+    const std::string& homeTeam = game.home_team;
     std::string gameDate = formatDateForSlug(game.commence_time);
     
-    // Determine sport prefix
+    // Determine sport prefix and team table from the interned sport key
     std::string sportPrefix;
-    if (sport == "basketball_nba" || sport == "basketball_nba_summer_league") {
+    std::unordered_map<polymarket_bot::common::StringInterner::Id, TeamMapping>* teamMap = nullptr;
+    switch (game.sportKeyId) {
+    case interned::basketballNba:
+    case interned::basketballNbaSummerLeague:
         sportPrefix = "nba";
-    } else if (sport == "icehockey_nhl") {
-        sportPrefix = "nhl";
-    } else if (sport == "baseball_mlb") {
-        sportPrefix = "mlb";
-    } else {
-        std::cout << "[MarketMatcher] Unsupported sport: " << sport << std::endl;
-        return ""; // Unsupported sport
-    }
-    
-    // Get team codes
-    std::string awayCode, homeCode;
-    std::unordered_map<std::string, TeamMapping>* teamMap = nullptr;
-    
-    if (sportPrefix == "nba") {
         teamMap = &nbaTeams;
-    } else if (sportPrefix == "nhl") {
+        break;
+    case interned::icehockeyNhl:
+        sportPrefix = "nhl";
         teamMap = &nhlTeams;
-    } else if (sportPrefix == "mlb") {
+        break;
+    case interned::baseballMlb:
+        sportPrefix = "mlb";
         teamMap = &mlbTeams;
-    }
-    
-    if (!teamMap) {
-        return "";
+        break;
+    default:
+        logLine("[MarketMatcher] Unsupported sport: " + game.sport_key);
+        return ""; // Unsupported sport
     }
     
     // Find team codes
-    auto awayIt = teamMap->find(awayTeam);
-    auto homeIt = teamMap->find(homeTeam);
+    std::string awayCode, homeCode;
+    auto awayIt = teamMap->find(game.awayTeamId);
+    auto homeIt = teamMap->find(game.homeTeamId);
     
     if (awayIt == teamMap->end() || homeIt == teamMap->end()) {
-        std::cout << "[MarketMatcher] Warning: Could not find team mapping for "
-                  << awayTeam << " or " << homeTeam << " in " << sportPrefix << std::endl;
+        logLine("[MarketMatcher] Warning: Could not find team mapping for " + awayTeam + " or " + homeTeam +
+                " in " + sportPrefix);
         return "";
     }
     
@@ -379,9 +370,8 @@ std::string MarketMatcher::generateSlugForGame(const polymarket_bot::common::Raw
     // Generate slug: sport-away-home-date
     std::string slug = sportPrefix + "-" + awayCode + "-" + homeCode + "-" + gameDate;
     
-    std::cout << "[MarketMatcher] Generated slug: " << slug 
-              << " for " << awayTeam << " vs " << homeTeam 
-              << " on " << gameDate << std::endl;
+    logLine("[MarketMatcher] Generated slug: " + slug + " for " + awayTeam + " vs " + homeTeam +
+            " on " + gameDate);
     
     return slug;
 }
@@ -389,123 +379,78 @@ std::string MarketMatcher::generateSlugForGame(const polymarket_bot::common::Raw
 // Find Polymarket market by slug
 std::string MarketMatcher::findPolymarketMarketBySlug(const std::string& slug)
 {
-    for (const auto& market : gammaMarkets) {
-        if (market.slug && *market.slug == slug) {
-            if (market.id) {
-                return *market.id;
-            }
-        }
+    const auto* market = gammaUniverse.findBySlug(slug);
+    if (market && market->id) {
+        return market->idText();
     }
     return "";
 }
 
-// New slug-based matching method
-std::vector<std::pair<std::string, std::string>> MarketMatcher::matchMarketsBySlug()
+// Build the gamma lookup request for a slug
+polymarket_bot::api::HttpRequest MarketMatcher::buildSlugRequest(const std::string& slug) const
 {
-    std::cout << "[MarketMatcher] Starting slug-based matching..." << std::endl;
-    
-    std::vector<std::pair<std::string, std::string>> results;
-    int matchedCount = 0;
-    int totalGames = 0;
-    
-    for (const auto& game : oddsGames) {
-        totalGames++;
-        
-        // Generate slug for this game
-        std::string slug = generateSlugForGame(game);
-        if (slug.empty()) {
-            std::cout << "[MarketMatcher] Skipping game: " << game.away_team 
-                      << " vs " << game.home_team << " (unsupported sport or missing team mapping)" << std::endl;
-            continue;
-        }
-        
-        // Fetch market directly by slug from Polymarket API
-        auto market = fetchMarketBySlug(slug);
-        if (market.has_value()) {
-            if (market->id) {
-                results.emplace_back(*market->id, game.id);
-                matchedCount++;
-                std::cout << "[MarketMatcher] ✓ Matched: " << slug << " -> " << *market->id << std::endl;
-            }
-        } else {
-            std::cout << "[MarketMatcher] ✗ No market found for slug: " << slug << std::endl;
-        }
-    }
-    
-    std::cout << "[MarketMatcher] Slug-based matching complete. "
-              << "Matched " << matchedCount << " out of " << totalGames << " games." << std::endl;
-    
-    return results;
+    polymarket_bot::api::HttpRequest request;
+    request.url = slugUrl(slug);
+    request.deadline = requestDeadline;
+    polymarket_bot::api::HttpResponseCache::getInstance().addValidators(request);
+    return request;
 }
 
-// Fetch market by slug directly from Polymarket API
-std::optional<polymarket_bot::common::GammaMarket> MarketMatcher::fetchMarketBySlug(const std::string& slug)
+std::string MarketMatcher::slugUrl(const std::string& slug) const
 {
-    // Helper function to try a specific slug
-    auto trySlug = [this](const std::string& testSlug) -> std::optional<polymarket_bot::common::GammaMarket> {
-        try {
-            std::string url = "https://gamma-api.polymarket.com/markets?slug=" + testSlug;
-            
-            CURL *curl = curl_easy_init();
-            if (!curl) {
-                return std::nullopt;
-            }
-            
-            std::string readBuffer;
-            curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
-            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
-            
-            CURLcode res = curl_easy_perform(curl);
-            curl_easy_cleanup(curl);
-            
-            if (res != CURLE_OK) {
-                return std::nullopt;
-            }
-            
-            // Parse the response
-            try {
-                auto jsonResponse = nlohmann::json::parse(readBuffer);
-                
+    return polyClient.getGammaBaseUrl() + "/markets?slug=" + slug;
+}
+
+// Parse the first market of a gamma /markets?slug= response
+std::optional<MarketRecord> MarketMatcher::parseSlugResponse(const std::string& slug,
+                                                            const polymarket_bot::api::HttpResponse& response,
+                                                            bool& answered)
+{
+    answered = false;
+    try {
+        // A 304 reuses the record built on an earlier scan
+        auto market = polymarket_bot::api::HttpResponseCache::getInstance().resolve<std::optional<MarketRecord>>(
+            slugUrl(slug), response, [](const std::string& body) -> std::optional<MarketRecord> {
                 // The API returns an array directly, not nested under "markets"
-                if (jsonResponse.is_array() && jsonResponse.size() > 0) {
-                    // Parse the first market
-                    polymarket_bot::common::GammaMarket market;
-                    from_json(jsonResponse[0], market);
-                    std::cout << "[MarketMatcher] ✓ Found market for slug: " << testSlug << " (ID: " << (market.id ? *market.id : "unknown") << ")" << std::endl;
-                    return market;
+                auto markets = polymarket_bot::api::GammaMarketDecoder::decodePage(
+                    body, polymarket_bot::api::GammaProjection::matching());
+                if (!markets) {
+                    throw std::runtime_error("Unexpected Gamma markets response structure - expected array");
                 }
-                
-                return std::nullopt;
-                
-            } catch (const std::exception& e) {
-                return std::nullopt;
-            }
-            
-        } catch (const std::exception& e) {
-            return std::nullopt;
+                if (markets->empty()) {
+                    return std::nullopt;
+                }
+                return MarketRecord::fromDecoded(markets->front());
+            });
+        // Only a 200 array (or a 304 the cache still holds) says anything about whether the market exists;
+        // throttling, server errors and error bodies do not
+        answered = market != nullptr;
+        
+        if (market && market->has_value()) {
+            const auto& found = **market;
+            logLine("[MarketMatcher] ✓ Found market for slug: " + slug + " (ID: " + (found.id ? found.idText() : "unknown") + ")");
+            return found;
         }
-    };
-    
-    // Try the original slug first
-    auto result = trySlug(slug);
-    if (result.has_value()) {
-        return result;
+    } catch (const std::exception& e) {
+        return std::nullopt;
     }
-    
-    // If not found, try variations with different dates and team orders
-    std::cout << "[MarketMatcher] Trying variations for slug: " << slug << std::endl;
-    
+
+    return std::nullopt;
+}
+
+// Candidate slugs for a game, indexed by SlugVariant (empty if the slug cannot be parsed)
+std::vector<std::string> MarketMatcher::slugCandidates(const std::string& slug)
+{
     // Parse the original slug to extract components
     // Format: sport-away-home-date
     size_t firstDash = slug.find('-');
-    if (firstDash == std::string::npos) return std::nullopt;
+    if (firstDash == std::string::npos) return {};
     
     size_t secondDash = slug.find('-', firstDash + 1);
-    if (secondDash == std::string::npos) return std::nullopt;
+    if (secondDash == std::string::npos) return {};
     
     size_t thirdDash = slug.find('-', secondDash + 1);
-    if (thirdDash == std::string::npos) return std::nullopt;
+    if (thirdDash == std::string::npos) return {};
     
     std::string sport = slug.substr(0, firstDash);
     std::string awayTeam = slug.substr(firstDash + 1, secondDash - firstDash - 1);
@@ -515,64 +460,280 @@ std::optional<polymarket_bot::common::GammaMarket> MarketMatcher::fetchMarketByS
     // Parse the date
     int year, month, day;
     if (sscanf(date.c_str(), "%d-%d-%d", &year, &month, &day) != 3) {
-        return std::nullopt;
+        return {};
+    }
+    std::chrono::year_month_day ymd{std::chrono::year{year}, std::chrono::month{static_cast<unsigned>(month)},
+                                    std::chrono::day{static_cast<unsigned>(day)}};
+    if (!ymd.ok()) {
+        return {};
     }
     
-    // Try variations:
-    // 1. Day before
-    std::string dayBefore = sport + "-" + awayTeam + "-" + homeTeam + "-" + 
-                           std::to_string(year) + "-" + 
-                           std::string(month < 10 ? "0" : "") + std::to_string(month) + "-" + 
-                           std::string((day-1) < 10 ? "0" : "") + std::to_string(day-1);
-    result = trySlug(dayBefore);
-    if (result.has_value()) {
-        std::cout << "[MarketMatcher] Found market with day before variation: " << dayBefore << std::endl;
-        return result;
+    // Calendar arithmetic so month and year boundaries roll over correctly
+    auto shiftedDate = [&](int days) {
+        std::chrono::year_month_day shifted{std::chrono::sys_days{ymd} + std::chrono::days{days}};
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "%04d-%02u-%02u", static_cast<int>(shifted.year()),
+                      static_cast<unsigned>(shifted.month()), static_cast<unsigned>(shifted.day()));
+        return std::string(buf);
+    };
+    
+    std::string dayBefore = shiftedDate(-1);
+    std::string dayAfter = shiftedDate(1);
+    
+    return {
+        slug,                                                            // Exact
+        sport + "-" + awayTeam + "-" + homeTeam + "-" + dayBefore,       // Day before
+        sport + "-" + awayTeam + "-" + homeTeam + "-" + dayAfter,        // Day after
+        sport + "-" + homeTeam + "-" + awayTeam + "-" + date,            // Swapped team order
+        sport + "-" + homeTeam + "-" + awayTeam + "-" + dayBefore,       // Swapped, day before
+        sport + "-" + homeTeam + "-" + awayTeam + "-" + dayAfter         // Swapped, day after
+    };
+}
+
+// Serialize a log line across resolver threads
+void MarketMatcher::logLine(const std::string& line)
+{
+    std::lock_guard<std::mutex> lock(coutMutex);
+    std::cout << line << std::endl;
+}
+
+// Several lines (each ending in a newline) written without anything in between
+void MarketMatcher::logBlock(const std::string& lines)
+{
+    std::lock_guard<std::mutex> lock(coutMutex);
+    std::cout << lines << std::flush;
+}
+
+// New slug-based matching method
+std::vector<std::pair<std::string, std::string>> MarketMatcher::matchMarketsBySlug()
+{
+    logLine("[MarketMatcher] Starting slug-based matching...");
+    matchedSnapshot.clear();
+    
+    std::vector<size_t> indices(oddsGames.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+        indices[i] = i;
     }
+    auto results = matchGames(indices);
     
-    // 2. Day after
-    std::string dayAfter = sport + "-" + awayTeam + "-" + homeTeam + "-" + 
-                          std::to_string(year) + "-" + 
-                          std::string(month < 10 ? "0" : "") + std::to_string(month) + "-" + 
-                          std::string((day+1) < 10 ? "0" : "") + std::to_string(day+1);
-    result = trySlug(dayAfter);
-    if (result.has_value()) {
-        std::cout << "[MarketMatcher] Found market with day after variation: " << dayAfter << std::endl;
-        return result;
+    logLine("[MarketMatcher] Slug-based matching complete. Matched " + std::to_string(results.size()) +
+            " out of " + std::to_string(oddsGames.size()) + " games.");
+    slugCache.logStats();
+    
+    return results;
+}
+
+// Resolve the markets of the given odds games and add them to the matched snapshot
+std::vector<std::pair<std::string, std::string>> MarketMatcher::matchGames(const std::vector<size_t>& indices)
+{
+    std::vector<std::pair<std::string, std::string>> results;
+    int totalGames = static_cast<int>(indices.size());
+    
+    // Generate slugs for every game up front
+    std::vector<std::string> slugs(indices.size());
+    for (size_t k = 0; k < indices.size(); ++k) {
+        const auto& game = oddsGames[indices[k]];
+        slugs[k] = generateSlugForGame(game);
+        if (slugs[k].empty()) {
+            logLine("[MarketMatcher] Skipping game: " + game.away_team + " vs " + game.home_team +
+                    " (unsupported sport or missing team mapping)");
+        }
     }
     
-    // 3. Swapped team order (home vs away)
-    std::string swappedOrder = sport + "-" + homeTeam + "-" + awayTeam + "-" + date;
-    result = trySlug(swappedOrder);
-    if (result.has_value()) {
-        std::cout << "[MarketMatcher] Found market with swapped team order: " << swappedOrder << std::endl;
-        return result;
+    // Every game resolves as its own coroutine; at most workerCount of them have requests in flight
+    int workerCount = configManager.isParallelSlugResolution() ? maxConcurrentRequests : 1;
+    workerCount = std::max(1, std::min(workerCount, totalGames));
+    if (workerCount > 1) {
+        logLine("[MarketMatcher] Resolving " + std::to_string(totalGames) + " games with " +
+                std::to_string(workerCount) + " concurrent lookups");
+    }
+    std::vector<polymarket_bot::api::Task<std::optional<MarketRecord>>> lookups;
+    lookups.reserve(slugs.size());
+    for (const auto& slug : slugs) {
+        lookups.push_back(resolveSlug(slug));
+    }
+    auto markets = polymarket_bot::api::syncWait(
+        polymarket_bot::api::whenAll(std::move(lookups), static_cast<size_t>(workerCount)));
+    
+    // Merge in game order so the output does not depend on completion order
+    auto fetchedAt = std::chrono::steady_clock::now();
+    for (size_t k = 0; k < slugs.size(); ++k) {
+        if (slugs[k].empty()) {
+            continue;
+        }
+        const auto& game = oddsGames[indices[k]];
+        if (markets[k].has_value()) {
+            if (markets[k]->id) {
+                results.emplace_back(markets[k]->idText(), game.id);
+                logLine("[MarketMatcher] ✓ Matched: " + slugs[k] + " -> " + results.back().first);
+                matchedSnapshot[game.id] = {std::move(*markets[k]), slugs[k], fetchedAt};
+            }
+        } else {
+            logLine("[MarketMatcher] ✗ No market found for slug: " + slugs[k]);
+        }
+    }
+    
+    return results;
+}
+
+// Market matched for a game in this scan; refetched once it is older than sync.priceUpdateInterval
+const MarketMatcher::MatchedMarket* MarketMatcher::snapshotMarket(const polymarket_bot::common::RawOddsGame& game)
+{
+    auto it = matchedSnapshot.find(game.id);
+    if (it == matchedSnapshot.end()) {
+        return nullptr;
     }
     
-    // 4. Swapped team order with day before
-    std::string swappedDayBefore = sport + "-" + homeTeam + "-" + awayTeam + "-" + 
-                                  std::to_string(year) + "-" + 
-                                  std::string(month < 10 ? "0" : "") + std::to_string(month) + "-" + 
-                                  std::string((day-1) < 10 ? "0" : "") + std::to_string(day-1);
-    result = trySlug(swappedDayBefore);
+    // Markets priced from the live feed never need their Gamma prices refetched
+    auto maxAge = std::chrono::seconds(configManager.getPriceUpdateInterval());
+    if (std::chrono::steady_clock::now() - it->second.fetchedAt > maxAge && !hasLiveQuotes(it->second.market)) {
+        logLine("[MarketMatcher] Snapshot for " + it->second.slug + " is stale, refetching prices");
+        if (pipelineRunning) {
+            // The universe is being read by the match workers, so this market alone is fetched from Gamma
+            std::string slug = it->second.market.slug ? it->second.market.slugText() : it->second.slug;
+            bool answered = false;
+            auto fresh = parseSlugResponse(slug, polymarket_bot::api::syncWait(fetchSlug(slug)), answered);
+            if (fresh.has_value()) {
+                it->second.market = std::move(*fresh);
+                it->second.fetchedAt = std::chrono::steady_clock::now();
+            } else if (answered) {
+                matchedSnapshot.erase(it);
+                return nullptr;
+            }
+            // On a failed request the previous prices stay
+            return &it->second;
+        }
+        // One universe refresh serves every stale entry in this pass
+        if (configManager.useGammaSnapshot() && std::chrono::steady_clock::now() - gammaUniverse.loadedAt() > maxAge) {
+            gammaUniverse.refresh(maxConcurrentRequests);
+        }
+        auto fresh = fetchMarketBySlug(it->second.slug);
+        if (!fresh.has_value()) {
+            matchedSnapshot.erase(it);
+            return nullptr;
+        }
+        it->second.market = std::move(*fresh);
+        it->second.fetchedAt = std::chrono::steady_clock::now();
+    }
+    return &it->second;
+}
+
+// Resolve a slug and its variants against the Gamma snapshot
+std::optional<MarketRecord> MarketMatcher::lookupSnapshotBySlug(const std::string& slug)
+{
+    auto candidates = slugCandidates(slug);
+    if (candidates.empty()) {
+        candidates = {slug};
+    }
+    std::string sport = slug.substr(0, slug.find('-'));
+    
+    for (SlugVariant variant : slugCache.variantOrder(sport)) {
+        size_t index = static_cast<size_t>(variant);
+        if (index >= candidates.size()) {
+            continue;
+        }
+        if (const auto* market = gammaUniverse.findBySlug(candidates[index])) {
+            slugCache.recordHit(sport, variant);
+            if (variant == SlugVariant::Exact) {
+                logLine("[MarketMatcher] ✓ Found market for slug: " + slug + " (ID: " + (market->id ? market->idText() : "unknown") + ")");
+            } else {
+                logLine("[MarketMatcher] Found market with variation: " + candidates[index]);
+            }
+            return *market;
+        }
+    }
+    
+    logLine("[MarketMatcher] Slug not in Gamma snapshot, looking it up directly: " + slug);
+    return std::nullopt;
+}
+
+// Fetch market by slug directly from Polymarket API
+std::optional<MarketRecord> MarketMatcher::fetchMarketBySlug(const std::string& slug)
+{
+    return polymarket_bot::api::syncWait(resolveSlug(slug));
+}
+
+polymarket_bot::api::Task<polymarket_bot::api::HttpResponse> MarketMatcher::fetchSlug(std::string slug)
+{
+    co_return co_await polymarket_bot::api::AsyncHttpEngine::getInstance().fetch(buildSlugRequest(slug));
+}
+
+polymarket_bot::api::Task<std::optional<MarketRecord>> MarketMatcher::resolveSlug(std::string slug)
+{
+    if (slug.empty()) {
+        co_return std::nullopt;
+    }
+    // Most games resolve from the snapshot; a market listed since the last refresh (or outside its tags)
+    // is still reachable through the per-slug probes below
+    if (configManager.useGammaSnapshot() && gammaUniverse.isLoaded()) {
+        if (auto market = lookupSnapshotBySlug(slug)) {
+            co_return market;
+        }
+    }
+    
+    if (slugCache.isKnownMissing(slug)) {
+        logLine("[MarketMatcher] Skipping slug with no market (negative cache): " + slug);
+        co_return std::nullopt;
+    }
+    
+    auto candidates = slugCandidates(slug);
+    if (candidates.empty()) {
+        candidates = {slug};
+    }
+    std::string sport = slug.substr(0, slug.find('-'));
+    
+    std::vector<SlugVariant> order;
+    for (SlugVariant variant : slugCache.variantOrder(sport)) {
+        if (static_cast<size_t>(variant) < candidates.size()) {
+            order.push_back(variant);
+        }
+    }
+    
+    // Probe the most likely candidate on its own; it answers most games in one request
+    const std::string& first = candidates[static_cast<size_t>(order.front())];
+    auto firstResponse = co_await fetchSlug(first);
+    // Only a complete set of answers proves the slug has no market; timeouts, 429s and 5xx must not
+    // poison the negative cache
+    bool allAnswered = false;
+    auto result = parseSlugResponse(first, firstResponse, allAnswered);
     if (result.has_value()) {
-        std::cout << "[MarketMatcher] Found market with swapped order and day before: " << swappedDayBefore << std::endl;
-        return result;
+        slugCache.recordHit(sport, order.front());
+        co_return result;
+    }
+    
+    // If not found, try the remaining candidates concurrently; the first in learned order wins
+    logLine("[MarketMatcher] Trying variations for slug: " + slug);
+    
+    std::vector<polymarket_bot::api::Task<polymarket_bot::api::HttpResponse>> probes;
+    for (size_t v = 1; v < order.size(); ++v) {
+        probes.push_back(fetchSlug(candidates[static_cast<size_t>(order[v])]));
     }
+    auto responses = co_await polymarket_bot::api::whenAll(std::move(probes));
     
-    // 5. Swapped team order with day after
-    std::string swappedDayAfter = sport + "-" + homeTeam + "-" + awayTeam + "-" + 
-                                 std::to_string(year) + "-" + 
-                                 std::string(month < 10 ? "0" : "") + std::to_string(month) + "-" + 
-                                 std::string((day+1) < 10 ? "0" : "") + std::to_string(day+1);
-    result = trySlug(swappedDayAfter);
+    for (size_t v = 1; v < order.size(); ++v) {
+        const std::string& candidate = candidates[static_cast<size_t>(order[v])];
+        const auto& response = responses[v - 1];
+        if (!result.has_value()) {
+            bool answered = false;
+            result = parseSlugResponse(candidate, response, answered);
+            allAnswered = allAnswered && answered;
+            if (result.has_value()) {
+                slugCache.recordHit(sport, order[v]);
+                logLine("[MarketMatcher] Found market with variation: " + candidate);
+            }
+        }
+    }
     if (result.has_value()) {
-        std::cout << "[MarketMatcher] Found market with swapped order and day after: " << swappedDayAfter << std::endl;
-        return result;
+        co_return result;
     }
     
-    std::cout << "[MarketMatcher] No market found for slug: " << slug << " (tried all variations)" << std::endl;
-    return std::nullopt;
+    if (!allAnswered) {
+        logLine("[MarketMatcher] Gave up on slug: " + slug + " (requests failed or ran out of time)");
+        co_return std::nullopt;
+    }
+    slugCache.recordMiss(slug);
+    logLine("[MarketMatcher] No market found for slug: " + slug + " (tried all variations)");
+    co_return std::nullopt;
 }
 
 // Slug-based matching (replaces interactive matching)
@@ -621,7 +782,7 @@ std::string MarketMatcher::determineRecommendedAction(double polymarketProb, dou
     }
 }
 
-double MarketMatcher::calculateOptimalStake(double edge, double totalStake) {
+double MarketMatcher::calculateOptimalStake(double edge, std::ostream& log, double totalStake) {
     // Get bankroll from environment variable
     const char* bankrollEnv = std::getenv("BANKROLL");
     double bankroll = 1000; // Default bankroll if not set
@@ -630,10 +791,10 @@ double MarketMatcher::calculateOptimalStake(double edge, double totalStake) {
         try {
             bankroll = std::stod(bankrollEnv);
         } catch (const std::exception& e) {
-            std::cout << "[MarketMatcher] Warning: Invalid BANKROLL environment variable, using default: " << bankroll << std::endl;
+            log << "[MarketMatcher] Warning: Invalid BANKROLL environment variable, using default: " << bankroll << std::endl;
         }
     } else {
-        std::cout << "[MarketMatcher] Warning: BANKROLL environment variable not set, using default: " << bankroll << std::endl;
+        log << "[MarketMatcher] Warning: BANKROLL environment variable not set, using default: " << bankroll << std::endl;
     }
     
     if (edge <= 0.0) {
@@ -670,216 +831,604 @@ double MarketMatcher::calculateOptimalStake(double edge, double totalStake) {
     recommendedStake = std::max(recommendedStake, minStake);
     recommendedStake = std::min(recommendedStake, maxStake);
     
-    std::cout << "[MarketMatcher] Kelly calculation:" << std::endl;
-    std::cout << "  Bankroll: $" << bankroll << std::endl;
-    std::cout << "  Edge: " << (edge * 100) << "%" << std::endl;
-    std::cout << "  Kelly fraction: " << (kellyFraction * 100) << "%" << std::endl;
-    std::cout << "  Recommended stake: $" << recommendedStake << std::endl;
+    log << "[MarketMatcher] Kelly calculation:" << std::endl;
+    log << "  Bankroll: $" << bankroll << std::endl;
+    log << "  Edge: " << (edge * 100) << "%" << std::endl;
+    log << "  Kelly fraction: " << (kellyFraction * 100) << "%" << std::endl;
+    log << "  Recommended stake: $" << recommendedStake << std::endl;
     
     return recommendedStake;
 }
 
-std::vector<ArbitrageOpportunity> MarketMatcher::findArbitrageOpportunities(double minEdge) {
-    std::cout << "[TradingFinder] Starting Polymarket trading opportunity analysis..." << std::endl;
+void MarketMatcher::evaluateMatch(const std::pair<std::string, std::string>& match, double minEdge,
+                                  std::vector<ArbitrageOpportunity>& opportunities) {
+    const std::string& polymarketId = match.first;
+    const std::string& oddsId = match.second;
     
-    std::vector<ArbitrageOpportunity> opportunities;
+    // Find the corresponding odds game
+    const polymarket_bot::common::RawOddsGame* oddsGame = nullptr;
+    for (const auto& game : oddsGames) {
+        if (game.id == oddsId) {
+            oddsGame = &game;
+            break;
+        }
+    }
     
-    // Get matched markets using slug-based matching
-    auto matchedMarkets = matchMarketsBySlug();
-    std::cout << "[TradingFinder] Found " << matchedMarkets.size() << " matched markets" << std::endl;
+    if (!oddsGame) {
+        logLine("[TradingFinder] Warning: Could not find odds game for ID: " + oddsId);
+        return;
+    }
     
-    if (matchedMarkets.empty()) {
-        std::cout << "[TradingFinder] No matched markets found. Cannot analyze trading opportunities." << std::endl;
-        return opportunities;
+    // Read the market captured by the matching stage, refetching only if its prices are stale
+    const MatchedMarket* matched = snapshotMarket(*oddsGame);
+    
+    if (!matched) {
+        logLine("[TradingFinder] Warning: Could not fetch Polymarket market for game: " + oddsId);
+        return;
     }
+    const std::string& slug = matched->slug;
+    const MarketRecord* polymarketMarket = &matched->market;
+    std::string marketId = polymarketMarket->idText();
     
-    for (const auto& match : matchedMarkets) {
-        const std::string& polymarketId = match.first;
-        const std::string& oddsId = match.second;
-        
-        // Find the corresponding odds game
-        const polymarket_bot::common::RawOddsGame* oddsGame = nullptr;
-        for (const auto& game : oddsGames) {
-            if (game.id == oddsId) {
-                oddsGame = &game;
-                break;
+    // The whole evaluation goes out as one block so resolver threads cannot split it
+    std::ostringstream report;
+    report << "\n[TradingFinder] Analyzing: " << oddsGame->away_team << " vs " << oddsGame->home_team << std::endl;
+    report << "Polymarket Market ID: " << (polymarketMarket->id ? marketId : "unknown") << std::endl;
+    
+    namespace interned = polymarket_bot::common::interned;
+    auto& interner = polymarket_bot::common::StringInterner::getInstance();
+    struct PricedOutcome {
+        polymarket_bot::common::StringInterner::Id name;
+        double price;
+    };
+    
+    // Polymarket outcomes and prices, decoded when the market was ingested
+    std::vector<PricedOutcome> polyOutcomes;
+    if (polymarketMarket->outcomeError != polymarket_bot::api::OutcomeError::None) {
+        report << "[TradingFinder] Unusable Polymarket outcomes: "
+                  << polymarket_bot::api::outcomeErrorName(polymarketMarket->outcomeError) << std::endl;
+    }
+    for (size_t i = 0; i < polymarketMarket->outcomeCount; ++i) {
+        PricedOutcome outcome{polymarketMarket->outcomes[i].name, polymarketMarket->outcomes[i].price};
+        // Live asks from the market channel replace the polled outcomePrices where available
+        if (marketFeed && polymarketMarket->outcomes[i].tokenId) {
+            auto quote = marketFeed->quote(std::string(polymarketMarket->tokenId(i)));
+            if (quote && quote->bestAsk) {
+                report << "[TradingFinder] " << polymarketMarket->outcomeName(i) << ": live ask " << *quote->bestAsk
+                          << " (polled " << outcome.price << ")" << std::endl;
+                outcome.price = *quote->bestAsk;
             }
         }
-        
-        if (!oddsGame) {
-            std::cout << "[TradingFinder] Warning: Could not find odds game for ID: " << oddsId << std::endl;
-            continue;
-        }
-        
-        // Fetch the Polymarket market data
-        std::string slug = generateSlugForGame(*oddsGame);
-        auto polymarketMarket = fetchMarketBySlug(slug);
-        
-        if (!polymarketMarket.has_value()) {
-            std::cout << "[TradingFinder] Warning: Could not fetch Polymarket market for slug: " << slug << std::endl;
-            continue;
-        }
-        
-        std::cout << "\n[TradingFinder] Analyzing: " << oddsGame->away_team << " vs " << oddsGame->home_team << std::endl;
-        std::cout << "Polymarket Market ID: " << (polymarketMarket->id ? *polymarketMarket->id : "unknown") << std::endl;
-        
-        // Parse Polymarket outcomes and prices
-        std::vector<std::pair<std::string, double>> polyOutcomes;
-        if (polymarketMarket->outcomes && polymarketMarket->outcomePrices) {
-            try {
-                auto outcomesJson = nlohmann::json::parse(*polymarketMarket->outcomes);
-                auto pricesJson = nlohmann::json::parse(*polymarketMarket->outcomePrices);
-                
-                if (outcomesJson.is_array() && pricesJson.is_array() && 
-                    outcomesJson.size() == pricesJson.size()) {
-                    
-                    for (size_t i = 0; i < outcomesJson.size(); ++i) {
-                        std::string outcome = outcomesJson[i].get<std::string>();
-                        double price;
-                        if (pricesJson[i].is_string()) {
-                            price = std::stod(pricesJson[i].get<std::string>());
-                        } else {
-                            price = pricesJson[i].get<double>();
-                        }
-                        polyOutcomes.emplace_back(outcome, price);
+        polyOutcomes.push_back(outcome);
+    }
+    
+    // Parse Odds outcomes - prefer Pinnacle, fallback to others
+    std::vector<PricedOutcome> oddsOutcomes;
+    bool foundPinnacle = false;
+    const auto pinnacle = interned::bookmaker(polymarket_bot::common::SportsBook::PINNACLE);
+    
+    // First pass: look for Pinnacle
+    for (const auto& bookmaker : oddsGame->bookmakers) {
+        if (bookmaker.keyId == pinnacle) {
+            for (const auto& market : bookmaker.markets) {
+                if (market.keyId == interned::h2h) {  // Head-to-head markets
+                    for (const auto& outcome : market.outcomes) {
+                        oddsOutcomes.push_back({outcome.nameId, outcome.price});
                     }
+                    foundPinnacle = true;
+                    break;
                 }
-            } catch (const std::exception& e) {
-                std::cout << "[TradingFinder] Error parsing Polymarket data: " << e.what() << std::endl;
             }
+            if (foundPinnacle) break;
         }
-        
-        // Parse Odds outcomes - prefer Pinnacle, fallback to others
-        std::vector<std::pair<std::string, double>> oddsOutcomes;
-        bool foundPinnacle = false;
-        
-        // First pass: look for Pinnacle
+    }
+    
+    // Second pass: if no Pinnacle, use the first other book in the response (oddsApi.extraBookmakers)
+    if (!foundPinnacle) {
         for (const auto& bookmaker : oddsGame->bookmakers) {
-            if (bookmaker.key == "pinnacle") {
-                for (const auto& market : bookmaker.markets) {
-                    if (market.key == "h2h") {  // Head-to-head markets
-                        for (const auto& outcome : market.outcomes) {
-                            oddsOutcomes.emplace_back(outcome.name, outcome.price);
-                        }
-                        foundPinnacle = true;
-                        break;
-                    }
-                }
-                if (foundPinnacle) break;
-            }
-        }
-        
-        // Second pass: if no Pinnacle, use first available bookmaker
-        if (!foundPinnacle) {
-            for (const auto& bookmaker : oddsGame->bookmakers) {
-                for (const auto& market : bookmaker.markets) {
-                    if (market.key == "h2h") {  // Head-to-head markets
-                        for (const auto& outcome : market.outcomes) {
-                            oddsOutcomes.emplace_back(outcome.name, outcome.price);
-                        }
-                        std::cout << "[TradingFinder] Using " << bookmaker.key 
-                                  << " odds (Pinnacle not available)" << std::endl;
-                        break;
+            for (const auto& market : bookmaker.markets) {
+                if (market.keyId == interned::h2h) {  // Head-to-head markets
+                    for (const auto& outcome : market.outcomes) {
+                        oddsOutcomes.push_back({outcome.nameId, outcome.price});
                     }
+                    report << "[TradingFinder] Using " << bookmaker.key 
+                              << " odds (Pinnacle not available)" << std::endl;
+                    break;
                 }
-                if (!oddsOutcomes.empty()) break;
             }
-        } else {
-            std::cout << "[TradingFinder] Using Pinnacle odds" << std::endl;
-        }
-        
-        if (oddsOutcomes.empty()) {
-            std::cout << "[TradingFinder] Warning: No odds outcomes found" << std::endl;
-            continue;
+            if (!oddsOutcomes.empty()) break;
         }
-        
-        std::cout << "[TradingFinder] Found " << polyOutcomes.size() << " Polymarket outcomes and " 
-                  << oddsOutcomes.size() << " Odds outcomes" << std::endl;
-        
-        // Simple outcome matching based on team names
-        for (const auto& polyOutcome : polyOutcomes) {
-            for (const auto& oddsOutcome : oddsOutcomes) {
-                // Simple matching - check if team names are similar
-                std::string polyTeam = polyOutcome.first;
-                std::string oddsTeam = oddsOutcome.first;
+    } else {
+        report << "[TradingFinder] Using Pinnacle odds" << std::endl;
+    }
+    
+    if (oddsOutcomes.empty()) {
+        report << "[TradingFinder] Warning: No odds outcomes found" << std::endl;
+        logBlock(report.str());
+        return;
+    }
+    
+    report << "[TradingFinder] Found " << polyOutcomes.size() << " Polymarket outcomes and " 
+              << oddsOutcomes.size() << " Odds outcomes" << std::endl;
+    
+    // Simple outcome matching based on team names
+    for (const auto& polyOutcome : polyOutcomes) {
+        for (const auto& oddsOutcome : oddsOutcomes) {
+            if (teamsMatch(polyOutcome.name, oddsOutcome.name)) {
+                double polyProb = calculatePolymarketProbability(polyOutcome.price);
+                double oddsProb = calculateImpliedProbability(oddsOutcome.price);
+                double edge = calculateEdge(polyProb, oddsProb);
                 
-                // Normalize team names for comparison
-                std::transform(polyTeam.begin(), polyTeam.end(), polyTeam.begin(), ::tolower);
-                std::transform(oddsTeam.begin(), oddsTeam.end(), oddsTeam.begin(), ::tolower);
+                report << "[TradingFinder] MATCH FOUND:" << std::endl;
+                report << "  Polymarket: " << interner.view(polyOutcome.name) << " @ " << polyOutcome.price 
+                          << " (implied prob: " << (polyProb * 100) << "%)" << std::endl;
+                report << "  Odds: " << interner.view(oddsOutcome.name) << " @ " << oddsOutcome.price 
+                          << " (implied prob: " << (oddsProb * 100) << "%)" << std::endl;
+                report << "  Edge: " << (edge * 100) << "%" << std::endl;
                 
-                // Remove common words
-                std::vector<std::string> commonWords = {"team", "the", "and", "&"};
-                for (const auto& word : commonWords) {
-                    size_t pos = polyTeam.find(word);
-                    if (pos != std::string::npos) {
-                        polyTeam.erase(pos, word.length());
-                    }
-                    pos = oddsTeam.find(word);
-                    if (pos != std::string::npos) {
-                        oddsTeam.erase(pos, word.length());
-                    }
-                }
+                // Create trading opportunity
+                ArbitrageOpportunity opp;
+                opp.polymarketId = marketId;
+                opp.polymarketSlug = slug;
+                opp.oddsId = oddsId;
+                opp.oddsGame = oddsGame->away_team + " vs " + oddsGame->home_team;
+                opp.outcome = std::string(interner.view(polyOutcome.name));
+                opp.polymarketPrice = polyOutcome.price;
+                opp.oddsPrice = oddsOutcome.price;
+                opp.edge = edge;
+                opp.impliedProbability = polyProb + oddsProb;
+                opp.recommendedAction = determineRecommendedAction(polyProb, oddsProb);
+                opp.recommendedStake = calculateOptimalStake(edge, report);
                 
-                // Check if teams match (simple substring matching)
-                bool teamsMatch = false;
-                if (polyTeam.find(oddsTeam) != std::string::npos || 
-                    oddsTeam.find(polyTeam) != std::string::npos) {
-                    teamsMatch = true;
+                // Only add opportunities that involve Polymarket trading
+                if (opp.recommendedAction != "NO_TRADE") {
+                    opportunities.push_back(opp);
                 }
                 
-                if (teamsMatch) {
-                    double polyProb = calculatePolymarketProbability(polyOutcome.second);
-                    double oddsProb = calculateImpliedProbability(oddsOutcome.second);
-                    double edge = calculateEdge(polyProb, oddsProb);
-                    
-                    std::cout << "[TradingFinder] MATCH FOUND:" << std::endl;
-                    std::cout << "  Polymarket: " << polyOutcome.first << " @ " << polyOutcome.second 
-                              << " (implied prob: " << (polyProb * 100) << "%)" << std::endl;
-                    std::cout << "  Odds: " << oddsOutcome.first << " @ " << oddsOutcome.second 
-                              << " (implied prob: " << (oddsProb * 100) << "%)" << std::endl;
-                    std::cout << "  Edge: " << (edge * 100) << "%" << std::endl;
-                    
-                    // Create trading opportunity
-                    ArbitrageOpportunity opp;
-                    opp.polymarketId = polymarketMarket->id ? *polymarketMarket->id : "";
-                    opp.polymarketSlug = slug;
-                    opp.oddsId = oddsId;
-                    opp.oddsGame = oddsGame->away_team + " vs " + oddsGame->home_team;
-                    opp.outcome = polyOutcome.first;
-                    opp.polymarketPrice = polyOutcome.second;
-                    opp.oddsPrice = oddsOutcome.second;
-                    opp.edge = edge;
-                    opp.impliedProbability = polyProb + oddsProb;
-                    opp.recommendedAction = determineRecommendedAction(polyProb, oddsProb);
-                    opp.recommendedStake = calculateOptimalStake(edge);
-                    
-                    // Only add opportunities that involve Polymarket trading
-                    if (opp.recommendedAction != "NO_TRADE") {
-                        opportunities.push_back(opp);
-                    }
-                    
-                    // Only include opportunities that involve Polymarket trading
-                    if (opp.recommendedAction != "NO_TRADE") {
-                        if (edge >= minEdge) {
-                            std::cout << "  *** POLYMARKET TRADING OPPORTUNITY DETECTED ***" << std::endl;
-                            std::cout << "  Market: " << opp.polymarketSlug << std::endl;
-                            std::cout << "  Game: " << opp.oddsGame << std::endl;
-                            std::cout << "  Recommended Action: " << opp.recommendedAction << std::endl;
-                            std::cout << "  Recommended Stake: $" << opp.recommendedStake << std::endl;
-                        } else {
-                            std::cout << "  Edge too small (min required: " << (minEdge * 100) << "%)" << std::endl;
-                        }
+                // Only include opportunities that involve Polymarket trading
+                if (opp.recommendedAction != "NO_TRADE") {
+                    if (edge >= minEdge) {
+                        report << "  *** POLYMARKET TRADING OPPORTUNITY DETECTED ***" << std::endl;
+                        report << "  Market: " << opp.polymarketSlug << std::endl;
+                        report << "  Game: " << opp.oddsGame << std::endl;
+                        report << "  Recommended Action: " << opp.recommendedAction << std::endl;
+                        report << "  Recommended Stake: $" << opp.recommendedStake << std::endl;
                     } else {
-                        std::cout << "  No clear trading edge - skipping" << std::endl;
+                        report << "  Edge too small (min required: " << (minEdge * 100) << "%)" << std::endl;
                     }
-                    std::cout << std::endl;
+                } else {
+                    report << "  No clear trading edge - skipping" << std::endl;
                 }
+                report << std::endl;
             }
         }
     }
+    logBlock(report.str());
+}
+
+bool MarketMatcher::teamsMatch(polymarket_bot::common::StringInterner::Id polyName,
+                               polymarket_bot::common::StringInterner::Id oddsName)
+{
+    uint64_t key = static_cast<uint64_t>(polyName) << 32 | oddsName;
+    auto cached = teamMatches.find(key);
+    if (cached != teamMatches.end()) {
+        return cached->second;
+    }
+    auto& interner = polymarket_bot::common::StringInterner::getInstance();
+    bool match = teamNamesMatch(std::string(interner.view(polyName)), std::string(interner.view(oddsName)));
+    teamMatches.emplace(key, match);
+    return match;
+}
+
+// Simple matching - check if team names are similar
+bool MarketMatcher::teamNamesMatch(std::string polyTeam, std::string oddsTeam)
+{
+    // Normalize team names for comparison
+    std::transform(polyTeam.begin(), polyTeam.end(), polyTeam.begin(), ::tolower);
+    std::transform(oddsTeam.begin(), oddsTeam.end(), oddsTeam.begin(), ::tolower);
+    
+    // Remove common words
+    std::vector<std::string> commonWords = {"team", "the", "and", "&"};
+    for (const auto& word : commonWords) {
+        size_t pos = polyTeam.find(word);
+        if (pos != std::string::npos) {
+            polyTeam.erase(pos, word.length());
+        }
+        pos = oddsTeam.find(word);
+        if (pos != std::string::npos) {
+            oddsTeam.erase(pos, word.length());
+        }
+    }
+    
+    // Check if teams match (simple substring matching)
+    return polyTeam.find(oddsTeam) != std::string::npos || 
+           oddsTeam.find(polyTeam) != std::string::npos;
+}
+
+// CLOB token ids in outcome order
+std::vector<std::string> MarketMatcher::clobTokens(const MarketRecord& market)
+{
+    std::vector<std::string> tokens;
+    for (size_t i = 0; i < market.outcomeCount; ++i) {
+        if (market.outcomes[i].tokenId) {
+            tokens.emplace_back(market.tokenId(i));
+        }
+    }
+    return tokens;
+}
+
+bool MarketMatcher::hasLiveQuotes(const MarketRecord& market) const
+{
+    if (!marketFeed || !marketFeed->isConnected()) {
+        return false;
+    }
+    auto tokens = clobTokens(market);
+    for (const auto& token : tokens) {
+        auto quote = marketFeed->quote(token);
+        if (!quote || !quote->bestAsk) {
+            return false;
+        }
+    }
+    return !tokens.empty();
+}
+
+void MarketMatcher::setMarketFeed(std::shared_ptr<polymarket_bot::api::ClobMarketFeed> feed)
+{
+    marketFeed = std::move(feed);
+}
+
+// Subscribe the tokens of every matched market and remember which game each belongs to
+void MarketMatcher::subscribeMatched()
+{
+    if (!marketFeed) {
+        return;
+    }
+    std::vector<std::string> tokens;
+    for (const auto& entry : matchedSnapshot) {
+        for (const auto& token : clobTokens(entry.second.market)) {
+            gameByToken[token] = entry.first;
+            tokens.push_back(token);
+        }
+    }
+    marketFeed->subscribe(tokens);
+}
+
+std::vector<ArbitrageOpportunity> MarketMatcher::reevaluateChanged(double minEdge)
+{
+    std::vector<ArbitrageOpportunity> opportunities;
+    if (!marketFeed) {
+        return opportunities;
+    }
+
+    std::unordered_set<std::string> games;
+    for (const auto& token : marketFeed->takeChanged()) {
+        auto it = gameByToken.find(token);
+        if (it != gameByToken.end()) {
+            games.insert(it->second);
+        }
+    }
+    if (games.empty()) {
+        return opportunities;
+    }
+
+    std::cout << "[TradingFinder] Live prices moved for " << games.size() << " markets, re-evaluating them" << std::endl;
+    for (const auto& match : lastMatches) {
+        if (games.count(match.second)) {
+            evaluateMatch(match, minEdge, opportunities);
+        }
+    }
+    return opportunities;
+}
+
+std::vector<ArbitrageOpportunity> MarketMatcher::findArbitrageOpportunities(double minEdge) {
+    std::cout << "[TradingFinder] Starting Polymarket trading opportunity analysis..." << std::endl;
+    
+    std::vector<ArbitrageOpportunity> opportunities;
+    
+    // Get matched markets using slug-based matching
+    auto matchedMarkets = matchMarketsBySlug();
+    std::cout << "[TradingFinder] Found " << matchedMarkets.size() << " matched markets" << std::endl;
+    lastMatches = matchedMarkets;
+    subscribeMatched();
+    if (marketFeed) {
+        // Every market is evaluated below, so earlier price moves are already covered
+        marketFeed->takeChanged();
+    }
+    
+    if (matchedMarkets.empty()) {
+        std::cout << "[TradingFinder] No matched markets found. Cannot analyze trading opportunities." << std::endl;
+        return opportunities;
+    }
+    
+    for (const auto& match : matchedMarkets) {
+        evaluateMatch(match, minEdge, opportunities);
+    }
     
     std::cout << "[TradingFinder] Analysis complete. Found " << opportunities.size() 
               << " trading opportunities (Polymarket-only)" << std::endl;
     
     return opportunities;
 }
+
+// Replace the listings of the given games with current odds; other games keep their last listing
+void MarketMatcher::refreshGames(const std::map<std::string, std::vector<std::string>>& gameIdsBySport)
+{
+    auto fresh = oddsClient.fetchOddsForEvents(gameIdsBySport);
+    
+    std::unordered_map<std::string, size_t> indexById;
+    for (size_t i = 0; i < oddsGames.size(); ++i) {
+        indexById[oddsGames[i].id] = i;
+    }
+    std::unordered_set<std::string> returned;
+    for (auto& game : fresh) {
+        returned.insert(game.id);
+        auto it = indexById.find(game.id);
+        if (it != indexById.end()) {
+            oddsGames[it->second] = std::move(game);
+        } else {
+            indexById[game.id] = oddsGames.size();
+            oddsGames.push_back(std::move(game));
+        }
+    }
+    
+    // A game missing from a successful response has started or been pulled; a failed request proves nothing
+    std::unordered_set<std::string> dropped;
+    for (const auto& timing : oddsClient.getLastFetchTimings()) {
+        auto requested = gameIdsBySport.find(timing.sport);
+        if (!timing.ok || requested == gameIdsBySport.end()) {
+            continue;
+        }
+        for (const auto& id : requested->second) {
+            if (!returned.count(id)) {
+                dropped.insert(id);
+            }
+        }
+    }
+    if (!dropped.empty()) {
+        oddsGames.erase(std::remove_if(oddsGames.begin(), oddsGames.end(),
+                                       [&](const auto& game) { return dropped.count(game.id) > 0; }),
+                        oddsGames.end());
+        for (const auto& id : dropped) {
+            matchedSnapshot.erase(id);
+        }
+        lastMatches.erase(std::remove_if(lastMatches.begin(), lastMatches.end(),
+                                         [&](const auto& match) { return dropped.count(match.second) > 0; }),
+                          lastMatches.end());
+    }
+}
+
+// Current Gamma prices for already matched games, one slug request each, all in flight together.
+// The Gamma snapshot is only as fresh as its last refresh, so these bypass it.
+void MarketMatcher::refreshMatchedPrices(const std::vector<std::string>& gameIds)
+{
+    std::vector<std::pair<std::string, std::string>> targets;   // Odds game id, market slug
+    std::vector<polymarket_bot::api::Task<polymarket_bot::api::HttpResponse>> requests;
+    for (const auto& id : gameIds) {
+        auto it = matchedSnapshot.find(id);
+        if (it == matchedSnapshot.end()) {
+            continue;
+        }
+        std::string slug = it->second.market.slug ? it->second.market.slugText() : it->second.slug;
+        targets.emplace_back(id, slug);
+        requests.push_back(fetchSlug(slug));
+    }
+    auto responses = polymarket_bot::api::syncWait(polymarket_bot::api::whenAll(std::move(requests)));
+    
+    for (size_t i = 0; i < targets.size(); ++i) {
+        const auto& response = responses[i];
+        auto it = matchedSnapshot.find(targets[i].first);
+        bool answered = false;
+        auto fresh = parseSlugResponse(targets[i].second, response, answered);
+        if (fresh.has_value()) {
+            it->second.market = std::move(*fresh);
+            it->second.fetchedAt = std::chrono::steady_clock::now();
+        } else if (answered) {
+            logLine("[MarketMatcher] Market " + targets[i].second + " is no longer listed");
+            matchedSnapshot.erase(it);
+        }
+        // On a failed request the previous prices stay, and snapshotMarket refetches them once stale
+    }
+}
+
+std::vector<ArbitrageOpportunity> MarketMatcher::findOpportunitiesForGames(const std::vector<std::string>& gameIds,
+                                                                          double minEdge) {
+    std::vector<ArbitrageOpportunity> opportunities;
+    
+    std::unordered_map<std::string, size_t> indexById;
+    for (size_t i = 0; i < oddsGames.size(); ++i) {
+        indexById[oddsGames[i].id] = i;
+    }
+    
+    // Unmatched games get another matching attempt; matched ones priced from Gamma get current prices
+    std::vector<size_t> unmatched;
+    std::vector<std::string> gammaPriced;
+    for (const auto& id : gameIds) {
+        auto game = indexById.find(id);
+        if (game == indexById.end()) {
+            continue;
+        }
+        auto matched = matchedSnapshot.find(id);
+        if (matched == matchedSnapshot.end()) {
+            unmatched.push_back(game->second);
+        } else if (!hasLiveQuotes(matched->second.market)) {
+            gammaPriced.push_back(id);
+        }
+    }
+    
+    auto newMatches = matchGames(unmatched);
+    refreshMatchedPrices(gammaPriced);
+    if (!newMatches.empty()) {
+        lastMatches.insert(lastMatches.end(), newMatches.begin(), newMatches.end());
+        subscribeMatched();
+    }
+    
+    for (const auto& id : gameIds) {
+        auto matched = matchedSnapshot.find(id);
+        if (matched != matchedSnapshot.end() && matched->second.market.id) {
+            evaluateMatch({matched->second.market.idText(), id}, minEdge, opportunities);
+        }
+    }
+    
+    std::cout << "[TradingFinder] Re-priced " << gameIds.size() << " scheduled games, found " << opportunities.size()
+              << " trading opportunities" << std::endl;
+    
+    return opportunities;
+}
+
+void MarketMatcher::scanPipelined(double minEdge, const polymarket_bot::api::Deadline& deadline,
+                                  const std::function<void(const ArbitrageOpportunity&)>& onOpportunity) {
+    using polymarket_bot::common::RawOddsGame;
+    std::cout << "[TradingFinder] Starting pipelined scan..." << std::endl;
+    
+    auto sports = configManager.getSports();
+    oddsGames.clear();
+    matchedSnapshot.clear();
+    lastMatches.clear();
+    if (marketFeed) {
+        // Every market is evaluated below, so earlier price moves are already covered
+        marketFeed->takeChanged();
+    }
+    requestDeadline = deadline;
+    pipelineRunning = true;
+    
+    // The Gamma snapshot pages in while the odds download; the match stage waits for it. The refresh blocks on
+    // its page futures, so it gets its own thread rather than a pool worker the coroutines resume on.
+    // Its pages carry the scan deadline, so it cannot run past the scan budget either
+    std::shared_future<void> universeReady = std::async(std::launch::async, [this, &sports, deadline]() {
+        if (configManager.useGammaSnapshot() && !sports.empty()) {
+            gammaUniverse.refresh(maxConcurrentRequests, 500, 200, deadline);
+        }
+    }).share();
+    auto waitForUniverse = [&universeReady, &deadline]() {
+        if (!deadline.isSet()) {
+            universeReady.wait();
+            return true;
+        }
+        return universeReady.wait_until(deadline.time()) == std::future_status::ready;
+    };
+    
+    struct SportResponse {
+        std::string sport;
+        std::string url;
+        polymarket_bot::api::HttpResponse response;
+        long long fetchMs = 0;
+    };
+    struct ResolvedGame {
+        RawOddsGame game;
+        std::string slug;
+        std::optional<MarketRecord> market;
+    };
+    
+    size_t capacity = static_cast<size_t>(configManager.getPipelineQueueCapacity());
+    polymarket_bot::common::Pipeline pipeline;
+    auto responses = pipeline.queue<SportResponse>("responses", capacity);
+    auto games = pipeline.queue<RawOddsGame>("games", capacity);
+    auto resolved = pipeline.queue<ResolvedGame>("matched", capacity);
+    auto opportunities = pipeline.queue<ArbitrageOpportunity>("opportunities", capacity);
+    
+    // Every sport in flight at once, handed on in the order the responses land
+    pipeline.source<SportResponse>("fetch", 1, responses, [&](const auto& emit) {
+        auto requests = oddsClient.buildOddsRequests(sports);
+        std::mutex landedMutex;
+        std::condition_variable landedCv;
+        std::deque<SportResponse> landed;
+        auto submitted = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < requests.size(); ++i) {
+            std::string url = requests[i].url;
+            requests[i].deadline = deadline;
+            polymarket_bot::api::AsyncHttpEngine::getInstance().submit(
+                std::move(requests[i]), [&, i, url](polymarket_bot::api::HttpResponse response) {
+                    auto fetchMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - submitted).count();
+                    std::lock_guard<std::mutex> lock(landedMutex);
+                    landed.push_back({sports[i], url, std::move(response), fetchMs});
+                    landedCv.notify_one();
+                });
+        }
+        for (size_t n = 0; n < requests.size(); ++n) {
+            std::unique_lock<std::mutex> lock(landedMutex);
+            landedCv.wait(lock, [&]() { return !landed.empty(); });
+            SportResponse next = std::move(landed.front());
+            landed.pop_front();
+            lock.unlock();
+            emit(std::move(next));
+        }
+    });
+    
+    pipeline.stage<SportResponse, RawOddsGame>("parse", std::max<size_t>(1, sports.size()), responses, games,
+                                               [&](SportResponse landed, const auto& emit) {
+        polymarket_bot::api::SportFetchTiming timing;
+        timing.sport = landed.sport;
+        timing.fetchMs = landed.fetchMs;
+        auto parsed = oddsClient.parseSportResponse(landed.url, landed.response, timing);
+        {
+            std::lock_guard<std::mutex> lock(coutMutex);
+            polymarket_bot::api::OddsApiClient::logTiming(timing);
+        }
+        for (auto& game : parsed) {
+            emit(std::move(game));
+        }
+    });
+    
+    int matchWorkers = configManager.isParallelSlugResolution() ? maxConcurrentRequests : 1;
+    pipeline.stage<RawOddsGame, ResolvedGame>("match", static_cast<size_t>(std::max(1, matchWorkers)), games, resolved,
+                                              [&](RawOddsGame game, const auto& emit) {
+        ResolvedGame result;
+        result.slug = generateSlugForGame(game);
+        if (result.slug.empty()) {
+            logLine("[MarketMatcher] Skipping game: " + game.away_team + " vs " + game.home_team +
+                    " (unsupported sport or missing team mapping)");
+        } else if (deadline.expired()) {
+            logLine("[MarketMatcher] Out of scan time, not matching: " + result.slug);
+        } else if (!waitForUniverse()) {
+            logLine("[MarketMatcher] Out of scan time waiting for the Gamma snapshot, not matching: " + result.slug);
+        } else {
+            result.market = fetchMarketBySlug(result.slug);
+        }
+        result.game = std::move(game);
+        emit(std::move(result));
+    });
+    
+    // One worker: this stage alone touches oddsGames, the matched snapshot and lastMatches while the pipeline runs
+    pipeline.stage<ResolvedGame, ArbitrageOpportunity>("price", 1, resolved, opportunities,
+                                                       [&](ResolvedGame game, const auto& emit) {
+        oddsGames.push_back(game.game);
+        if (game.slug.empty()) {
+            return;
+        }
+        if (!game.market.has_value() || !game.market->id) {
+            logLine("[MarketMatcher] ✗ No market found for slug: " + game.slug);
+            return;
+        }
+        std::pair<std::string, std::string> match{game.market->idText(), game.game.id};
+        logLine("[MarketMatcher] ✓ Matched: " + game.slug + " -> " + match.first);
+        matchedSnapshot[game.game.id] = {std::move(*game.market), game.slug, std::chrono::steady_clock::now()};
+        lastMatches.push_back(match);
+        
+        std::vector<ArbitrageOpportunity> found;
+        evaluateMatch(match, minEdge, found);
+        for (auto& opportunity : found) {
+            emit(std::move(opportunity));
+        }
+    });
+    
+    size_t handed = 0;
+    pipeline.sink<ArbitrageOpportunity>("execute", 1, opportunities, [&](ArbitrageOpportunity opportunity) {
+        handed++;
+        onOpportunity(opportunity);
+    });
+    
+    pipeline.run();
+    // The refresh thread writes into this matcher, so it is joined here even past the deadline; its page
+    // requests are cut off at the deadline, so this returns promptly
+    universeReady.wait();
+    pipelineRunning = false;
+    requestDeadline = polymarket_bot::api::Deadline::never();
+    
+    subscribeMatched();
+    std::cout << "[TradingFinder] Pipelined scan complete. Matched " << lastMatches.size() << " out of "
+              << oddsGames.size() << " games, found " << handed << " trading opportunities (Polymarket-only)"
+              << std::endl;
+    slugCache.logStats();
+    pipeline.logStats();
+}
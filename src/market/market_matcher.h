@@ -5,17 +5,24 @@
 #include <utility>
 #include <cstdlib>
 #include <cmath>
-#include <curl/curl.h>
-#include <thread>
 #include <mutex>
-#include <future>
 #include <queue>
 #include <map>
+#include <chrono>
+#include <functional>
+#include <iosfwd>
 #include <unordered_map>
+#include <unordered_set>
 #include "nlohmann/json.hpp"
 
 #include "api/odds_api_client.h"
 #include "api/polymarket_api_client.h"
+#include "api/http_transport.h"
+#include "api/coro_task.h"
+#include "api/clob_market_feed.h"
+#include "market/gamma_universe.h"
+#include "market/market_store.h"
+#include "market/slug_lookup_cache.h"
 #include "config/config_manager.h"
 #include "common/types.h"
 
@@ -49,16 +56,45 @@ private:
     const polymarket_bot::config::ConfigManager &configManager;
 
     std::vector<polymarket_bot::common::RawOddsGame> oddsGames;
-    std::vector<polymarket_bot::common::GammaMarket> gammaMarkets;
+    GammaUniverse gammaUniverse;  // Bulk snapshot used when matching.useGammaSnapshot is on
+    SlugLookupCache slugCache;    // Negative results and learned variant order, kept across scans
+    polymarket_bot::api::Deadline requestDeadline;   // Applied to slug requests; set for a pipelined scan
+    bool pipelineRunning = false;   // Match workers read gammaUniverse, so nothing may refresh it until the scan ends
+    
+    // Markets captured by the matching stage and read by the pricing stage, keyed by odds game id
+    struct MatchedMarket {
+        MarketRecord market;
+        std::string slug;
+        std::chrono::steady_clock::time_point fetchedAt;
+    };
+    std::unordered_map<std::string, MatchedMarket> matchedSnapshot;
+    const MatchedMarket* snapshotMarket(const polymarket_bot::common::RawOddsGame& game);
+
+    // Live best bid/ask from the CLOB market channel (optional)
+    std::shared_ptr<polymarket_bot::api::ClobMarketFeed> marketFeed;
+    std::unordered_map<std::string, std::string> gameByToken;       // CLOB token -> odds game id
+    std::vector<std::pair<std::string, std::string>> lastMatches;   // From the last full scan
+    static std::vector<std::string> clobTokens(const MarketRecord& market);
+    bool hasLiveQuotes(const MarketRecord& market) const;
+    void subscribeMatched();
+    void evaluateMatch(const std::pair<std::string, std::string>& match, double minEdge,
+                       std::vector<ArbitrageOpportunity>& opportunities);
+    // Outcome-name comparison, memoized per (Polymarket, odds) name id pair; pricing stage only
+    std::unordered_map<uint64_t, bool> teamMatches;
+    bool teamsMatch(polymarket_bot::common::StringInterner::Id polyName,
+                    polymarket_bot::common::StringInterner::Id oddsName);
+    static bool teamNamesMatch(std::string polyTeam, std::string oddsTeam);
 
     // Threading support
     std::mutex coutMutex;
-    int maxConcurrentRequests;
+    int maxConcurrentRequests;  // From matching.maxConcurrentRequests
+    void logLine(const std::string& line);
+    void logBlock(const std::string& lines);
     
-    // Team mappings for slug generation
-    std::unordered_map<std::string, TeamMapping> nbaTeams;
-    std::unordered_map<std::string, TeamMapping> nhlTeams;
-    std::unordered_map<std::string, TeamMapping> mlbTeams;
+    // Team mappings for slug generation, keyed by the interned odds API team name
+    std::unordered_map<polymarket_bot::common::StringInterner::Id, TeamMapping> nbaTeams;
+    std::unordered_map<polymarket_bot::common::StringInterner::Id, TeamMapping> nhlTeams;
+    std::unordered_map<polymarket_bot::common::StringInterner::Id, TeamMapping> mlbTeams;
     
     // Date helpers
     static std::string dateOnly(const std::string &iso);
@@ -69,13 +105,9 @@ private:
     static std::string normalizeText(const std::string &text);
     static std::string slugToQuestion(const std::string &slug);
 
-    // libcurl write callback
-    static size_t writeCallback(void *contents,
-                                size_t size,
-                                size_t nmemb,
-                                void *userp);
-
     // Embedding & similarity
+    static polymarket_bot::api::HttpRequest buildEmbeddingRequest(const nlohmann::json &input);
+    static std::vector<std::vector<double>> parseEmbeddingResponse(const polymarket_bot::api::HttpResponse &response);
     std::vector<double> getEmbedding(const std::string &text);
     std::vector<double> getEmbeddingWithLogging(const std::string &text, int index, int total);
     std::vector<std::vector<double>> getBatchEmbeddings(const std::vector<std::string> &texts);
@@ -88,16 +120,32 @@ private:
     static double calculatePolymarketProbability(double polymarketPrice);
     static double calculateEdge(double prob1, double prob2);
     static std::string determineRecommendedAction(double polymarketProb, double oddsProb);
-    static double calculateOptimalStake(double edge, double totalStake = 1000.0);
+    static double calculateOptimalStake(double edge, std::ostream& log, double totalStake = 1000.0);
 
     // New slug-based matching methods
     void initializeTeamMappings();
     std::string generateSlugForGame(const polymarket_bot::common::RawOddsGame& game);
     std::string findPolymarketMarketBySlug(const std::string& slug);
     std::vector<std::pair<std::string, std::string>> matchMarketsBySlug();
+    std::vector<std::pair<std::string, std::string>> matchGames(const std::vector<size_t>& indices);
+    void refreshMatchedPrices(const std::vector<std::string>& gameIds);
     
     // New method to fetch market by slug directly from API
-    std::optional<polymarket_bot::common::GammaMarket> fetchMarketBySlug(const std::string& slug);
+    std::optional<MarketRecord> fetchMarketBySlug(const std::string& slug);
+    polymarket_bot::api::Task<std::optional<MarketRecord>> resolveSlug(std::string slug);
+    polymarket_bot::api::Task<polymarket_bot::api::HttpResponse> fetchSlug(std::string slug);
+    
+    // In-memory lookup of a slug and its variants against the Gamma snapshot
+    std::optional<MarketRecord> lookupSnapshotBySlug(const std::string& slug);
+    
+    // Gamma slug lookup helpers
+    polymarket_bot::api::HttpRequest buildSlugRequest(const std::string& slug) const;
+    std::string slugUrl(const std::string& slug) const;
+    // answered is false unless Gamma returned a usable listing (200, or a 304 for a cached one)
+    std::optional<MarketRecord> parseSlugResponse(const std::string& slug,
+                                                  const polymarket_bot::api::HttpResponse& response,
+                                                  bool& answered);
+    static std::vector<std::string> slugCandidates(const std::string& slug);
 
 public:
     MarketMatcher(polymarket_bot::api::PolymarketApiClient polyClient,
@@ -110,6 +158,22 @@ public:
     // Find Polymarket trading opportunities (value betting)
     std::vector<ArbitrageOpportunity> findArbitrageOpportunities(double minEdge = 0.03);
     
+    // loadAll() and findArbitrageOpportunities() as one pipeline: each game is matched and priced as soon
+    // as its sport's odds land, and each opportunity goes to onOpportunity as soon as it is priced.
+    // No new games are taken on once `deadline` passes; work already handed to onOpportunity is never cut off.
+    void scanPipelined(double minEdge, const polymarket_bot::api::Deadline& deadline,
+                       const std::function<void(const ArbitrageOpportunity&)>& onOpportunity);
+    
+    // Price matched markets from a live market feed and subscribe their tokens on each scan
+    void setMarketFeed(std::shared_ptr<polymarket_bot::api::ClobMarketFeed> feed);
+    // Re-run the edge calculation only for markets whose live quotes moved since the last call
+    std::vector<ArbitrageOpportunity> reevaluateChanged(double minEdge = 0.03);
+    
+    // Scheduled polls: fetch current odds for a few games, then match and price only those
+    void refreshGames(const std::map<std::string, std::vector<std::string>>& gameIdsBySport);
+    std::vector<ArbitrageOpportunity> findOpportunitiesForGames(const std::vector<std::string>& gameIds,
+                                                                double minEdge = 0.03);
+    
     // Public access to slug-based matching for testing
     std::vector<std::pair<std::string, std::string>> testMatchMarketsBySlug() { return matchMarketsBySlug(); }
     
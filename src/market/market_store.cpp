@@ -0,0 +1,211 @@
+#include "market/market_store.h"
+
+#include <cstring>
+
+namespace {
+
+using polymarket_bot::common::StringInterner;
+
+int hexDigit(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// 0x followed by exactly 64 hex digits
+bool parseConditionId(std::string_view text, std::array<uint8_t, 32>& bytes)
+{
+    if (text.size() != 66 || text[0] != '0' || (text[1] != 'x' && text[1] != 'X')) {
+        return false;
+    }
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        int high = hexDigit(text[2 + 2 * i]);
+        int low = hexDigit(text[3 + 2 * i]);
+        if (high < 0 || low < 0) {
+            return false;
+        }
+        bytes[i] = static_cast<uint8_t>(high << 4 | low);
+    }
+    return true;
+}
+
+} // namespace
+
+MarketRecord MarketRecord::fromDecoded(const polymarket_bot::api::DecodedGammaMarket& decoded)
+{
+    auto& interner = StringInterner::getInstance();
+    const auto& market = decoded.market;
+    MarketRecord record;
+    if (market.id) {
+        record.id = interner.intern(*market.id);
+    }
+    if (market.slug) {
+        record.slug = interner.intern(*market.slug);
+    }
+    if (market.conditionId) {
+        record.hasConditionId = parseConditionId(*market.conditionId, record.conditionId);
+    }
+    record.bestBid = market.bestBid.value_or(record.bestBid);
+    record.bestAsk = market.bestAsk.value_or(record.bestAsk);
+    record.liquidity = market.liquidityNum.value_or(record.liquidity);
+
+    record.outcomeError = decoded.outcomeError;
+    if (record.outcomeError == polymarket_bot::api::OutcomeError::None && decoded.outcomes.size() > maxOutcomes) {
+        record.outcomeError = polymarket_bot::api::OutcomeError::TooMany;
+    }
+    if (record.outcomeError == polymarket_bot::api::OutcomeError::None) {
+        for (size_t i = 0; i < decoded.outcomes.size(); ++i) {
+            const auto& outcome = decoded.outcomes[i];
+            record.outcomes[i].name = interner.intern(outcome.name);
+            record.outcomes[i].tokenId = interner.intern(outcome.tokenId);
+            record.outcomes[i].price = outcome.price;
+        }
+        record.outcomeCount = static_cast<uint8_t>(decoded.outcomes.size());
+    }
+    return record;
+}
+
+std::string MarketRecord::idText() const
+{
+    return std::string(StringInterner::getInstance().view(id));
+}
+
+std::string MarketRecord::slugText() const
+{
+    return std::string(StringInterner::getInstance().view(slug));
+}
+
+std::string MarketRecord::conditionIdText() const
+{
+    if (!hasConditionId) {
+        return "";
+    }
+    static const char digits[] = "0123456789abcdef";
+    std::string text = "0x";
+    text.reserve(66);
+    for (uint8_t byte : conditionId) {
+        text += digits[byte >> 4];
+        text += digits[byte & 0x0F];
+    }
+    return text;
+}
+
+std::string_view MarketRecord::outcomeName(size_t index) const
+{
+    return index < outcomeCount ? StringInterner::getInstance().view(outcomes[index].name) : std::string_view();
+}
+
+std::string_view MarketRecord::tokenId(size_t index) const
+{
+    return index < outcomeCount ? StringInterner::getInstance().view(outcomes[index].tokenId) : std::string_view();
+}
+
+size_t MarketStore::ConditionIdHash::operator()(const std::array<uint8_t, 32>& id) const
+{
+    uint64_t prefix;
+    std::memcpy(&prefix, id.data(), sizeof(prefix));
+    return static_cast<size_t>(prefix);
+}
+
+void MarketStore::reserve(size_t count)
+{
+    hot.reserve(count);
+    cold.reserve(count);
+    bySlug.reserve(count);
+    byConditionId.reserve(count);
+    byTokenId.reserve(count * MarketRecord::maxOutcomes);
+}
+
+const MarketRecord& MarketStore::add(const polymarket_bot::api::DecodedGammaMarket& market)
+{
+    MarketRecord record = MarketRecord::fromDecoded(market);
+    auto existing = record.slug ? bySlug.find(record.slug) : bySlug.end();
+    uint32_t row;
+    if (existing != bySlug.end()) {
+        row = existing->second;
+        unindex(row);
+        cold[row] = market.raw;
+    } else {
+        row = static_cast<uint32_t>(hot.size());
+        hot.emplace_back();
+        cold.push_back(market.raw);
+    }
+    record.coldRow = row;
+    hot[row] = record;
+    index(row);
+    return hot[row];
+}
+
+void MarketStore::index(uint32_t row)
+{
+    const auto& record = hot[row];
+    if (record.slug) {
+        bySlug[record.slug] = row;
+    }
+    if (record.hasConditionId) {
+        byConditionId[record.conditionId] = row;
+    }
+    for (const auto& outcome : record.outcomes) {
+        if (outcome.tokenId) {
+            byTokenId[outcome.tokenId] = row;
+        }
+    }
+}
+
+void MarketStore::unindex(uint32_t row)
+{
+    const auto& record = hot[row];
+    bySlug.erase(record.slug);
+    if (record.hasConditionId) {
+        byConditionId.erase(record.conditionId);
+    }
+    for (const auto& outcome : record.outcomes) {
+        byTokenId.erase(outcome.tokenId);
+    }
+}
+
+const MarketRecord* MarketStore::findBySlug(std::string_view slug) const
+{
+    auto id = StringInterner::getInstance().find(slug);
+    if (!id) {
+        return nullptr;
+    }
+    auto it = bySlug.find(*id);
+    return it == bySlug.end() ? nullptr : &hot[it->second];
+}
+
+const MarketRecord* MarketStore::findByConditionId(std::string_view conditionId) const
+{
+    std::array<uint8_t, 32> bytes;
+    if (!parseConditionId(conditionId, bytes)) {
+        return nullptr;
+    }
+    auto it = byConditionId.find(bytes);
+    return it == byConditionId.end() ? nullptr : &hot[it->second];
+}
+
+const MarketRecord* MarketStore::findByTokenId(std::string_view tokenId) const
+{
+    auto id = StringInterner::getInstance().find(tokenId);
+    if (!id) {
+        return nullptr;
+    }
+    auto it = byTokenId.find(*id);
+    return it == byTokenId.end() ? nullptr : &hot[it->second];
+}
+
+std::optional<polymarket_bot::common::GammaMarket> MarketStore::coldFields(const MarketRecord& record) const
+{
+    // A record copied from another store may carry a row number that means something else here
+    if (record.coldRow >= cold.size() || hot[record.coldRow].slug != record.slug) {
+        return std::nullopt;
+    }
+    polymarket_bot::api::DecodedGammaMarket decoded;
+    decoded.raw = cold[record.coldRow];
+    if (decoded.raw.empty()) {
+        return std::nullopt;
+    }
+    return decoded.full();
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "api/gamma_market_decoder.h"
+#include "common/string_interner.h"
+#include "common/types.h"
+
+// The part of a Gamma market the matcher and pricing read on every scan.
+//
+// A GammaMarket is ~75 optionals, most of them heap strings, and runs to
+// several KB; a record is about 100 bytes with no heap of its own. Strings are
+// StringInterner ids (0 when Gamma did not send the field), the condition id
+// is its 32 raw bytes, and the outcomes come from the arrays the decoder
+// already read at ingestion, so pricing touches only ids and doubles.
+// Everything else stays in MarketStore's cold table. Records are plain values:
+// copies stay valid after the store they came from is gone.
+struct MarketRecord
+{
+    using Id = polymarket_bot::common::StringInterner::Id;
+    static constexpr size_t maxOutcomes = 2;    // CLOB markets are binary
+    static constexpr uint32_t noColdRow = std::numeric_limits<uint32_t>::max();
+
+    struct Outcome {
+        Id name = 0;
+        Id tokenId = 0;     // 0 if the market lists no CLOB tokens
+        double price = 0.0;
+    };
+
+    std::array<uint8_t, 32> conditionId{};
+    std::array<Outcome, maxOutcomes> outcomes{};
+    double bestBid = std::numeric_limits<double>::quiet_NaN();     // NaN when not sent
+    double bestAsk = std::numeric_limits<double>::quiet_NaN();
+    double liquidity = std::numeric_limits<double>::quiet_NaN();
+    Id id = 0;
+    Id slug = 0;
+    uint32_t coldRow = noColdRow;   // Row in the owning MarketStore's cold table
+    uint8_t outcomeCount = 0;       // 0 unless outcomeError is None
+    polymarket_bot::api::OutcomeError outcomeError = polymarket_bot::api::OutcomeError::Missing;
+    bool hasConditionId = false;    // False unless Gamma sent 0x plus 64 hex digits
+
+    static MarketRecord fromDecoded(const polymarket_bot::api::DecodedGammaMarket& market);
+
+    std::string idText() const;
+    std::string slugText() const;
+    std::string conditionIdText() const;    // 0x-prefixed lowercase hex, empty if absent
+    std::string_view outcomeName(size_t index) const;
+    std::string_view tokenId(size_t index) const;   // Empty if the market has no token for this outcome
+};
+
+// Hot records in one contiguous array, with the cold fields in a side table.
+//
+// Records are indexed by slug, condition id and token id, all keyed by
+// integers. The cold table keeps each market's JSON object as the decoder
+// captured it; coldFields() decodes the full GammaMarket only when asked.
+// Pointers into the store stay valid until the next add(). Not thread-safe:
+// build it on one thread, then share it read-only.
+class MarketStore
+{
+public:
+    // Adds the market, or replaces the record with the same slug
+    const MarketRecord& add(const polymarket_bot::api::DecodedGammaMarket& market);
+
+    const MarketRecord* findBySlug(std::string_view slug) const;
+    const MarketRecord* findByConditionId(std::string_view conditionId) const;
+    const MarketRecord* findByTokenId(std::string_view tokenId) const;
+
+    // Every field of a record from this store; nullopt if it has no cold row here
+    std::optional<polymarket_bot::common::GammaMarket> coldFields(const MarketRecord& record) const;
+
+    const std::vector<MarketRecord>& records() const { return hot; }
+    size_t size() const { return hot.size(); }
+    void reserve(size_t count);
+
+private:
+    struct ConditionIdHash {
+        // Condition ids are hashes already; their first 8 bytes are as good as any mix
+        size_t operator()(const std::array<uint8_t, 32>& id) const;
+    };
+
+    void index(uint32_t row);
+    void unindex(uint32_t row);
+
+    std::vector<MarketRecord> hot;
+    std::vector<std::string> cold;   // JSON object per record, same order as hot
+
+    std::unordered_map<MarketRecord::Id, uint32_t> bySlug;
+    std::unordered_map<std::array<uint8_t, 32>, uint32_t, ConditionIdHash> byConditionId;
+    std::unordered_map<MarketRecord::Id, uint32_t> byTokenId;
+};
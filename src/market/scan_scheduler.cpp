@@ -0,0 +1,202 @@
+#include "market/scan_scheduler.h"
+
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+ScanScheduler::ScanScheduler(std::vector<polymarket_bot::config::PollBucket> buckets,
+                             std::chrono::seconds baseInterval,
+                             std::chrono::seconds discoveryInterval)
+    : buckets(std::move(buckets)), baseInterval(baseInterval), discoveryInterval(discoveryInterval),
+      startedAt(Clock::now()), nextDiscoveryAt(Clock::time_point::min())
+{
+    if (this->buckets.empty()) {
+        this->buckets.push_back({0, static_cast<int>(baseInterval.count())});
+    }
+    bucketStats.resize(this->buckets.size());
+}
+
+ScanScheduler::Clock::time_point ScanScheduler::parseCommenceTime(const std::string& iso)
+{
+    std::tm tm = {};
+    std::istringstream ss(iso);
+    ss >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%S");
+    if (ss.fail()) {
+        return Clock::time_point::min();
+    }
+    return Clock::from_time_t(timegm(&tm));
+}
+
+size_t ScanScheduler::bucketFor(Clock::time_point commence, Clock::time_point now) const
+{
+    auto minutes = std::chrono::duration_cast<std::chrono::minutes>(commence - now).count();
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        if (minutes < buckets[i].maxMinutesToStart) {
+            return i;
+        }
+    }
+    return buckets.size() - 1;
+}
+
+std::chrono::seconds ScanScheduler::intervalFor(size_t bucket) const
+{
+    return std::chrono::seconds(static_cast<long long>(buckets[bucket].intervalSeconds * stretch + 0.5));
+}
+
+std::string ScanScheduler::bucketLabel(size_t bucket) const
+{
+    auto format = [](int minutes) {
+        if (minutes % 1440 == 0) {
+            return std::to_string(minutes / 1440) + "d";
+        }
+        if (minutes % 60 == 0) {
+            return std::to_string(minutes / 60) + "h";
+        }
+        return std::to_string(minutes) + "m";
+    };
+    std::string lower = bucket == 0 ? "0" : format(buckets[bucket - 1].maxMinutesToStart);
+    if (bucket + 1 == buckets.size()) {
+        return lower + "+";
+    }
+    return lower + "-" + format(buckets[bucket].maxMinutesToStart);
+}
+
+void ScanScheduler::rebalance(Clock::time_point now)
+{
+    if (games.empty() || baseInterval.count() <= 0) {
+        stretch = 1.0;
+        return;
+    }
+    // Polls per second the buckets ask for, against one poll per game per base interval
+    double planned = 0.0;
+    for (const auto& entry : games) {
+        planned += 1.0 / buckets[bucketFor(entry.second.commence, now)].intervalSeconds;
+    }
+    double budget = static_cast<double>(games.size()) / static_cast<double>(baseInterval.count());
+    stretch = std::max(1.0, planned / budget);
+}
+
+void ScanScheduler::schedule(const std::string& gameId, Entry& entry, Clock::time_point now)
+{
+    entry.dueAt = now + intervalFor(bucketFor(entry.commence, now));
+    queue.emplace(entry.dueAt, gameId);
+}
+
+void ScanScheduler::updateGames(const std::vector<polymarket_bot::common::RawOddsGame>& listed, Clock::time_point now)
+{
+    std::unordered_map<std::string, Entry> next;
+    next.reserve(listed.size());
+    for (const auto& game : listed) {
+        auto commence = parseCommenceTime(game.commence_time);
+        if (commence <= now) {
+            continue;
+        }
+        auto existing = games.find(game.id);
+        if (existing != games.end()) {
+            Entry entry = existing->second;
+            entry.commence = commence;   // Start times do move
+            next.emplace(game.id, std::move(entry));
+            continue;
+        }
+        Entry entry;
+        entry.sport = game.sport_key;
+        entry.commence = commence;
+        entry.dueAt = now;
+        queue.emplace(now, game.id);
+        next.emplace(game.id, std::move(entry));
+    }
+    games = std::move(next);
+    rebalance(now);
+}
+
+void ScanScheduler::markPolled(const std::vector<std::string>& gameIds, Clock::time_point now)
+{
+    for (const auto& gameId : gameIds) {
+        auto it = games.find(gameId);
+        if (it == games.end()) {
+            continue;
+        }
+        Entry& entry = it->second;
+        size_t bucket = bucketFor(entry.commence, now);
+        if (entry.polled) {
+            bucketStats[bucket].polls++;
+            bucketStats[bucket].coveredSeconds += std::chrono::duration<double>(now - entry.lastPolled).count();
+        }
+        entry.polled = true;
+        entry.lastPolled = now;
+        schedule(gameId, entry, now);
+    }
+}
+
+std::map<std::string, std::vector<std::string>> ScanScheduler::takeDue(Clock::time_point now)
+{
+    // Buckets shift as games approach, so the stretch factor is recomputed every pass
+    rebalance(now);
+
+    // Games coming due shortly ride along, so one odds request covers them instead of one each
+    auto horizon = now + intervalFor(0) / 4;
+    std::map<std::string, std::vector<std::string>> due;
+    std::vector<std::string> polled;
+    while (!queue.empty() && queue.top().first <= horizon) {
+        QueueItem item = queue.top();
+        queue.pop();
+        auto it = games.find(item.second);
+        if (it == games.end() || it->second.dueAt != item.first) {
+            continue;   // Dropped or rescheduled since this item was queued
+        }
+        if (it->second.commence <= now) {
+            games.erase(it);
+            continue;
+        }
+        due[it->second.sport].push_back(item.second);
+        polled.push_back(item.second);
+    }
+    markPolled(polled, now);
+    return due;
+}
+
+ScanScheduler::Clock::time_point ScanScheduler::nextDue()
+{
+    // Skip stale items so the caller does not wake for a game that was rescheduled or dropped
+    while (!queue.empty()) {
+        auto it = games.find(queue.top().second);
+        if (it != games.end() && it->second.dueAt == queue.top().first) {
+            return queue.top().first;
+        }
+        queue.pop();
+    }
+    return Clock::time_point::max();
+}
+
+std::vector<ScanScheduler::BucketReport> ScanScheduler::report(Clock::time_point now) const
+{
+    std::vector<BucketReport> reports(buckets.size());
+    double minutes = std::max(1.0 / 60.0, std::chrono::duration<double>(now - startedAt).count() / 60.0);
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        reports[i].label = bucketLabel(i);
+        reports[i].targetSeconds = intervalFor(i).count();
+        reports[i].polls = bucketStats[i].polls;
+        reports[i].effectiveSeconds = bucketStats[i].polls ? bucketStats[i].coveredSeconds / bucketStats[i].polls : 0.0;
+        reports[i].pollsPerMinute = static_cast<double>(bucketStats[i].polls) / minutes;
+    }
+    for (const auto& entry : games) {
+        reports[bucketFor(entry.second.commence, now)].games++;
+    }
+    return reports;
+}
+
+void ScanScheduler::logReport(Clock::time_point now) const
+{
+    std::cout << "[ScanScheduler] " << games.size() << " games tracked, intervals x" << std::fixed
+              << std::setprecision(2) << stretch << " to stay within one poll per game per " << baseInterval.count()
+              << " s" << std::endl;
+    for (const auto& bucket : report(now)) {
+        std::cout << "[ScanScheduler]   " << std::setw(8) << bucket.label << ": " << bucket.games << " games, "
+                  << bucket.polls << " polls, every " << std::setprecision(0) << bucket.effectiveSeconds
+                  << " s (target " << bucket.targetSeconds << " s), " << std::setprecision(2)
+                  << bucket.pollsPerMinute << " polls/min" << std::endl;
+    }
+    std::cout << std::defaultfloat;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/types.h"
+#include "config/config_types.h"
+
+// Decides which games to re-price next, by time to commence.
+//
+// Every tracked game sits in a min-heap keyed on its next due time. A game's
+// polling interval comes from the bucket its time to commence falls in
+// (sync.pollBuckets), so games about to start are re-priced every few
+// seconds while games days out are touched rarely. Started games are
+// dropped. If the buckets would poll more often in total than one poll per
+// game per base interval (the old fixed-interval rate), every interval is
+// stretched by the same factor, so the API call budget is unchanged and
+// only its distribution moves. A full listing of every sport runs every
+// discovery interval to pick up new games.
+class ScanScheduler
+{
+public:
+    using Clock = std::chrono::system_clock;   // Commence times are wall-clock
+
+    ScanScheduler(std::vector<polymarket_bot::config::PollBucket> buckets,
+                  std::chrono::seconds baseInterval,
+                  std::chrono::seconds discoveryInterval);
+
+    // Track the games of a full listing: new ones are due at once, missing and started ones are dropped
+    void updateGames(const std::vector<polymarket_bot::common::RawOddsGame>& games, Clock::time_point now);
+    // Record that these games were just priced and schedule their next poll
+    void markPolled(const std::vector<std::string>& gameIds, Clock::time_point now);
+    // Pop every due game, grouped by sport (one odds request each), and schedule its next poll
+    std::map<std::string, std::vector<std::string>> takeDue(Clock::time_point now);
+
+    Clock::time_point nextDue();   // time_point::max() when nothing is tracked
+    bool discoveryDue(Clock::time_point now) const { return now >= nextDiscoveryAt; }
+    void markDiscovered(Clock::time_point now) { nextDiscoveryAt = now + discoveryInterval; }
+    Clock::time_point nextDiscovery() const { return nextDiscoveryAt; }
+    size_t size() const { return games.size(); }
+
+    struct BucketReport {
+        std::string label;
+        long long targetSeconds = 0;     // Bucket interval after stretching
+        size_t games = 0;                // Games in the bucket right now
+        size_t polls = 0;                // Polls of games while they were in the bucket
+        double effectiveSeconds = 0.0;   // Mean time between two polls of the same game
+        double pollsPerMinute = 0.0;     // Bucket-wide poll rate since the scheduler started
+    };
+    std::vector<BucketReport> report(Clock::time_point now) const;
+    void logReport(Clock::time_point now) const;
+
+    static Clock::time_point parseCommenceTime(const std::string& iso);
+
+private:
+    struct Entry {
+        std::string sport;
+        Clock::time_point commence;
+        Clock::time_point dueAt;
+        Clock::time_point lastPolled;
+        bool polled = false;
+    };
+
+    size_t bucketFor(Clock::time_point commence, Clock::time_point now) const;
+    std::chrono::seconds intervalFor(size_t bucket) const;
+    void schedule(const std::string& gameId, Entry& entry, Clock::time_point now);
+    void rebalance(Clock::time_point now);
+    std::string bucketLabel(size_t bucket) const;
+
+    std::vector<polymarket_bot::config::PollBucket> buckets;
+    std::chrono::seconds baseInterval;
+    std::chrono::seconds discoveryInterval;
+    Clock::time_point startedAt;
+    Clock::time_point nextDiscoveryAt;
+    double stretch = 1.0;
+
+    using QueueItem = std::pair<Clock::time_point, std::string>;
+    // Entries are never removed in place; stale items are skipped when they reach the top
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue;
+    std::unordered_map<std::string, Entry> games;
+
+    struct BucketStats {
+        size_t polls = 0;
+        double coveredSeconds = 0.0;
+    };
+    std::vector<BucketStats> bucketStats;
+};
@@ -0,0 +1,97 @@
+#include "market/slug_lookup_cache.h"
+
+#include <algorithm>
+#include <iostream>
+
+const char* slugVariantName(SlugVariant variant)
+{
+    switch (variant) {
+        case SlugVariant::Exact: return "exact";
+        case SlugVariant::DayBefore: return "day-before";
+        case SlugVariant::DayAfter: return "day-after";
+        case SlugVariant::Swapped: return "swapped";
+        case SlugVariant::SwappedDayBefore: return "swapped-day-before";
+        case SlugVariant::SwappedDayAfter: return "swapped-day-after";
+        default: return "unknown";
+    }
+}
+
+SlugLookupCache::SlugLookupCache(std::chrono::seconds negativeTtl)
+    : negativeTtl(negativeTtl), negativeHits(0)
+{
+}
+
+bool SlugLookupCache::isKnownMissing(const std::string& slug)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = missingUntil.find(slug);
+    if (it == missingUntil.end()) {
+        return false;
+    }
+    if (Clock::now() >= it->second) {
+        missingUntil.erase(it);
+        return false;
+    }
+    negativeHits++;
+    return true;
+}
+
+void SlugLookupCache::recordMiss(const std::string& slug)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto now = Clock::now();
+    missingUntil[slug] = now + negativeTtl;
+
+    // Drop expired entries so games that finished do not accumulate forever
+    for (auto it = missingUntil.begin(); it != missingUntil.end();) {
+        it = (now >= it->second) ? missingUntil.erase(it) : std::next(it);
+    }
+}
+
+void SlugLookupCache::recordHit(const std::string& sport, SlugVariant variant)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& hits = hitsBySport.try_emplace(sport).first->second;
+    hits[static_cast<size_t>(variant)]++;
+}
+
+std::vector<SlugVariant> SlugLookupCache::variantOrder(const std::string& sport) const
+{
+    std::vector<SlugVariant> order;
+    for (size_t i = 0; i < variantCount; ++i) {
+        order.push_back(static_cast<SlugVariant>(i));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = hitsBySport.find(sport);
+    if (it != hitsBySport.end()) {
+        const auto& hits = it->second;
+        std::stable_sort(order.begin(), order.end(), [&hits](SlugVariant a, SlugVariant b) {
+            return hits[static_cast<size_t>(a)] > hits[static_cast<size_t>(b)];
+        });
+    }
+    return order;
+}
+
+SlugLookupCache::Stats SlugLookupCache::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats stats;
+    stats.negativeHits = negativeHits;
+    stats.negativeEntries = missingUntil.size();
+    return stats;
+}
+
+void SlugLookupCache::logStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::cout << "[SlugLookupCache] Negative cache: " << missingUntil.size() << " entries, "
+              << negativeHits << " lookups skipped" << std::endl;
+    for (const auto& entry : hitsBySport) {
+        std::cout << "[SlugLookupCache]   " << entry.first << ":";
+        for (size_t i = 0; i < variantCount; ++i) {
+            std::cout << " " << slugVariantName(static_cast<SlugVariant>(i)) << "=" << entry.second[i];
+        }
+        std::cout << std::endl;
+    }
+}
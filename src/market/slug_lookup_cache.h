@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Candidate slugs tried for a game, in their default priority order
+enum class SlugVariant {
+    Exact = 0,
+    DayBefore,
+    DayAfter,
+    Swapped,
+    SwappedDayBefore,
+    SwappedDayAfter,
+    Count
+};
+
+const char* slugVariantName(SlugVariant variant);
+
+// Remembers slugs that resolved to nothing and learns, per sport, which
+// candidate variant actually hits.
+//
+// Games without a Polymarket market are skipped until their negative entry
+// expires, and the candidate order for a sport follows observed hit counts
+// (ties keep the default order), so the likely variant is probed first.
+// Safe to share between resolver threads.
+class SlugLookupCache
+{
+public:
+    explicit SlugLookupCache(std::chrono::seconds negativeTtl = std::chrono::seconds(900));
+
+    bool isKnownMissing(const std::string& slug);
+    void recordMiss(const std::string& slug);
+    void recordHit(const std::string& sport, SlugVariant variant);
+
+    // Candidate order for a sport, most frequently hit first
+    std::vector<SlugVariant> variantOrder(const std::string& sport) const;
+
+    struct Stats {
+        size_t negativeHits = 0;    // Lookups skipped thanks to the negative cache
+        size_t negativeEntries = 0;
+    };
+    Stats getStats() const;
+    void logStats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+    static constexpr size_t variantCount = static_cast<size_t>(SlugVariant::Count);
+
+    std::chrono::seconds negativeTtl;
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, Clock::time_point> missingUntil;
+    std::unordered_map<std::string, std::array<size_t, variantCount>> hitsBySport;
+    size_t negativeHits;
+};
@@ -0,0 +1,855 @@
+#include "stub_api_server.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <arpa/inet.h>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <openssl/evp.h>
+#include <openssl/sha.h>
+#include <poll.h>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace polymarket_bot {
+namespace stub {
+
+namespace {
+
+struct StubTeam {
+    const char* name;      // Odds API name, as mapped by MarketMatcher
+    const char* code;      // Polymarket slug code
+    const char* nickname;  // Polymarket outcome name
+};
+
+struct StubSport {
+    const char* key;
+    const char* slugPrefix;
+    std::vector<StubTeam> teams;
+};
+
+// Teams taken from MarketMatcher's mappings so every synthetic game resolves to a slug
+const std::vector<StubSport>& stubSports() {
+    static const std::vector<StubSport> sports = {
+        {"basketball_nba", "nba", {
+            {"Brooklyn Nets", "bkn", "Nets"}, {"Cleveland Cavaliers", "cle", "Cavaliers"},
+            {"Detroit Pistons", "det", "Pistons"}, {"Indiana Pacers", "ind", "Pacers"},
+            {"LA Lakers", "lal", "Lakers"}, {"Miami Heat", "mia", "Heat"},
+            {"Orlando Magic", "orl", "Magic"}, {"Toronto Raptors", "tor", "Raptors"}}},
+        {"icehockey_nhl", "nhl", {
+            {"Calgary Flames", "cgy", "Flames"}, {"Colorado Avalanche", "col", "Avalanche"},
+            {"Detroit Red Wings", "det", "Red Wings"}, {"Los Angeles Kings", "lak", "Kings"},
+            {"Nashville Predators", "nsh", "Predators"}, {"New York Rangers", "nyr", "Rangers"},
+            {"Pittsburgh Penguins", "pit", "Penguins"}, {"Vancouver Canucks", "van", "Canucks"}}},
+        {"baseball_mlb", "mlb", {
+            {"Boston Red Sox", "bos", "Red Sox"}, {"Cincinnati Reds", "cin", "Reds"},
+            {"Detroit Tigers", "det", "Tigers"}, {"Los Angeles Angels", "laa", "Angels"},
+            {"Milwaukee Brewers", "mil", "Brewers"}, {"New York Yankees", "nyy", "Yankees"},
+            {"Pittsburgh Pirates", "pit", "Pirates"}, {"Toronto Blue Jays", "tor", "Blue Jays"}}},
+    };
+    return sports;
+}
+
+std::string isoTime(std::chrono::system_clock::time_point tp) {
+    auto time = std::chrono::system_clock::to_time_t(tp);
+    std::stringstream ss;
+    ss << std::put_time(std::gmtime(&time), "%Y-%m-%dT%H:%M:%SZ");
+    return ss.str();
+}
+
+std::string priceString(double price) {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3) << price;
+    return ss.str();
+}
+
+// Shaped like a real condition id: 0x and 64 hex digits
+std::string conditionIdFor(const std::string& number) {
+    std::stringstream ss;
+    ss << "0x" << std::hex << std::setw(64) << std::setfill('0') << std::stoull(number);
+    return ss.str();
+}
+
+const char* reasonPhrase(int status) {
+    switch (status) {
+        case 101: return "Switching Protocols";
+        case 200: return "OK";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 429: return "Too Many Requests";
+        case 500: return "Internal Server Error";
+        default: return "Unknown";
+    }
+}
+
+std::mt19937& randomEngine() {
+    thread_local std::mt19937 engine(std::random_device{}());
+    return engine;
+}
+
+double uniform() {
+    return std::uniform_real_distribution<double>(0.0, 1.0)(randomEngine());
+}
+
+// Sec-WebSocket-Accept for a client's Sec-WebSocket-Key (RFC 6455 section 4.2.2)
+std::string webSocketAccept(const std::string& key) {
+    std::string input = key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+    unsigned char digest[SHA_DIGEST_LENGTH];
+    SHA1(reinterpret_cast<const unsigned char*>(input.data()), input.size(), digest);
+    unsigned char encoded[4 * ((SHA_DIGEST_LENGTH + 2) / 3) + 1];
+    int length = EVP_EncodeBlock(encoded, digest, SHA_DIGEST_LENGTH);
+    return std::string(reinterpret_cast<char*>(encoded), static_cast<size_t>(length));
+}
+
+// Server frames are never masked
+std::string webSocketFrame(unsigned char opcode, const std::string& payload) {
+    std::string frame(1, static_cast<char>(0x80 | opcode));
+    size_t length = payload.size();
+    if (length < 126) {
+        frame += static_cast<char>(length);
+    } else if (length <= 0xFFFF) {
+        frame += static_cast<char>(126);
+        frame += static_cast<char>((length >> 8) & 0xFF);
+        frame += static_cast<char>(length & 0xFF);
+    } else {
+        frame += static_cast<char>(127);
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            frame += static_cast<char>((length >> shift) & 0xFF);
+        }
+    }
+    return frame + payload;
+}
+
+// Pops one complete client frame off `buffer`; false until a whole frame has arrived
+bool takeWebSocketFrame(std::string& buffer, unsigned char& opcode, std::string& payload) {
+    if (buffer.size() < 2) {
+        return false;
+    }
+    opcode = static_cast<unsigned char>(buffer[0]) & 0x0F;
+    bool masked = static_cast<unsigned char>(buffer[1]) & 0x80;
+    size_t length = static_cast<unsigned char>(buffer[1]) & 0x7F;
+    size_t offset = 2;
+    if (length == 126 || length == 127) {
+        size_t bytes = length == 126 ? 2 : 8;
+        if (buffer.size() < offset + bytes) {
+            return false;
+        }
+        length = 0;
+        for (size_t i = 0; i < bytes; ++i) {
+            length = (length << 8) | static_cast<unsigned char>(buffer[offset + i]);
+        }
+        offset += bytes;
+    }
+    size_t maskOffset = offset;
+    if (masked) {
+        offset += 4;
+    }
+    if (buffer.size() < offset + length) {
+        return false;
+    }
+    payload = buffer.substr(offset, length);
+    if (masked) {
+        for (size_t i = 0; i < length; ++i) {
+            payload[i] = static_cast<char>(payload[i] ^ buffer[maskOffset + i % 4]);
+        }
+    }
+    buffer.erase(0, offset + length);
+    return true;
+}
+
+bool sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t written = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (written <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(written);
+    }
+    return true;
+}
+
+} // namespace
+
+StubApiServer::StubApiServer(const StubServerOptions& options)
+    : options(options), running(false), listenFd(-1), oddsRemaining(options.oddsQuota), orderSequence(0),
+      rateWindowSecond(0), rateWindowCount(0) {
+}
+
+StubApiServer::~StubApiServer() {
+    stop();
+}
+
+void StubApiServer::buildFixtures() {
+    // Games start on whole hours from tomorrow (UTC) so they sit inside the bot's commence window
+    auto today = std::chrono::floor<std::chrono::days>(std::chrono::system_clock::now());
+    std::mt19937 priceRandom(42);
+    std::uniform_real_distribution<double> favourite(0.35, 0.65);
+    std::uniform_real_distribution<double> drift(-0.04, 0.04);
+
+    size_t marketNumber = 0;
+    auto addMarket = [&](nlohmann::json market) {
+        std::string slug = market["slug"];
+        std::string id = market["id"];
+        gammaBySlug[slug] = gammaMarkets.size();
+        gammaById[id] = gammaMarkets.size();
+        gammaMarkets.push_back(market.dump());
+        gammaSlugs.push_back(slug);
+    };
+
+    for (const auto& sport : stubSports()) {
+        const size_t teamCount = sport.teams.size();
+        const size_t pairsPerDay = teamCount * (teamCount - 1);
+        nlohmann::json games = nlohmann::json::array();
+        nlohmann::json isoGames = nlohmann::json::array();
+
+        for (int i = 0; i < options.gamesPerSport; ++i) {
+            size_t pair = static_cast<size_t>(i) % pairsPerDay;
+            size_t day = static_cast<size_t>(i) / pairsPerDay;
+            if (day >= 6) {
+                std::cerr << "[StubApiServer] " << sport.key << " capped at " << i
+                          << " games (distinct matchups within the odds window)" << std::endl;
+                break;
+            }
+            size_t awayIndex = pair / (teamCount - 1);
+            size_t homeIndex = pair % (teamCount - 1);
+            if (homeIndex >= awayIndex) {
+                homeIndex++;
+            }
+            const StubTeam& away = sport.teams[awayIndex];
+            const StubTeam& home = sport.teams[homeIndex];
+
+            auto commence = today + std::chrono::days(day + 1) + std::chrono::hours(pair % 20);
+            std::string commenceIso = isoTime(commence);
+            long commenceUnix = static_cast<long>(std::chrono::system_clock::to_time_t(commence));
+
+            // Sharp line with the vig, Polymarket priced a little off it so some games show an edge
+            double awayProb = favourite(priceRandom);
+            double awayPoly = std::clamp(awayProb + drift(priceRandom), 0.02, 0.98);
+            nlohmann::json h2h = {
+                {"key", "h2h"},
+                {"outcomes", {
+                    {{"name", away.name}, {"price", std::round(100.0 / (awayProb * 1.025)) / 100.0}},
+                    {{"name", home.name}, {"price", std::round(100.0 / ((1.0 - awayProb) * 1.025)) / 100.0}}}}};
+
+            std::string gameId = std::string(sport.slugPrefix) + "game" + std::to_string(i);
+            nlohmann::json game = {
+                {"id", gameId},
+                {"sport_key", sport.key},
+                {"commence_time", commenceUnix},
+                {"home_team", home.name},
+                {"away_team", away.name},
+                {"bookmakers", {{{"key", "pinnacle"}, {"title", "Pinnacle"}, {"last_update", commenceUnix - 3600},
+                                 {"markets", {h2h}}}}}};
+            games.push_back(game);
+            game["commence_time"] = commenceIso;
+            game["bookmakers"][0]["last_update"] = isoTime(commence - std::chrono::hours(1));
+            isoGames.push_back(game);
+
+            std::string slug = std::string(sport.slugPrefix) + "-" + away.code + "-" + home.code + "-" +
+                               commenceIso.substr(0, 10);
+            std::string number = std::to_string(++marketNumber);
+            tokenPrices["stub-token-" + number + "-a"] = awayPoly;
+            tokenPrices["stub-token-" + number + "-b"] = 1.0 - awayPoly;
+            addMarket({
+                {"id", "stub-" + number},
+                {"question", std::string(away.name) + " vs. " + home.name},
+                {"conditionId", conditionIdFor(number)},
+                {"slug", slug},
+                {"startDate", isoTime(commence - std::chrono::days(2))},
+                {"endDate", commenceIso},
+                {"outcomes", nlohmann::json({away.nickname, home.nickname}).dump()},
+                {"outcomePrices", nlohmann::json({priceString(awayPoly), priceString(1.0 - awayPoly)}).dump()},
+                {"clobTokenIds", nlohmann::json({"stub-token-" + number + "-a", "stub-token-" + number + "-b"}).dump()},
+                {"volumeNum", 50000.0},
+                {"liquidityNum", 20000.0},
+                {"active", true},
+                {"closed", false},
+                {"acceptingOrders", true},
+                {"enableOrderBook", true}});
+        }
+        oddsBySport[sport.key] = games.dump();
+        isoOddsBySport[sport.key] = isoGames.dump();
+    }
+
+    for (int i = 0; i < options.fillerMarkets; ++i) {
+        std::string number = std::to_string(++marketNumber);
+        addMarket({
+            {"id", "stub-" + number},
+            {"question", "Synthetic filler market " + number + "?"},
+            {"conditionId", conditionIdFor(number)},
+            {"slug", "stub-filler-market-" + number},
+            {"endDate", isoTime(today + std::chrono::days(30))},
+            {"outcomes", "[\"Yes\", \"No\"]"},
+            {"outcomePrices", "[\"0.5\", \"0.5\"]"},
+            {"clobTokenIds", nlohmann::json({"stub-token-" + number + "-a", "stub-token-" + number + "-b"}).dump()},
+            {"active", true},
+            {"closed", false}});
+    }
+
+    std::cout << "[StubApiServer] Fixtures: " << oddsBySport.size() << " sports, " << gammaMarkets.size()
+              << " Gamma markets" << std::endl;
+}
+
+void StubApiServer::loadArchive() {
+    if (options.archivePath.empty()) {
+        return;
+    }
+    std::vector<api::RecordedExchange> exchanges;
+    if (!api::ExchangeArchive::readAll(options.archivePath, exchanges)) {
+        return;
+    }
+    for (auto& exchange : exchanges) {
+        // Recorded URLs carry the real host; requests here only have the path
+        std::string target = exchange.url;
+        size_t scheme = target.find("://");
+        if (scheme != std::string::npos) {
+            size_t path = target.find('/', scheme + 3);
+            target = path == std::string::npos ? "/" : target.substr(path);
+        }
+        // Later recordings of the same request win
+        archived[api::ExchangeArchive::looseKey(exchange.method, target, exchange.requestBody)] = std::move(exchange.response);
+    }
+    std::cout << "[StubApiServer] Loaded " << archived.size() << " recorded responses from " << options.archivePath
+              << std::endl;
+}
+
+void StubApiServer::loadWsFrames() {
+    if (options.wsFramesPath.empty()) {
+        return;
+    }
+    std::ifstream in(options.wsFramesPath);
+    if (!in.is_open()) {
+        std::cerr << "[StubApiServer] Cannot open " << options.wsFramesPath << std::endl;
+        return;
+    }
+    // "<ms>\t<payload>" lines as written by ClobMarketFeed::recordTo
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t tab = line.find('\t');
+        if (tab == std::string::npos) {
+            continue;
+        }
+        try {
+            wsFrames.emplace_back(std::stoll(line.substr(0, tab)), line.substr(tab + 1));
+        } catch (const std::exception&) {
+            continue;
+        }
+    }
+    if (!wsFrames.empty()) {
+        // Replay relative to the first frame, which arrived right after the recorded subscription
+        long long first = wsFrames.front().first;
+        for (auto& frame : wsFrames) {
+            frame.first -= first;
+        }
+    }
+    std::cout << "[StubApiServer] Loaded " << wsFrames.size() << " market channel frames from " << options.wsFramesPath
+              << std::endl;
+}
+
+bool StubApiServer::start() {
+    if (running) {
+        return true;
+    }
+    buildFixtures();
+    loadArchive();
+    loadWsFrames();
+
+    listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        std::cerr << "[StubApiServer] socket() failed" << std::endl;
+        return false;
+    }
+    int enable = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(options.port));
+    if (inet_pton(AF_INET, options.host.c_str(), &address.sin_addr) != 1) {
+        std::cerr << "[StubApiServer] Invalid host: " << options.host << std::endl;
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listenFd, 512) != 0) {
+        std::cerr << "[StubApiServer] Cannot listen on " << options.host << ":" << options.port << std::endl;
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+
+    running = true;
+    acceptThread = std::thread(&StubApiServer::acceptLoop, this);
+    std::cout << "[StubApiServer] Listening on http://" << options.host << ":" << options.port << std::endl;
+    return true;
+}
+
+void StubApiServer::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+    shutdown(listenFd, SHUT_RDWR);
+    close(listenFd);
+    listenFd = -1;
+    if (acceptThread.joinable()) {
+        acceptThread.join();
+    }
+
+    std::unique_lock<std::mutex> lock(connectionsMutex);
+    for (int fd : openConnections) {
+        shutdown(fd, SHUT_RDWR);
+    }
+    connectionsClosed.wait(lock, [this]() { return openConnections.empty(); });
+}
+
+void StubApiServer::acceptLoop() {
+    while (running) {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (!running) {
+                break;
+            }
+            continue;
+        }
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        openConnections.push_back(fd);
+        std::thread(&StubApiServer::serveConnection, this, fd).detach();
+    }
+}
+
+void StubApiServer::serveConnection(int fd) {
+    std::string buffer;
+    char chunk[16384];
+    bool keepAlive = true;
+
+    while (keepAlive && running) {
+        size_t headerEnd;
+        while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+            ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+            if (received <= 0) {
+                keepAlive = false;
+                break;
+            }
+            buffer.append(chunk, static_cast<size_t>(received));
+        }
+        if (!keepAlive) {
+            break;
+        }
+
+        std::istringstream head(buffer.substr(0, headerEnd));
+        std::string method, target, version, line;
+        head >> method >> target >> version;
+        std::getline(head, line);
+        size_t contentLength = 0;
+        bool upgrade = false;
+        std::string webSocketKey;
+        while (std::getline(head, line)) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            std::string lower = line;
+            std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+            if (lower.rfind("content-length:", 0) == 0) {
+                contentLength = std::stoul(lower.substr(15));
+            } else if (lower.rfind("connection:", 0) == 0 && lower.find("close") != std::string::npos) {
+                keepAlive = false;
+            } else if (lower.rfind("upgrade:", 0) == 0 && lower.find("websocket") != std::string::npos) {
+                upgrade = true;
+            } else if (lower.rfind("sec-websocket-key:", 0) == 0) {
+                size_t start = line.find_first_not_of(" \t", 18);
+                webSocketKey = start == std::string::npos ? "" : line.substr(start);
+            }
+        }
+
+        if (upgrade && target.substr(0, target.find('?')) == "/ws/market" && !webSocketKey.empty()) {
+            buffer.erase(0, headerEnd + 4);
+            std::string out = "HTTP/1.1 101 " + std::string(reasonPhrase(101)) + "\r\n";
+            out += "Upgrade: websocket\r\nConnection: Upgrade\r\n";
+            out += "Sec-WebSocket-Accept: " + webSocketAccept(webSocketKey) + "\r\n\r\n";
+            if (sendAll(fd, out)) {
+                serveWebSocket(fd, std::move(buffer));
+            }
+            break;
+        }
+
+        size_t bodyStart = headerEnd + 4;
+        while (buffer.size() < bodyStart + contentLength) {
+            ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+            if (received <= 0) {
+                keepAlive = false;
+                break;
+            }
+            buffer.append(chunk, static_cast<size_t>(received));
+        }
+        if (buffer.size() < bodyStart + contentLength) {
+            break;
+        }
+        std::string body = buffer.substr(bodyStart, contentLength);
+        buffer.erase(0, bodyStart + contentLength);
+
+        int delay = options.latencyMs;
+        if (options.jitterMs > 0) {
+            delay += std::uniform_int_distribution<int>(0, options.jitterMs)(randomEngine());
+        }
+        if (delay > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+        }
+
+        Response response = route(method, target, body);
+
+        std::string out = "HTTP/1.1 " + std::to_string(response.status) + " " + reasonPhrase(response.status) + "\r\n";
+        out += "Content-Type: application/json\r\n";
+        out += "Content-Length: " + std::to_string(response.body.size()) + "\r\n";
+        if (!keepAlive) {
+            out += "Connection: close\r\n";
+        }
+        for (const auto& header : response.headers) {
+            out += header + "\r\n";
+        }
+        out += "\r\n";
+        out += response.body;
+
+        if (!sendAll(fd, out)) {
+            keepAlive = false;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+    openConnections.erase(std::remove(openConnections.begin(), openConnections.end(), fd), openConnections.end());
+    close(fd);
+    connectionsClosed.notify_all();
+}
+
+void StubApiServer::serveWebSocket(int fd, std::string pending) {
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.wsSessions++;
+        stats.byRoute["ws/market"]++;
+    }
+
+    std::vector<std::string> assets;
+    std::unordered_map<std::string, double> mids;
+    bool subscribed = false;
+    auto subscribedAt = std::chrono::steady_clock::now();
+    auto nextTick = subscribedAt;
+    size_t nextFrame = 0;
+    char chunk[16384];
+    size_t sentFrames = 0;
+
+    auto sendText = [&](const std::string& payload) {
+        sentFrames++;
+        return sendAll(fd, webSocketFrame(0x1, payload));
+    };
+    auto level = [](double price, double size) {
+        return nlohmann::json{{"price", priceString(price)}, {"size", std::to_string(static_cast<int>(size))}};
+    };
+
+    bool open = true;
+    while (open && running) {
+        auto now = std::chrono::steady_clock::now();
+        int timeoutMs = 200;
+        if (subscribed && !wsFrames.empty() && nextFrame < wsFrames.size()) {
+            auto due = subscribedAt + std::chrono::milliseconds(wsFrames[nextFrame].first);
+            timeoutMs = static_cast<int>(std::clamp<long long>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(due - now).count(), 0, 200));
+        } else if (subscribed && wsFrames.empty()) {
+            timeoutMs = static_cast<int>(std::clamp<long long>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(nextTick - now).count(), 0, 200));
+        }
+
+        pollfd descriptor{fd, POLLIN, 0};
+        if (poll(&descriptor, 1, timeoutMs) > 0) {
+            ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+            if (received <= 0) {
+                break;
+            }
+            pending.append(chunk, static_cast<size_t>(received));
+        }
+
+        unsigned char opcode;
+        std::string payload;
+        while (open && takeWebSocketFrame(pending, opcode, payload)) {
+            if (opcode == 0x8) {
+                sendAll(fd, webSocketFrame(0x8, payload.substr(0, 2)));
+                open = false;
+            } else if (opcode == 0x9) {
+                open = sendAll(fd, webSocketFrame(0xA, payload));
+            } else if (opcode == 0x1 && payload == "PING") {
+                open = sendAll(fd, webSocketFrame(0x1, "PONG"));
+            } else if (opcode == 0x1) {
+                nlohmann::json message = nlohmann::json::parse(payload, nullptr, false);
+                if (message.is_discarded() || !message.contains("assets_ids") || !message["assets_ids"].is_array()) {
+                    continue;
+                }
+                if (!subscribed) {
+                    subscribed = true;
+                    subscribedAt = std::chrono::steady_clock::now();
+                    nextTick = subscribedAt + std::chrono::milliseconds(options.wsIntervalMs);
+                }
+                if (!wsFrames.empty()) {
+                    continue;
+                }
+                // Like the real channel, every newly subscribed asset gets a full book first
+                nlohmann::json books = nlohmann::json::array();
+                for (const auto& asset : message["assets_ids"]) {
+                    std::string tokenId = asset.is_string() ? asset.get<std::string>() : "";
+                    if (tokenId.empty() || mids.count(tokenId)) {
+                        continue;
+                    }
+                    auto price = tokenPrices.find(tokenId);
+                    double mid = price != tokenPrices.end() ? price->second : 0.5;
+                    mids[tokenId] = mid;
+                    assets.push_back(tokenId);
+                    books.push_back({{"event_type", "book"},
+                                     {"asset_id", tokenId},
+                                     {"bids", {level(std::max(0.01, mid - 0.01), 500), level(std::max(0.01, mid - 0.02), 1500)}},
+                                     {"asks", {level(std::min(0.99, mid + 0.01), 500), level(std::min(0.99, mid + 0.02), 1500)}},
+                                     {"timestamp", std::to_string(std::time(nullptr) * 1000)}});
+                }
+                if (!books.empty()) {
+                    open = sendText(books.dump());
+                }
+            }
+        }
+
+        now = std::chrono::steady_clock::now();
+        if (!open || !subscribed) {
+            continue;
+        }
+        if (!wsFrames.empty()) {
+            while (open && nextFrame < wsFrames.size() &&
+                   now >= subscribedAt + std::chrono::milliseconds(wsFrames[nextFrame].first)) {
+                open = sendText(wsFrames[nextFrame++].second);
+            }
+        } else if (!assets.empty() && now >= nextTick) {
+            nextTick += std::chrono::milliseconds(options.wsIntervalMs);
+            const std::string& tokenId = assets[std::uniform_int_distribution<size_t>(0, assets.size() - 1)(randomEngine())];
+            double& mid = mids[tokenId];
+            mid = std::clamp(mid + (uniform() < 0.5 ? -0.01 : 0.01), 0.02, 0.98);
+            double bestBid = mid - 0.01;
+            double bestAsk = mid + 0.01;
+            open = sendText(nlohmann::json{
+                {"event_type", "price_change"},
+                {"market", "0xstubcondition"},
+                {"price_changes", {{{"asset_id", tokenId}, {"price", priceString(bestAsk)}, {"size", "500"},
+                                    {"side", "SELL"}, {"best_bid", priceString(bestBid)}, {"best_ask", priceString(bestAsk)}}}},
+                {"timestamp", std::to_string(std::time(nullptr) * 1000)}}.dump());
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats.wsFrames += sentFrames;
+}
+
+std::string StubApiServer::queryParam(const std::string& target, const std::string& name) {
+    size_t query = target.find('?');
+    if (query == std::string::npos) {
+        return "";
+    }
+    std::string key = name + "=";
+    size_t pos = query;
+    while (pos != std::string::npos) {
+        if (target.compare(pos + 1, key.size(), key) == 0) {
+            size_t valueStart = pos + 1 + key.size();
+            size_t valueEnd = target.find('&', valueStart);
+            return target.substr(valueStart, valueEnd == std::string::npos ? std::string::npos : valueEnd - valueStart);
+        }
+        pos = target.find('&', pos + 1);
+    }
+    return "";
+}
+
+bool StubApiServer::overRateLimit() {
+    if (options.maxRequestsPerSecond <= 0) {
+        return false;
+    }
+    long second = static_cast<long>(std::time(nullptr));
+    std::lock_guard<std::mutex> lock(statsMutex);
+    if (second != rateWindowSecond) {
+        rateWindowSecond = second;
+        rateWindowCount = 0;
+    }
+    return ++rateWindowCount > options.maxRequestsPerSecond;
+}
+
+void StubApiServer::countRoute(const std::string& route) {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats.byRoute[route]++;
+}
+
+StubApiServer::Response StubApiServer::route(const std::string& method, const std::string& target, const std::string& body) {
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.requests++;
+    }
+
+    Response response;
+    if (overRateLimit() || (options.throttleRate > 0.0 && uniform() < options.throttleRate)) {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.throttled++;
+        response.status = 429;
+        response.body = "{\"error\":\"Too Many Requests\"}";
+        response.headers.push_back("Retry-After: " + std::to_string(options.retryAfterSeconds));
+        return response;
+    }
+    if (options.errorRate > 0.0 && uniform() < options.errorRate) {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.errors++;
+        response.status = 500;
+        response.body = "{\"error\":\"Injected failure\"}";
+        return response;
+    }
+
+    if (!archived.empty()) {
+        auto it = archived.find(api::ExchangeArchive::looseKey(method, target, body));
+        if (it != archived.end()) {
+            {
+                std::lock_guard<std::mutex> lock(statsMutex);
+                stats.fromArchive++;
+            }
+            response.status = static_cast<int>(it->second.statusCode);
+            response.body = it->second.body;
+            return response;
+        }
+    }
+
+    std::string path = target.substr(0, target.find('?'));
+
+    if (method == "GET" && path.rfind("/v4/sports/", 0) == 0 && path.size() > 16 &&
+        path.compare(path.size() - 5, 5, "/odds") == 0) {
+        countRoute("odds");
+        std::string sport = path.substr(11, path.size() - 16);
+        int remaining = std::max(0, --oddsRemaining);
+        response.headers.push_back("x-requests-remaining: " + std::to_string(remaining));
+        response.headers.push_back("x-requests-used: " + std::to_string(options.oddsQuota - remaining));
+        const auto& bodies = queryParam(target, "dateFormat") == "iso" ? isoOddsBySport : oddsBySport;
+        auto it = bodies.find(sport);
+        response.body = it != bodies.end() ? it->second : "[]";
+        std::string eventIds = queryParam(target, "eventIds");
+        if (!eventIds.empty() && it != bodies.end()) {
+            std::string ids = "," + eventIds + ",";
+            auto games = nlohmann::json::array();
+            for (const auto& game : nlohmann::json::parse(it->second)) {
+                if (ids.find("," + game.value("id", std::string()) + ",") != std::string::npos) {
+                    games.push_back(game);
+                }
+            }
+            response.body = games.dump();
+        }
+        return response;
+    }
+
+    if (method == "GET" && path == "/markets") {
+        std::string slug = queryParam(target, "slug");
+        if (!slug.empty()) {
+            countRoute("markets?slug");
+            auto it = gammaBySlug.find(slug);
+            response.body = it != gammaBySlug.end() ? "[" + gammaMarkets[it->second] + "]" : "[]";
+            return response;
+        }
+        countRoute("markets page");
+        std::string offsetParam = queryParam(target, "offset");
+        std::string limitParam = queryParam(target, "limit");
+        size_t offset = offsetParam.empty() ? 0 : std::stoul(offsetParam);
+        size_t limit = limitParam.empty() ? 100 : std::stoul(limitParam);
+        // Gamma's sport tags, narrowed the same way the real listing is: by the league in the slug
+        static const std::map<std::string, std::string> tagPrefixes = {
+            {"745", "nba-"}, {"899", "nhl-"}, {"100381", "mlb-"}};
+        std::string tagId = queryParam(target, "tag_id");
+        std::string prefix;
+        if (!tagId.empty()) {
+            auto tag = tagPrefixes.find(tagId);
+            prefix = tag != tagPrefixes.end() ? tag->second : "\n";  // Unknown tags list nothing
+        }
+        response.body = "[";
+        size_t listed = 0;
+        size_t written = 0;
+        for (size_t index = 0; index < gammaMarkets.size(); ++index) {
+            if (gammaSlugs[index].rfind(prefix, 0) != 0) {
+                continue;
+            }
+            if (listed++ < offset) {
+                continue;
+            }
+            if (written == limit) {
+                break;
+            }
+            if (written++ != 0) {
+                response.body += ",";
+            }
+            response.body += gammaMarkets[index];
+        }
+        response.body += "]";
+        return response;
+    }
+
+    if (method == "GET" && path.rfind("/markets/", 0) == 0) {
+        countRoute("markets/{id}");
+        auto it = gammaById.find(path.substr(9));
+        if (it == gammaById.end()) {
+            std::lock_guard<std::mutex> lock(statsMutex);
+            stats.notFound++;
+            response.status = 404;
+            response.body = "{\"error\":\"market not found\"}";
+            return response;
+        }
+        response.body = gammaMarkets[it->second];
+        return response;
+    }
+
+    if (method == "GET" && path == "/positions") {
+        countRoute("positions");
+        response.body = "[]";
+        return response;
+    }
+
+    if (method == "GET" && path == "/value") {
+        countRoute("value");
+        response.body = nlohmann::json::array({{{"user", queryParam(target, "user")}, {"value", 10000.0}}}).dump();
+        return response;
+    }
+
+    if (method == "POST" && path == "/order") {
+        countRoute("order");
+        response.body = nlohmann::json{{"success", true},
+                                       {"errorMsg", ""},
+                                       {"orderId", "stub-order-" + std::to_string(++orderSequence)},
+                                       {"orderHashes", nlohmann::json::array()}}.dump();
+        return response;
+    }
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats.notFound++;
+    response.status = 404;
+    response.body = "{\"error\":\"no stub route for " + method + " " + path + "\"}";
+    return response;
+}
+
+StubApiServer::Stats StubApiServer::getStats() const {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return stats;
+}
+
+void StubApiServer::logStats() const {
+    Stats current = getStats();
+    std::cout << "[StubApiServer] " << current.requests << " requests, " << current.throttled << " throttled, "
+              << current.errors << " injected errors, " << current.notFound << " not found, " << current.fromArchive
+              << " from archive, " << current.wsSessions << " WebSocket sessions (" << current.wsFrames << " frames)"
+              << std::endl;
+    for (const auto& route : current.byRoute) {
+        std::cout << "[StubApiServer]   " << route.first << ": " << route.second << std::endl;
+    }
+}
+
+} // namespace stub
+} // namespace polymarket_bot
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "../api/transport_backend.h"
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace polymarket_bot {
+namespace stub {
+
+struct StubServerOptions {
+    std::string host = "127.0.0.1";
+    int port = 8900;
+
+    // Synthetic fixtures
+    int gamesPerSport = 150;          // Odds games (and matching Gamma markets) per supported sport
+    int fillerMarkets = 2000;         // Unrelated Gamma markets that only show up when paging
+    std::string archivePath;          // Recorded exchanges (--record) served before synthetic data
+    std::string wsFramesPath;         // Market channel frames recorded by ClobMarketFeed, replayed on /ws/market
+    int wsIntervalMs = 1000;          // Synthetic price_change cadence when no frames are replayed
+
+    // Fault injection
+    int latencyMs = 0;                // Added to every response
+    int jitterMs = 0;                 // Uniform extra latency in [0, jitterMs]
+    double errorRate = 0.0;           // Fraction of requests answered with 500
+    double throttleRate = 0.0;        // Fraction of requests answered with 429
+    int maxRequestsPerSecond = 0;     // Server-wide limit, excess gets 429 (0 = unlimited)
+    int retryAfterSeconds = 1;        // Retry-After sent with every 429
+    int oddsQuota = 20000;            // Starting x-requests-remaining for the odds endpoint
+};
+
+// Local stand-in for the Gamma, Data, CLOB and Odds APIs.
+//
+// Serves every route the bot calls from one port, so a config can point
+// gammaBaseUrl, dataBaseUrl, baseUrl and the odds baseUrl (with its /v4
+// suffix) at the same address:
+//   GET  /markets?slug=...            GET  /markets?offset=..&limit=..
+//   GET  /markets/{id}                GET  /positions?user=...
+//   GET  /value?user=...              POST /order
+//   GET  /v4/sports/{sport}/odds      WebSocket /ws/market
+// Synthetic odds games and Gamma markets are generated once at start-up with
+// slugs the matcher will derive for them; the odds route honours eventIds.
+// Each connection gets its own thread; latency, errors and 429s are injected
+// per request. The CLOB market channel on /ws/market replays recorded frames
+// with their original timing, or sends a book per subscribed token and then
+// random-walk price changes.
+class StubApiServer {
+public:
+    explicit StubApiServer(const StubServerOptions& options);
+    ~StubApiServer();
+
+    bool start();
+    void stop();
+    bool isRunning() const { return running; }
+
+    struct Stats {
+        size_t requests = 0;
+        size_t errors = 0;            // Injected 500s
+        size_t throttled = 0;         // 429s, injected or over maxRequestsPerSecond
+        size_t fromArchive = 0;
+        size_t notFound = 0;
+        size_t wsSessions = 0;
+        size_t wsFrames = 0;          // Market channel frames sent
+        std::map<std::string, size_t> byRoute;
+    };
+    Stats getStats() const;
+    void logStats() const;
+
+private:
+    struct Response {
+        int status = 200;
+        std::string body;
+        std::vector<std::string> headers;
+    };
+
+    StubApiServer(const StubApiServer&) = delete;
+    StubApiServer& operator=(const StubApiServer&) = delete;
+
+    void buildFixtures();
+    void loadArchive();
+    void acceptLoop();
+    void serveConnection(int fd);
+    void loadWsFrames();
+    void serveWebSocket(int fd, std::string pending);
+    Response route(const std::string& method, const std::string& target, const std::string& body);
+    bool overRateLimit();
+    void countRoute(const std::string& route);
+
+    static std::string queryParam(const std::string& target, const std::string& name);
+
+    StubServerOptions options;
+    std::atomic<bool> running;
+    int listenFd;
+    std::thread acceptThread;
+
+    // Connection threads are detached; stop() waits for openConnections to drain
+    std::mutex connectionsMutex;
+    std::condition_variable connectionsClosed;
+    std::vector<int> openConnections;
+
+    // Fixtures are immutable once start() returns
+    std::unordered_map<std::string, std::string> oddsBySport;        // sport -> odds body (unix dates)
+    std::unordered_map<std::string, std::string> isoOddsBySport;     // sport -> odds body (ISO dates)
+    std::vector<std::string> gammaMarkets;                           // serialized market objects, paging order
+    std::vector<std::string> gammaSlugs;                             // slug of each gammaMarkets entry
+    std::unordered_map<std::string, size_t> gammaBySlug;
+    std::unordered_map<std::string, size_t> gammaById;
+    std::unordered_map<std::string, api::HttpResponse> archived;     // loose key -> recorded response
+    std::unordered_map<std::string, double> tokenPrices;             // CLOB token -> starting mid price
+    std::vector<std::pair<long long, std::string>> wsFrames;         // ms after subscribe -> payload
+
+    std::atomic<int> oddsRemaining;
+    std::atomic<long> orderSequence;
+
+    mutable std::mutex statsMutex;
+    Stats stats;
+    long rateWindowSecond;
+    int rateWindowCount;
+};
+
+} // namespace stub
+} // namespace polymarket_bot
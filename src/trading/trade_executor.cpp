@@ -5,6 +5,7 @@
 #include <iostream>
 #include <algorithm>
 #include <cmath>
+#include <thread>
 
 using namespace polymarket_bot::trading;
 using namespace polymarket_bot::api;
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "../src/common/bounded_queue.h"
+#include "../src/common/pipeline.h"
+#include <atomic>
+#include <future>
+#include <thread>
+
+namespace polymarket_bot {
+namespace common {
+namespace test {
+
+using namespace std::chrono_literals;
+
+// Test that items come out in push order
+TEST(BoundedQueueTest, PopsInPushOrder) {
+    BoundedQueue<int> queue(4);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(queue.push(i));
+    }
+    EXPECT_EQ(queue.size(), 3u);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(queue.pop(), i);
+    }
+}
+
+// Test that a full queue blocks the producer until a consumer makes room
+TEST(BoundedQueueTest, FullQueueBlocksProducer) {
+    BoundedQueue<int> queue(2);
+    queue.push(1);
+    queue.push(2);
+
+    std::atomic<bool> pushed{false};
+    std::thread producer([&]() {
+        queue.push(3);
+        pushed = true;
+    });
+    std::this_thread::sleep_for(50ms);
+    EXPECT_FALSE(pushed.load());
+    EXPECT_EQ(queue.size(), 2u);
+
+    EXPECT_EQ(queue.pop(), 1);
+    producer.join();
+    EXPECT_TRUE(pushed.load());
+    EXPECT_EQ(queue.pop(), 2);
+    EXPECT_EQ(queue.pop(), 3);
+
+    QueueStats stats = queue.stats();
+    EXPECT_EQ(stats.pushed, 3u);
+    EXPECT_EQ(stats.maxDepth, 2u);
+    EXPECT_GT(stats.pushWaitMs, 0.0);
+}
+
+// Test that a closed queue is drained before pop reports the end
+TEST(BoundedQueueTest, CloseDrainsThenEnds) {
+    BoundedQueue<int> queue(4);
+    queue.push(1);
+    queue.push(2);
+    queue.close();
+
+    EXPECT_FALSE(queue.push(3));
+    EXPECT_EQ(queue.pop(), 1);
+    EXPECT_EQ(queue.pop(), 2);
+    EXPECT_EQ(queue.pop(), std::nullopt);
+}
+
+// Test that close wakes a blocked consumer and a blocked producer
+TEST(BoundedQueueTest, CloseWakesBlockedThreads) {
+    BoundedQueue<int> empty(1);
+    auto consumer = std::async(std::launch::async, [&]() { return empty.pop(); });
+
+    BoundedQueue<int> full(1);
+    full.push(1);
+    auto producer = std::async(std::launch::async, [&]() { return full.push(2); });
+
+    std::this_thread::sleep_for(20ms);
+    empty.close();
+    full.close();
+    EXPECT_EQ(consumer.get(), std::nullopt);
+    EXPECT_FALSE(producer.get());
+    EXPECT_EQ(full.pop(), 1);
+}
+
+// Test that a pipeline with a tiny queue still delivers every item, and closes each queue when its stage ends
+TEST(PipelineTest, DeliversEveryItemThroughSmallQueues) {
+    Pipeline pipeline;
+    auto numbers = pipeline.queue<int>("numbers", 1);
+    auto doubled = pipeline.queue<int>("doubled", 1);
+
+    pipeline.source<int>("produce", 1, numbers, [](const auto& emit) {
+        for (int i = 1; i <= 100; ++i) {
+            emit(i);
+        }
+    });
+    pipeline.stage<int, int>("double", 3, numbers, doubled, [](int n, const auto& emit) { emit(n * 2); });
+    std::atomic<int> sum{0};
+    std::atomic<int> count{0};
+    pipeline.sink<int>("sum", 1, doubled, [&](int n) {
+        sum += n;
+        count++;
+    });
+    pipeline.run();
+
+    EXPECT_EQ(count.load(), 100);
+    EXPECT_EQ(sum.load(), 100 * 101);
+    EXPECT_EQ(numbers->pop(), std::nullopt);
+    EXPECT_EQ(doubled->pop(), std::nullopt);
+}
+
+} // namespace test
+} // namespace common
+} // namespace polymarket_bot
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "../src/api/coro_task.h"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace polymarket_bot {
+namespace api {
+namespace test {
+
+// Resumes the awaiting coroutine on a new thread after a delay, as a transport completion would
+struct ResumeLater {
+    std::chrono::milliseconds delay;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) const {
+        std::thread([handle, delay = delay]() {
+            std::this_thread::sleep_for(delay);
+            handle.resume();
+        }).detach();
+    }
+    void await_resume() const noexcept {}
+};
+
+Task<int> answerAfter(int value, int delayMs) {
+    co_await ResumeLater{std::chrono::milliseconds(delayMs)};
+    co_return value;
+}
+
+Task<int> failAfter(int delayMs) {
+    co_await ResumeLater{std::chrono::milliseconds(delayMs)};
+    throw std::runtime_error("request failed");
+}
+
+Task<int> addBoth(int first, int second) {
+    int a = co_await answerAfter(first, 1);
+    int b = co_await answerAfter(second, 1);
+    co_return a + b;
+}
+
+Task<int> countConcurrent(int value, std::atomic<int>& running, std::atomic<int>& peak) {
+    int now = ++running;
+    int seen = peak.load();
+    while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+    }
+    co_await ResumeLater{std::chrono::milliseconds(5)};
+    --running;
+    co_return value;
+}
+
+// Test that syncWait returns the value of a task that finishes on another thread
+TEST(CoroTaskTest, SyncWaitReturnsValue) {
+    EXPECT_EQ(syncWait(answerAfter(42, 5)), 42);
+    EXPECT_EQ(syncWait(addBoth(2, 3)), 5);
+}
+
+// Test that syncWait rethrows what the task threw, and handles void tasks
+TEST(CoroTaskTest, SyncWaitRethrows) {
+    EXPECT_THROW(syncWait(failAfter(1)), std::runtime_error);
+
+    bool ran = false;
+    auto sideEffect = [&]() -> Task<void> {
+        co_await ResumeLater{std::chrono::milliseconds(1)};
+        ran = true;
+    };
+    syncWait(sideEffect());
+    EXPECT_TRUE(ran);
+}
+
+// Test that tasks are lazy: nothing runs until the task is awaited
+TEST(CoroTaskTest, TasksStartWhenAwaited) {
+    bool started = false;
+    auto lazy = [&]() -> Task<int> {
+        started = true;
+        co_return 1;
+    };
+    Task<int> task = lazy();
+    EXPECT_FALSE(started);
+    EXPECT_EQ(syncWait(std::move(task)), 1);
+    EXPECT_TRUE(started);
+}
+
+// Test that whenAll returns results in task order whatever order the tasks finish in
+TEST(CoroTaskTest, WhenAllKeepsTaskOrder) {
+    std::vector<Task<int>> tasks;
+    tasks.push_back(answerAfter(0, 30));
+    tasks.push_back(answerAfter(1, 1));
+    tasks.push_back(answerAfter(2, 15));
+    tasks.push_back(answerAfter(3, 5));
+    EXPECT_EQ(syncWait(whenAll(std::move(tasks))), (std::vector<int>{0, 1, 2, 3}));
+
+    EXPECT_TRUE(syncWait(whenAll(std::vector<Task<int>>{})).empty());
+}
+
+// Test that whenAll runs at most maxConcurrent tasks at a time, and all of them at once with no cap
+TEST(CoroTaskTest, WhenAllCapsConcurrency) {
+    std::atomic<int> running{0};
+    std::atomic<int> peak{0};
+    std::vector<Task<int>> tasks;
+    for (int i = 0; i < 12; ++i) {
+        tasks.push_back(countConcurrent(i, running, peak));
+    }
+    auto results = syncWait(whenAll(std::move(tasks), 3));
+    ASSERT_EQ(results.size(), 12u);
+    EXPECT_EQ(results[11], 11);
+    EXPECT_EQ(peak.load(), 3);
+
+    peak = 0;
+    tasks.clear();
+    for (int i = 0; i < 6; ++i) {
+        tasks.push_back(countConcurrent(i, running, peak));
+    }
+    syncWait(whenAll(std::move(tasks)));
+    EXPECT_EQ(peak.load(), 6);
+}
+
+// Test that whenAll lets every task finish before rethrowing the first failure
+TEST(CoroTaskTest, WhenAllRethrowsAfterAllFinish) {
+    std::atomic<int> finished{0};
+    auto counted = [&](int delayMs) -> Task<int> {
+        co_await ResumeLater{std::chrono::milliseconds(delayMs)};
+        ++finished;
+        co_return delayMs;
+    };
+    std::vector<Task<int>> tasks;
+    tasks.push_back(failAfter(1));
+    tasks.push_back(counted(20));
+    tasks.push_back(counted(10));
+    EXPECT_THROW(syncWait(whenAll(std::move(tasks))), std::runtime_error);
+    EXPECT_EQ(finished.load(), 2);
+}
+
+} // namespace test
+} // namespace api
+} // namespace polymarket_bot
@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include "../src/api/gamma_market_decoder.h"
+
+namespace polymarket_bot {
+namespace api {
+namespace test {
+
+using common::GammaMarket;
+
+const std::string page = R"([
+    {"id": "501", "question": "Celtics vs. Hawks", "conditionId": "0x9f3c1a2b4d5e6f708192a3b4c5d6e7f8091a2b3c4d5e6f708192a3b4c5d6e7f8",
+     "slug": "nba-bos-atl-2026-11-01", "description": "Resolves \"Celtics\" if Boston wins. Café rules apply.",
+     "outcomes": "[\"Celtics\", \"Hawks\"]", "outcomePrices": "[\"0.68\", \"0.32\"]",
+     "clobTokenIds": "[\"1111\", \"2222\"]", "volume": "12345.6", "volumeNum": 12345.6, "liquidityNum": 5400.25,
+     "bestBid": 0.67, "bestAsk": 0.69, "lastTradePrice": 0.68, "spread": 0.02, "active": true, "closed": false,
+     "acceptingOrders": true, "endDateIso": "2026-11-01", "negRisk": false, "volume24hr": 800,
+     "events": [{"id": "77", "title": "Celtics vs. Hawks", "tags": [{"label": "NBA"}]}]},
+    {"id": "502", "question": "Nets vs. Raptors", "slug": "nba-bkn-tor-2026-11-01",
+     "outcomes": "[\"Nets\", \"Raptors\"]", "outcomePrices": "[\"0.45\", \"0.55\"]",
+     "volumeNum": 0, "active": true, "closed": false, "rewardsMinSize": 50}
+])";
+
+// Test that the projected decode reads the projected fields exactly as the full from_json parse does
+TEST(GammaMarketDecoderTest, ProjectionMatchesFullParse) {
+    auto full = GammaMarketDecoder::decodePageDom(page);
+    auto projected = GammaMarketDecoder::decodePage(page, GammaProjection::matching());
+    ASSERT_TRUE(full.has_value());
+    ASSERT_TRUE(projected.has_value());
+    ASSERT_EQ(projected->size(), full->size());
+
+    for (size_t i = 0; i < full->size(); ++i) {
+        const GammaMarket& expected = (*full)[i];
+        const GammaMarket& actual = (*projected)[i].market;
+        EXPECT_EQ(actual.id, expected.id);
+        EXPECT_EQ(actual.slug, expected.slug);
+        EXPECT_EQ(actual.conditionId, expected.conditionId);
+        EXPECT_EQ(actual.question, expected.question);
+        EXPECT_EQ(actual.outcomes, expected.outcomes);
+        EXPECT_EQ(actual.outcomePrices, expected.outcomePrices);
+        EXPECT_EQ(actual.clobTokenIds, expected.clobTokenIds);
+        EXPECT_EQ(actual.volumeNum, expected.volumeNum);
+        EXPECT_EQ(actual.liquidityNum, expected.liquidityNum);
+        EXPECT_EQ(actual.bestBid, expected.bestBid);
+        EXPECT_EQ(actual.bestAsk, expected.bestAsk);
+        EXPECT_EQ(actual.lastTradePrice, expected.lastTradePrice);
+        EXPECT_EQ(actual.spread, expected.spread);
+        EXPECT_EQ(actual.active, expected.active);
+        EXPECT_EQ(actual.closed, expected.closed);
+        EXPECT_EQ(actual.acceptingOrders, expected.acceptingOrders);
+        EXPECT_EQ(actual.endDateIso, expected.endDateIso);
+
+        // Fields outside the projection are not read
+        EXPECT_EQ(actual.description, std::nullopt);
+        EXPECT_EQ(actual.volume, std::nullopt);
+        EXPECT_EQ(actual.rewardsMinSize, std::nullopt);
+    }
+}
+
+// Test that full() on a projected market decodes every field the DOM path does
+TEST(GammaMarketDecoderTest, FullRecoversUnprojectedFields) {
+    auto full = GammaMarketDecoder::decodePageDom(page);
+    auto projected = GammaMarketDecoder::decodePage(page, GammaProjection::matching());
+    ASSERT_TRUE(full.has_value());
+    ASSERT_TRUE(projected.has_value());
+
+    GammaMarket first = (*projected)[0].full();
+    EXPECT_EQ(first.description, (*full)[0].description);
+    EXPECT_EQ(first.description, "Resolves \"Celtics\" if Boston wins. Caf\xC3\xA9 rules apply.");
+    EXPECT_EQ(first.volume, (*full)[0].volume);
+    EXPECT_EQ(first.negRisk, (*full)[0].negRisk);
+    EXPECT_EQ(first.volume24hr, (*full)[0].volume24hr);
+    EXPECT_EQ((*projected)[1].full().rewardsMinSize, (*full)[1].rewardsMinSize);
+}
+
+// Test that the outcome arrays are decoded on the same pass, token ids lined up with names
+TEST(GammaMarketDecoderTest, DecodesOutcomeArrays) {
+    auto projected = GammaMarketDecoder::decodePage(page, GammaProjection::matching());
+    ASSERT_TRUE(projected.has_value());
+
+    const auto& first = (*projected)[0];
+    ASSERT_EQ(first.outcomeError, OutcomeError::None);
+    ASSERT_EQ(first.outcomes.size(), 2u);
+    EXPECT_EQ(first.outcomes[0].name, "Celtics");
+    EXPECT_DOUBLE_EQ(first.outcomes[0].price, 0.68);
+    EXPECT_EQ(first.outcomes[0].tokenId, "1111");
+    EXPECT_EQ(first.outcomes[1].tokenId, "2222");
+
+    // No clobTokenIds: still priced, with empty token ids
+    const auto& second = (*projected)[1];
+    ASSERT_EQ(second.outcomeError, OutcomeError::None);
+    EXPECT_EQ(second.outcomes[1].name, "Raptors");
+    EXPECT_EQ(second.outcomes[1].tokenId, "");
+}
+
+// Test that a projection without keepRaw leaves raw empty, and that structural errors fail the page
+TEST(GammaMarketDecoderTest, RawAndStructuralErrors) {
+    GammaProjection slugOnly({"slug"}, false);
+    auto decoded = GammaMarketDecoder::decodePage(page, slugOnly);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ((*decoded)[0].market.slug, "nba-bos-atl-2026-11-01");
+    EXPECT_EQ((*decoded)[0].market.id, std::nullopt);
+    EXPECT_TRUE((*decoded)[0].raw.empty());
+
+    EXPECT_EQ(GammaMarketDecoder::decodePage("[]", slugOnly)->size(), 0u);
+    EXPECT_EQ(GammaMarketDecoder::decodePage(R"({"error": "rate limited"})", slugOnly), std::nullopt);
+    EXPECT_EQ(GammaMarketDecoder::decodePage(R"([{"slug": "a"},)", slugOnly), std::nullopt);
+    EXPECT_EQ(GammaMarketDecoder::decodePage(R"([{"slug": "a"}] trailing)", slugOnly), std::nullopt);
+}
+
+GammaMarket withOutcomes(std::optional<std::string> names, std::optional<std::string> prices,
+                         std::optional<std::string> tokens = std::nullopt) {
+    GammaMarket market;
+    market.outcomes = std::move(names);
+    market.outcomePrices = std::move(prices);
+    market.clobTokenIds = std::move(tokens);
+    return market;
+}
+
+// Test that absent outcome fields are reported as missing
+TEST(GammaMarketDecoderTest, OutcomeErrorMissing) {
+    std::vector<GammaOutcome> outcomes;
+    EXPECT_EQ(GammaMarketDecoder::decodeOutcomes(withOutcomes(std::nullopt, R"(["0.5"])"), outcomes),
+              OutcomeError::Missing);
+    EXPECT_EQ(GammaMarketDecoder::decodeOutcomes(withOutcomes(R"(["Yes"])", std::nullopt), outcomes),
+              OutcomeError::Missing);
+
+    // Not projected counts as not sent
+    auto decoded = GammaMarketDecoder::decodePage(page, GammaProjection({"slug"}));
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ((*decoded)[0].outcomeError, OutcomeError::Missing);
+    EXPECT_TRUE((*decoded)[0].outcomes.empty());
+}
+
+// Test that arrays that are not arrays of strings, or prices that are not numbers, are malformed
+TEST(GammaMarketDecoderTest, OutcomeErrorMalformed) {
+    std::vector<GammaOutcome> outcomes;
+    EXPECT_EQ(GammaMarketDecoder::decodeOutcomes(withOutcomes("Yes, No", R"(["0.5", "0.5"])"), outcomes),
+              OutcomeError::Malformed);
+    EXPECT_EQ(GammaMarketDecoder::decodeOutcomes(withOutcomes(R"(["Yes", "No")", R"(["0.5", "0.5"])"), outcomes),
+              OutcomeError::Malformed);
+    EXPECT_EQ(GammaMarketDecoder::decodeOutcomes(withOutcomes(R"([["Yes"], "No"])", R"(["0.5", "0.5"])"), outcomes),
+              OutcomeError::Malformed);
+    EXPECT_EQ(GammaMarketDecoder::decodeOutcomes(withOutcomes(R"(["Yes", "No"])", R"(["0.5", "0.5"] x)"), outcomes),
+              OutcomeError::Malformed);
+    EXPECT_EQ(GammaMarketDecoder::decodeOutcomes(withOutcomes(R"(["Yes", "No"])", R"(["0.5", "abc"])"), outcomes),
+              OutcomeError::Malformed);
+    EXPECT_TRUE(outcomes.empty());
+    EXPECT_EQ(GammaMarketDecoder::decodeOutcomes(withOutcomes(R"(["Yes", "No"])", R"(["0.5", "0.5"])", "{}"),
+                                                 outcomes),
+              OutcomeError::Malformed);
+
+    // Prices sent as bare numbers are accepted
+    EXPECT_EQ(GammaMarketDecoder::decodeOutcomes(withOutcomes(R"(["Yes", "No"])", "[0.25, 0.75]"), outcomes),
+              OutcomeError::None);
+    EXPECT_DOUBLE_EQ(outcomes[1].price, 0.75);
+}
+
+// Test that names, prices and token ids of different lengths are mismatched
+TEST(GammaMarketDecoderTest, OutcomeErrorMismatched) {
+    std::vector<GammaOutcome> outcomes;
+    EXPECT_EQ(GammaMarketDecoder::decodeOutcomes(withOutcomes(R"(["Yes", "No"])", R"(["0.5", "0.3", "0.2"])"),
+                                                 outcomes),
+              OutcomeError::Mismatched);
+    EXPECT_EQ(GammaMarketDecoder::decodeOutcomes(withOutcomes(R"(["Yes", "No"])", R"(["0.5", "0.5"])", R"(["1"])"),
+                                                 outcomes),
+              OutcomeError::Mismatched);
+    EXPECT_TRUE(outcomes.empty());
+
+    // An empty token list means no CLOB tokens, not a mismatch
+    EXPECT_EQ(GammaMarketDecoder::decodeOutcomes(withOutcomes(R"(["Yes", "No"])", R"(["0.5", "0.5"])", "[]"),
+                                                 outcomes),
+              OutcomeError::None);
+}
+
+// Test that a bad outcome array marks only its own market and leaves the page decoded
+TEST(GammaMarketDecoderTest, OutcomeErrorMarksOneMarket) {
+    auto decoded = GammaMarketDecoder::decodePage(
+        R"([{"slug": "a", "outcomes": "[\"Yes\", \"No\"]", "outcomePrices": "[\"0.5\"]"},
+            {"slug": "b", "outcomes": "not json", "outcomePrices": "[\"0.5\", \"0.5\"]"},
+            {"slug": "c", "outcomes": "[\"Yes\", \"No\"]", "outcomePrices": "[\"0.4\", \"0.6\"]"}])",
+        GammaProjection::matching());
+    ASSERT_TRUE(decoded.has_value());
+    ASSERT_EQ(decoded->size(), 3u);
+    EXPECT_EQ((*decoded)[0].outcomeError, OutcomeError::Mismatched);
+    EXPECT_EQ((*decoded)[1].outcomeError, OutcomeError::Malformed);
+    EXPECT_EQ((*decoded)[2].outcomeError, OutcomeError::None);
+    EXPECT_EQ((*decoded)[2].outcomes.size(), 2u);
+    EXPECT_STREQ(outcomeErrorName(OutcomeError::Mismatched), "outcomes, prices and tokens do not line up");
+}
+
+} // namespace test
+} // namespace api
+} // namespace polymarket_bot
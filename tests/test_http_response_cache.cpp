@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include "../src/api/http_response_cache.h"
+#include "../src/api/async_http_engine.h"
+#include "../src/api/transport_backend.h"
+#include <algorithm>
+#include <atomic>
+
+namespace polymarket_bot {
+namespace api {
+namespace test {
+
+HttpResponse responseWithHeaders(long status, std::map<std::string, std::string> headers, std::string body = "") {
+    HttpResponse response;
+    response.statusCode = status;
+    response.headers = std::move(headers);
+    response.body = std::move(body);
+    return response;
+}
+
+bool hasHeader(const HttpRequest& request, const std::string& header) {
+    return std::find(request.headers.begin(), request.headers.end(), header) != request.headers.end();
+}
+
+// Answers 304 to any conditional request and 200 with an ETag otherwise
+class NotModifiedBackend : public TransportBackend {
+public:
+    HttpResponse perform(const HttpRequest& request) override {
+        requests++;
+        bool conditional = std::any_of(request.headers.begin(), request.headers.end(), [](const std::string& header) {
+            return header.rfind("If-None-Match:", 0) == 0;
+        });
+        return conditional ? responseWithHeaders(304, {}) : responseWithHeaders(200, {{"etag", "\"v2\""}}, "[1,2,3]");
+    }
+    void performAsync(HttpRequest request, Callback callback) override { callback(perform(request)); }
+    const char* name() const override { return "not-modified"; }
+
+    std::atomic<int> requests{0};
+};
+
+// Test that a 200 with an ETag is parsed once and a later 304 reuses the parsed object
+TEST(HttpResponseCacheTest, NotModifiedReusesParsedResult) {
+    auto& cache = HttpResponseCache::getInstance();
+    const std::string url = "https://cache.example.com/hit";
+    int parses = 0;
+    std::function<size_t(const std::string&)> parse = [&parses](const std::string& body) {
+        parses++;
+        return body.size();
+    };
+
+    auto first = cache.resolve<size_t>(url, responseWithHeaders(200, {{"etag", "\"v1\""}}, "abcd"), parse);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(*first, 4u);
+    EXPECT_TRUE(cache.holds(url));
+
+    HttpRequest request;
+    request.url = url;
+    cache.addValidators(request);
+    EXPECT_TRUE(hasHeader(request, "If-None-Match: \"v1\""));
+
+    auto second = cache.resolve<size_t>(url, responseWithHeaders(304, {}), parse);
+    EXPECT_EQ(second, first);
+    EXPECT_EQ(parses, 1);
+    EXPECT_EQ(cache.resolveBody(url, responseWithHeaders(304, {})), "abcd");
+}
+
+// Test that a 304 for a URL the cache does not hold is reported as a failure, not an empty result
+TEST(HttpResponseCacheTest, NotModifiedWithoutEntryIsNotAResult) {
+    auto& cache = HttpResponseCache::getInstance();
+    const std::string url = "https://cache.example.com/miss";
+    size_t orphaned = cache.getStats().orphaned;
+    std::function<size_t(const std::string&)> parse = [](const std::string& body) { return body.size(); };
+
+    EXPECT_FALSE(cache.holds(url));
+    EXPECT_EQ(cache.resolve<size_t>(url, responseWithHeaders(304, {}), parse), nullptr);
+    EXPECT_EQ(cache.getStats().orphaned, orphaned + 1);
+}
+
+// Test that notModifiedBody stores a 200 and hands back its body only for a later usable 304
+TEST(HttpResponseCacheTest, NotModifiedBodyOnlyFor304) {
+    auto& cache = HttpResponseCache::getInstance();
+    const std::string url = "https://cache.example.com/body-only";
+
+    EXPECT_EQ(cache.notModifiedBody(url, responseWithHeaders(200, {{"etag", "\"b1\""}}, "[1,2]")), std::nullopt);
+    EXPECT_TRUE(cache.holds(url));
+    EXPECT_EQ(cache.notModifiedBody(url, responseWithHeaders(304, {})), "[1,2]");
+    EXPECT_EQ(cache.notModifiedBody(url, responseWithHeaders(429, {}, "slow down")), std::nullopt);
+    EXPECT_EQ(cache.notModifiedBody("https://cache.example.com/body-only-miss", responseWithHeaders(304, {})),
+              std::nullopt);
+}
+
+// Test that a 200 without validators drops whatever the cache held for the URL
+TEST(HttpResponseCacheTest, UncacheableResponseDropsEntry) {
+    auto& cache = HttpResponseCache::getInstance();
+    const std::string url = "https://cache.example.com/uncacheable";
+    std::function<size_t(const std::string&)> parse = [](const std::string& body) { return body.size(); };
+
+    cache.resolve<size_t>(url, responseWithHeaders(200, {{"last-modified", "Tue, 01 Sep 2026 00:00:00 GMT"}}, "x"), parse);
+    EXPECT_TRUE(cache.holds(url));
+    cache.resolve<size_t>(url, responseWithHeaders(200, {}, "xy"), parse);
+    EXPECT_FALSE(cache.holds(url));
+}
+
+// Test that stripValidators removes only the conditional headers
+TEST(HttpResponseCacheTest, StripValidatorsKeepsOtherHeaders) {
+    HttpRequest request;
+    request.headers = {"Content-Type: application/json", "If-None-Match: \"v1\"",
+                       "If-Modified-Since: Tue, 01 Sep 2026 00:00:00 GMT"};
+
+    EXPECT_TRUE(HttpResponseCache::hasValidators(request));
+    EXPECT_TRUE(HttpResponseCache::stripValidators(request));
+    EXPECT_EQ(request.headers, std::vector<std::string>{"Content-Type: application/json"});
+    EXPECT_FALSE(HttpResponseCache::hasValidators(request));
+    EXPECT_FALSE(HttpResponseCache::stripValidators(request));
+}
+
+// Test that the engine re-sends a conditional request whose 304 the cache can no longer answer
+TEST(HttpResponseCacheTest, EngineRetriesOrphanedNotModified) {
+    auto backend = std::make_shared<NotModifiedBackend>();
+    HttpTransport::getInstance().setBackend(backend);
+
+    HttpRequest request;
+    request.url = "https://cache.example.com/evicted";
+    request.headers = {"If-None-Match: \"v1\""};
+    HttpResponse response = AsyncHttpEngine::getInstance().submit(std::move(request)).get();
+
+    HttpTransport::getInstance().setBackend(nullptr);
+    EXPECT_EQ(response.statusCode, 200);
+    EXPECT_EQ(response.body, "[1,2,3]");
+    EXPECT_EQ(backend->requests.load(), 2);
+}
+
+// Test that a 304 the cache can answer is passed through without a second request
+TEST(HttpResponseCacheTest, EngineKeepsAnswerableNotModified) {
+    auto& cache = HttpResponseCache::getInstance();
+    const std::string url = "https://cache.example.com/held";
+    cache.resolveBody(url, responseWithHeaders(200, {{"etag", "\"v1\""}}, "held"));
+
+    auto backend = std::make_shared<NotModifiedBackend>();
+    HttpTransport::getInstance().setBackend(backend);
+
+    HttpRequest request;
+    request.url = url;
+    cache.addValidators(request);
+    HttpResponse response = AsyncHttpEngine::getInstance().submit(std::move(request)).get();
+
+    HttpTransport::getInstance().setBackend(nullptr);
+    EXPECT_EQ(response.statusCode, 304);
+    EXPECT_EQ(backend->requests.load(), 1);
+    EXPECT_EQ(cache.resolveBody(url, response), "held");
+}
+
+} // namespace test
+} // namespace api
+} // namespace polymarket_bot
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "../src/market/market_matcher.h"
+#include "../src/api/transport_backend.h"
+#include <atomic>
+
+namespace polymarket_bot {
+namespace test {
+
+using api::HttpRequest;
+using api::HttpResponse;
+
+// Answers every request with the same canned response
+class CannedBackend : public api::TransportBackend {
+public:
+    HttpResponse perform(const HttpRequest&) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        return response;
+    }
+    void performAsync(HttpRequest request, Callback callback) override { callback(perform(request)); }
+    const char* name() const override { return "canned"; }
+
+    void answer(long status, std::string body) {
+        std::lock_guard<std::mutex> lock(mutex);
+        response = HttpResponse();
+        response.statusCode = status;
+        response.body = std::move(body);
+    }
+
+private:
+    std::mutex mutex;
+    HttpResponse response;
+};
+
+const char* twoGames = R"([
+    {"id": "g1", "sport_key": "basketball_nba", "commence_time": "2026-11-01T00:00:00Z",
+     "home_team": "Boston Celtics", "away_team": "Atlanta Hawks", "bookmakers": []},
+    {"id": "g2", "sport_key": "basketball_nba", "commence_time": "2026-11-01T02:00:00Z",
+     "home_team": "Brooklyn Nets", "away_team": "Atlanta Hawks", "bookmakers": []}
+])";
+
+class RefreshGamesTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        backend = std::make_shared<CannedBackend>();
+        api::HttpTransport::getInstance().setBackend(backend);
+        matcher = std::make_unique<MarketMatcher>(
+            api::PolymarketApiClient("https://clob.example.com", "https://gamma.example.com", "https://data.example.com",
+                                     "", "", "", "", "", 137),
+            api::OddsApiClient(), config::ConfigManager::getInstance());
+
+        backend->answer(200, twoGames);
+        matcher->refreshGames(requested);
+        ASSERT_EQ(matcher->getOddsGames().size(), 2u);
+    }
+
+    void TearDown() override {
+        api::HttpTransport::getInstance().setBackend(nullptr);
+    }
+
+    std::map<std::string, std::vector<std::string>> requested = {{"basketball_nba", {"g1", "g2"}}};
+    std::shared_ptr<CannedBackend> backend;
+    std::unique_ptr<MarketMatcher> matcher;
+};
+
+// Test that a throttled poll leaves the tracked games in place
+TEST_F(RefreshGamesTest, ThrottledPollKeepsGames) {
+    backend->answer(429, R"({"message": "Too many requests"})");
+    matcher->refreshGames(requested);
+    EXPECT_EQ(matcher->getOddsGames().size(), 2u);
+}
+
+// Test that server errors and unparseable bodies are not read as an empty listing
+TEST_F(RefreshGamesTest, FailedPollKeepsGames) {
+    backend->answer(503, "");
+    matcher->refreshGames(requested);
+    EXPECT_EQ(matcher->getOddsGames().size(), 2u);
+
+    backend->answer(200, R"({"message": "Invalid API key"})");
+    matcher->refreshGames(requested);
+    EXPECT_EQ(matcher->getOddsGames().size(), 2u);
+}
+
+// Test that a game missing from a successful listing is dropped
+TEST_F(RefreshGamesTest, SuccessfulPollDropsMissingGames) {
+    backend->answer(200, R"([{"id": "g2", "sport_key": "basketball_nba", "commence_time": "2026-11-01T02:00:00Z",
+                             "home_team": "Brooklyn Nets", "away_team": "Atlanta Hawks", "bookmakers": []}])");
+    matcher->refreshGames(requested);
+    ASSERT_EQ(matcher->getOddsGames().size(), 1u);
+    EXPECT_EQ(matcher->getOddsGames()[0].id, "g2");
+}
+
+} // namespace test
+} // namespace polymarket_bot
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "../src/market/market_store.h"
+#include <cctype>
+#include <cmath>
+
+namespace polymarket_bot {
+namespace test {
+
+using api::DecodedGammaMarket;
+using api::GammaMarketDecoder;
+using api::GammaProjection;
+using api::OutcomeError;
+
+const std::string conditionId = "0x9f3c1a2b4d5e6f708192a3b4c5d6e7f8091a2b3c4d5e6f708192a3b4c5d6e7f8";
+
+DecodedGammaMarket decodeOne(const std::string& object) {
+    auto page = GammaMarketDecoder::decodePage("[" + object + "]", GammaProjection::matching());
+    EXPECT_TRUE(page.has_value());
+    EXPECT_EQ(page->size(), 1u);
+    return std::move(page->front());
+}
+
+DecodedGammaMarket celticsHawks(const std::string& bestBid = "0.67") {
+    return decodeOne(R"({"id": "501", "slug": "test-store-bos-atl", "conditionId": ")" + conditionId + R"(",
+        "outcomes": "[\"Celtics\", \"Hawks\"]", "outcomePrices": "[\"0.68\", \"0.32\"]",
+        "clobTokenIds": "[\"test-store-1111\", \"test-store-2222\"]", "liquidityNum": 5400.25,
+        "bestBid": )" + bestBid + R"(, "description": "Cold field"})");
+}
+
+// Test that a record carries the hot fields as interned ids, raw condition id bytes and decoded outcomes
+TEST(MarketRecordTest, FromDecoded) {
+    MarketRecord record = MarketRecord::fromDecoded(celticsHawks());
+    EXPECT_EQ(record.idText(), "501");
+    EXPECT_EQ(record.slugText(), "test-store-bos-atl");
+    EXPECT_TRUE(record.hasConditionId);
+    EXPECT_EQ(record.conditionId[0], 0x9f);
+    EXPECT_EQ(record.conditionIdText(), conditionId);
+    EXPECT_DOUBLE_EQ(record.bestBid, 0.67);
+    EXPECT_TRUE(std::isnan(record.bestAsk));
+    EXPECT_DOUBLE_EQ(record.liquidity, 5400.25);
+
+    EXPECT_EQ(record.outcomeError, OutcomeError::None);
+    ASSERT_EQ(record.outcomeCount, 2u);
+    EXPECT_EQ(record.outcomeName(0), "Celtics");
+    EXPECT_EQ(record.tokenId(1), "test-store-2222");
+    EXPECT_DOUBLE_EQ(record.outcomes[1].price, 0.32);
+    EXPECT_EQ(record.outcomeName(2), "");
+}
+
+// Test that missing or malformed identity fields leave the record empty rather than wrong
+TEST(MarketRecordTest, FromDecodedWithoutIdentity) {
+    MarketRecord record = MarketRecord::fromDecoded(decodeOne(R"({"conditionId": "0x1234"})"));
+    EXPECT_EQ(record.id, 0u);
+    EXPECT_EQ(record.slug, 0u);
+    EXPECT_FALSE(record.hasConditionId);
+    EXPECT_EQ(record.conditionIdText(), "");
+    EXPECT_EQ(record.outcomeCount, 0u);
+    EXPECT_EQ(record.outcomeError, OutcomeError::Missing);
+}
+
+// Test that a market is found by slug, condition id (either hex case) and each token id
+TEST(MarketStoreTest, Lookups) {
+    MarketStore store;
+    store.add(celticsHawks());
+    store.add(decodeOne(R"({"id": "502", "slug": "test-store-bkn-tor"})"));
+    ASSERT_EQ(store.size(), 2u);
+
+    const MarketRecord* bySlug = store.findBySlug("test-store-bos-atl");
+    ASSERT_NE(bySlug, nullptr);
+    EXPECT_EQ(bySlug->idText(), "501");
+    EXPECT_EQ(store.findByConditionId(conditionId), bySlug);
+    std::string upper = conditionId;
+    for (size_t i = 2; i < upper.size(); ++i) {
+        upper[i] = static_cast<char>(std::toupper(static_cast<unsigned char>(upper[i])));
+    }
+    EXPECT_EQ(store.findByConditionId(upper), bySlug);
+    EXPECT_EQ(store.findByTokenId("test-store-1111"), bySlug);
+    EXPECT_EQ(store.findByTokenId("test-store-2222"), bySlug);
+
+    EXPECT_EQ(store.findBySlug("test-store-bkn-tor")->idText(), "502");
+    EXPECT_EQ(store.findBySlug("test-store-never-added"), nullptr);
+    EXPECT_EQ(store.findByConditionId("0x1234"), nullptr);
+    EXPECT_EQ(store.findByTokenId("test-store-3333"), nullptr);
+}
+
+// Test that adding the same slug again replaces the record in place and re-indexes its tokens
+TEST(MarketStoreTest, ReplaceOnSameSlug) {
+    MarketStore store;
+    store.add(celticsHawks());
+    store.add(decodeOne(R"({"id": "502", "slug": "test-store-bkn-tor"})"));
+
+    // Same slug, new price and a new token for the second outcome
+    auto updated = decodeOne(R"({"id": "501", "slug": "test-store-bos-atl", "conditionId": ")" + conditionId + R"(",
+        "outcomes": "[\"Celtics\", \"Hawks\"]", "outcomePrices": "[\"0.70\", \"0.30\"]",
+        "clobTokenIds": "[\"test-store-1111\", \"test-store-4444\"]", "bestBid": 0.69})");
+    const MarketRecord& replaced = store.add(updated);
+
+    EXPECT_EQ(store.size(), 2u);
+    EXPECT_EQ(replaced.coldRow, 0u);
+    EXPECT_EQ(store.findBySlug("test-store-bos-atl"), &replaced);
+    EXPECT_DOUBLE_EQ(replaced.bestBid, 0.69);
+    EXPECT_DOUBLE_EQ(replaced.outcomes[0].price, 0.70);
+    EXPECT_EQ(store.findByConditionId(conditionId), &replaced);
+    EXPECT_EQ(store.findByTokenId("test-store-4444"), &replaced);
+    EXPECT_EQ(store.findByTokenId("test-store-2222"), nullptr);
+    EXPECT_EQ(store.findBySlug("test-store-bkn-tor")->idText(), "502");
+}
+
+// Test that the cold table decodes the fields the record leaves out
+TEST(MarketStoreTest, ColdFields) {
+    MarketStore store;
+    const MarketRecord& record = store.add(celticsHawks());
+
+    auto cold = store.coldFields(record);
+    ASSERT_TRUE(cold.has_value());
+    EXPECT_EQ(cold->description, "Cold field");
+    EXPECT_EQ(cold->slug, "test-store-bos-atl");
+
+    MarketRecord detached = record;
+    detached.coldRow = MarketRecord::noColdRow;
+    EXPECT_EQ(store.coldFields(detached), std::nullopt);
+}
+
+// Test that a record keeps the decoder's outcome error and flags markets with more outcomes than it holds
+TEST(MarketRecordTest, OutcomeErrors) {
+    MarketRecord mismatched = MarketRecord::fromDecoded(
+        decodeOne(R"({"slug": "test-store-mismatched", "outcomes": "[\"Yes\", \"No\"]", "outcomePrices": "[\"1\"]"})"));
+    EXPECT_EQ(mismatched.outcomeError, OutcomeError::Mismatched);
+    EXPECT_EQ(mismatched.outcomeCount, 0u);
+
+    MarketRecord tooMany = MarketRecord::fromDecoded(decodeOne(
+        R"({"slug": "test-store-three-way", "outcomes": "[\"Home\", \"Draw\", \"Away\"]",
+            "outcomePrices": "[\"0.4\", \"0.3\", \"0.3\"]"})"));
+    EXPECT_EQ(tooMany.outcomeError, OutcomeError::TooMany);
+    EXPECT_EQ(tooMany.outcomeCount, 0u);
+    EXPECT_EQ(tooMany.outcomeName(0), "");
+}
+
+} // namespace test
+} // namespace polymarket_bot
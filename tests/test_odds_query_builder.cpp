@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include "../src/api/odds_query_builder.h"
+
+namespace polymarket_bot {
+namespace api {
+namespace test {
+
+// Test that the defaults ask by region when no bookmakers are given
+TEST(OddsQueryBuilderTest, DefaultsToRegions) {
+    auto url = OddsQueryBuilder().apiKey("k").build("basketball_nba");
+    EXPECT_EQ(url, "https://api.the-odds-api.com/v4/sports/basketball_nba/odds?apiKey=k&regions=us,uk");
+}
+
+// Test that bookmakers replace regions, and every set parameter is emitted in order
+TEST(OddsQueryBuilderTest, BookmakersReplaceRegions) {
+    auto url = OddsQueryBuilder()
+                   .baseUrl("https://odds.example.com/v4//")
+                   .apiKey("k")
+                   .regions({"us"})
+                   .bookmakers({"pinnacle", "draftkings"})
+                   .markets({"h2h", "spreads"})
+                   .oddsFormat("decimal")
+                   .dateFormat("iso")
+                   .build("icehockey_nhl");
+    EXPECT_EQ(url, "https://odds.example.com/v4/sports/icehockey_nhl/odds?apiKey=k"
+                   "&bookmakers=pinnacle,draftkings&markets=h2h,spreads&oddsFormat=decimal&dateFormat=iso");
+}
+
+// Test that the commence window is sent as UTC ISO-8601 and event ids come last
+TEST(OddsQueryBuilderTest, CommenceWindowAndEventIds) {
+    auto from = std::chrono::system_clock::from_time_t(1790000000);
+    auto url = OddsQueryBuilder()
+                   .apiKey("k")
+                   .regions({})
+                   .commenceTimeFrom(from)
+                   .commenceTimeTo(from + std::chrono::hours(24))
+                   .eventIds({"g1", "g2"})
+                   .build("baseball_mlb");
+    EXPECT_EQ(url, "https://api.the-odds-api.com/v4/sports/baseball_mlb/odds?apiKey=k"
+                   "&commenceTimeFrom=2026-09-21T14:13:20Z&commenceTimeTo=2026-09-22T14:13:20Z&eventIds=g1,g2");
+}
+
+} // namespace test
+} // namespace api
+} // namespace polymarket_bot
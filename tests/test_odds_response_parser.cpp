@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "../src/api/odds_response_parser.h"
+
+namespace polymarket_bot {
+namespace api {
+namespace test {
+
+using common::RawOddsGame;
+
+const std::string fixture = R"([
+    {"id": "g1", "sport_key": "basketball_nba", "sport_title": "NBA", "commence_time": "2026-11-01T00:00:00Z",
+     "home_team": "Boston Celtics", "away_team": "Atlanta Hawks",
+     "bookmakers": [
+        {"key": "pinnacle", "title": "Pinnacle", "last_update": "2026-10-31T20:00:00Z",
+         "markets": [
+            {"key": "h2h", "last_update": "2026-10-31T20:00:00Z",
+             "outcomes": [{"name": "Boston Celtics", "price": 1.45}, {"name": "Atlanta Hawks", "price": 2.9}]},
+            {"key": "spreads", "last_update": "2026-10-31T20:00:00Z",
+             "outcomes": [{"name": "Boston Celtics", "price": 1.91, "point": -7.5},
+                          {"name": "Atlanta Hawks", "price": 1.95, "point": 7.5}]}]},
+        {"key": "draftkings", "title": "DraftKings", "last_update": "2026-10-31T19:58:00Z",
+         "markets": [
+            {"key": "h2h", "last_update": "2026-10-31T19:58:00Z",
+             "outcomes": [{"name": "Boston Celtics", "price": 1.42}, {"name": "Atlanta Hawks", "price": 3}]}]}]},
+    {"id": "g2", "sport_key": "basketball_nba", "sport_title": "NBA", "commence_time": "2026-11-01T02:00:00Z",
+     "home_team": "Brooklyn Nets", "away_team": "Toronto Raptors", "bookmakers": []}
+])";
+
+void expectSameGames(const std::vector<RawOddsGame>& actual, const std::vector<RawOddsGame>& expected) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t g = 0; g < expected.size(); ++g) {
+        const auto& a = actual[g];
+        const auto& e = expected[g];
+        EXPECT_EQ(a.id, e.id);
+        EXPECT_EQ(a.sport_key, e.sport_key);
+        EXPECT_EQ(a.commence_time, e.commence_time);
+        EXPECT_EQ(a.home_team, e.home_team);
+        EXPECT_EQ(a.away_team, e.away_team);
+        EXPECT_EQ(a.sportKeyId, e.sportKeyId);
+        EXPECT_EQ(a.homeTeamId, e.homeTeamId);
+        EXPECT_EQ(a.awayTeamId, e.awayTeamId);
+        ASSERT_EQ(a.bookmakers.size(), e.bookmakers.size()) << e.id;
+        for (size_t b = 0; b < e.bookmakers.size(); ++b) {
+            const auto& ab = a.bookmakers[b];
+            const auto& eb = e.bookmakers[b];
+            EXPECT_EQ(ab.key, eb.key);
+            EXPECT_EQ(ab.title, eb.title);
+            EXPECT_EQ(ab.last_update, eb.last_update);
+            EXPECT_EQ(ab.keyId, eb.keyId);
+            ASSERT_EQ(ab.markets.size(), eb.markets.size()) << eb.key;
+            for (size_t m = 0; m < eb.markets.size(); ++m) {
+                const auto& am = ab.markets[m];
+                const auto& em = eb.markets[m];
+                EXPECT_EQ(am.key, em.key);
+                EXPECT_EQ(am.keyId, em.keyId);
+                ASSERT_EQ(am.outcomes.size(), em.outcomes.size()) << em.key;
+                for (size_t o = 0; o < em.outcomes.size(); ++o) {
+                    EXPECT_EQ(am.outcomes[o].name, em.outcomes[o].name);
+                    EXPECT_EQ(am.outcomes[o].nameId, em.outcomes[o].nameId);
+                    EXPECT_DOUBLE_EQ(am.outcomes[o].price, em.outcomes[o].price);
+                    EXPECT_EQ(am.outcomes[o].point, em.outcomes[o].point);
+                }
+            }
+        }
+    }
+}
+
+// Test that the SAX parser yields exactly what the DOM path does for the same body
+TEST(OddsResponseParserTest, SaxMatchesDom) {
+    auto dom = OddsResponseParser::parseDom(fixture);
+    auto sax = OddsResponseParser().parse(fixture);
+    ASSERT_TRUE(dom.has_value());
+    ASSERT_TRUE(sax.has_value());
+    expectSameGames(*sax, *dom);
+
+    ASSERT_EQ(sax->size(), 2u);
+    EXPECT_NE((*sax)[0].homeTeamId, 0u);
+    EXPECT_EQ((*sax)[0].bookmakers[0].markets[1].outcomes[0].point, -7.5);
+    EXPECT_EQ((*sax)[0].bookmakers[0].markets[0].outcomes[0].point, std::nullopt);
+}
+
+// Test that unix timestamps are converted to the same ISO strings on both paths
+TEST(OddsResponseParserTest, UnixDatesMatchDom) {
+    const std::string body = R"([{"id": "g1", "sport_key": "icehockey_nhl", "commence_time": 1790000000,
+        "home_team": "Boston Bruins", "away_team": "Toronto Maple Leafs",
+        "bookmakers": [{"key": "pinnacle", "title": "Pinnacle", "last_update": 1789990000,
+            "markets": [{"key": "h2h", "last_update": 1789990000,
+                "outcomes": [{"name": "Boston Bruins", "price": 1.8}, {"name": "Toronto Maple Leafs", "price": 2.05}]}]}]}])";
+
+    auto dom = OddsResponseParser::parseDom(body);
+    auto sax = OddsResponseParser().parse(body);
+    ASSERT_TRUE(dom.has_value());
+    ASSERT_TRUE(sax.has_value());
+    expectSameGames(*sax, *dom);
+    EXPECT_EQ((*sax)[0].commence_time, "2026-09-21T14:13:20Z");
+}
+
+// Test that filtered-out bookmakers and markets are skipped, leaving the rest as the DOM path reads them
+TEST(OddsResponseParserTest, FilterDropsUnwantedBooksAndMarkets) {
+    auto sax = OddsResponseParser({{"pinnacle"}, {"h2h"}}).parse(fixture);
+    ASSERT_TRUE(sax.has_value());
+
+    auto dom = OddsResponseParser::parseDom(fixture);
+    ASSERT_TRUE(dom.has_value());
+    auto& books = (*dom)[0].bookmakers;
+    books.erase(books.begin() + 1);
+    books[0].markets.erase(books[0].markets.begin() + 1);
+    expectSameGames(*sax, *dom);
+}
+
+// Test that bodies that are not a game array are rejected
+TEST(OddsResponseParserTest, RejectsNonArrays) {
+    EXPECT_EQ(OddsResponseParser().parse(R"({"message": "Invalid API key"})"), std::nullopt);
+    EXPECT_EQ(OddsResponseParser().parse("[{\"id\": "), std::nullopt);
+    EXPECT_EQ(OddsResponseParser().parse(""), std::nullopt);
+}
+
+// Test that a bare value or a list of non-games is rejected rather than read into a game
+TEST(OddsResponseParserTest, RejectsStringsOutsideGames) {
+    EXPECT_EQ(OddsResponseParser().parse(R"("x")"), std::nullopt);
+    EXPECT_EQ(OddsResponseParser().parse("42"), std::nullopt);
+    EXPECT_EQ(OddsResponseParser().parse(R"(["x"])"), std::nullopt);
+    EXPECT_EQ(OddsResponseParser().parse(R"(["x", {"id": "g1"}])"), std::nullopt);
+    EXPECT_EQ(OddsResponseParser().parse("[null]"), std::nullopt);
+    EXPECT_EQ(OddsResponseParser().parse("[[]]"), std::nullopt);
+
+    auto empty = OddsResponseParser().parse("[]");
+    ASSERT_TRUE(empty.has_value());
+    EXPECT_TRUE(empty->empty());
+}
+
+} // namespace test
+} // namespace api
+} // namespace polymarket_bot
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "../src/api/rate_limiter.h"
+#include <chrono>
+
+namespace polymarket_bot {
+namespace api {
+namespace test {
+
+using Clock = RateLimiter::Clock;
+using namespace std::chrono_literals;
+
+HttpResponse responseWithHeaders(long status, std::map<std::string, std::string> headers) {
+    HttpResponse response;
+    response.statusCode = status;
+    response.headers = std::move(headers);
+    return response;
+}
+
+// Test that the burst is spent at once and tokens come back at the configured rate
+TEST(RateLimiterTest, RefillsTokensAtConfiguredRate) {
+    RateLimiter limiter(60.0, 2.0);   // One token a second, two at once
+    Clock::time_point now = Clock::now();
+    Clock::duration wait{};
+
+    EXPECT_TRUE(limiter.tryAcquire(now, wait));
+    EXPECT_TRUE(limiter.tryAcquire(now, wait));
+    EXPECT_FALSE(limiter.tryAcquire(now, wait));
+    EXPECT_GT(wait, 0ms);
+    EXPECT_LE(wait, 1s);
+
+    EXPECT_TRUE(limiter.tryAcquire(now + wait, wait));
+    EXPECT_EQ(limiter.getStats().granted, 3u);
+    EXPECT_EQ(limiter.getStats().delayed, 1u);
+}
+
+// Test that the bucket never holds more than its burst, however long it sat idle
+TEST(RateLimiterTest, CapsTokensAtBurst) {
+    RateLimiter limiter(600.0, 3.0);
+    Clock::time_point later = Clock::now() + 1h;
+    Clock::duration wait{};
+
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(limiter.tryAcquire(later, wait));
+    }
+    EXPECT_FALSE(limiter.tryAcquire(later, wait));
+}
+
+// Test that x-requests-remaining caps requests to the quota the server reports
+TEST(RateLimiterTest, SpendsReportedQuotaLocally) {
+    RateLimiter limiter(6000.0, 100.0);
+    Clock::time_point now = Clock::now();
+    Clock::duration wait{};
+
+    limiter.observe(responseWithHeaders(200, {{"x-requests-remaining", "2"}, {"x-requests-used", "498"}}), now);
+    EXPECT_EQ(limiter.getStats().quotaUsed, 498);
+
+    EXPECT_TRUE(limiter.tryAcquire(now, wait));
+    EXPECT_TRUE(limiter.tryAcquire(now, wait));
+    EXPECT_FALSE(limiter.tryAcquire(now, wait));
+    EXPECT_EQ(wait, Clock::duration::max());
+    EXPECT_EQ(limiter.getStats().quotaRemaining, 0);
+
+    bool quotaExhausted = false;
+    EXPECT_FALSE(limiter.acquire(Clock::time_point::max(), quotaExhausted));
+    EXPECT_TRUE(quotaExhausted);
+}
+
+// Test that a response arriving after the local estimate hit zero reopens the host
+TEST(RateLimiterTest, LocalEstimateDoesNotLatch) {
+    RateLimiter limiter(6000.0, 100.0);
+    Clock::time_point now = Clock::now();
+    Clock::duration wait{};
+
+    limiter.observe(responseWithHeaders(200, {{"x-requests-remaining", "1"}}), now);
+    EXPECT_TRUE(limiter.tryAcquire(now, wait));
+    EXPECT_FALSE(limiter.tryAcquire(now, wait));
+
+    // The in-flight request comes back: the server had more left than the estimate said
+    limiter.observe(responseWithHeaders(200, {{"x-requests-remaining", "40"}}), now + 10ms);
+    EXPECT_TRUE(limiter.tryAcquire(now + 10ms, wait));
+}
+
+// Test that an exhausted quota lets one probe through per retry interval until it is reset
+TEST(RateLimiterTest, ProbesExhaustedQuotaPeriodically) {
+    RateLimiter limiter(6000.0, 100.0, 30s);
+    Clock::time_point now = Clock::now();
+    Clock::duration wait{};
+
+    limiter.observe(responseWithHeaders(401, {{"x-requests-remaining", "0"}}), now);
+    EXPECT_FALSE(limiter.tryAcquire(now + 29s, wait));
+    EXPECT_EQ(wait, Clock::duration::max());
+
+    // One probe once the interval is up, then closed again while it is out
+    EXPECT_TRUE(limiter.tryAcquire(now + 30s, wait));
+    EXPECT_FALSE(limiter.tryAcquire(now + 31s, wait));
+    EXPECT_EQ(wait, Clock::duration::max());
+
+    // Still exhausted: the next probe waits another full interval from this answer
+    limiter.observe(responseWithHeaders(401, {{"x-requests-remaining", "0"}}), now + 32s);
+    EXPECT_FALSE(limiter.tryAcquire(now + 61s, wait));
+    EXPECT_TRUE(limiter.tryAcquire(now + 62s, wait));
+
+    // The quota was reset: requests flow again
+    limiter.observe(responseWithHeaders(200, {{"x-requests-remaining", "500"}}), now + 63s);
+    EXPECT_TRUE(limiter.tryAcquire(now + 63s, wait));
+    EXPECT_TRUE(limiter.tryAcquire(now + 63s, wait));
+}
+
+// Test that a probe that never gets an answer does not stop later probes
+TEST(RateLimiterTest, ProbesAgainWhenProbeGetsNoAnswer) {
+    RateLimiter limiter(6000.0, 100.0, 10s);
+    Clock::time_point now = Clock::now();
+    Clock::duration wait{};
+
+    limiter.observe(responseWithHeaders(401, {{"x-requests-remaining", "0"}}), now);
+    EXPECT_TRUE(limiter.tryAcquire(now + 10s, wait));
+    limiter.observe(responseWithHeaders(0, {}), now + 11s);    // Transfer failed, no headers
+    EXPECT_FALSE(limiter.tryAcquire(now + 19s, wait));
+    EXPECT_TRUE(limiter.tryAcquire(now + 20s, wait));
+}
+
+// Test that a 429 pauses the host for Retry-After seconds
+TEST(RateLimiterTest, PausesOnThrottleForRetryAfter) {
+    RateLimiter limiter(6000.0, 100.0);
+    Clock::time_point now = Clock::now();
+    Clock::duration wait{};
+
+    limiter.observe(responseWithHeaders(429, {{"retry-after", "3"}}), now);
+    EXPECT_EQ(limiter.getStats().throttled, 1u);
+    EXPECT_FALSE(limiter.tryAcquire(now + 1s, wait));
+    EXPECT_EQ(wait, 2s);
+    EXPECT_TRUE(limiter.tryAcquire(now + 3s, wait));
+}
+
+// Test that the registry limits configured hosts only, keyed by host
+TEST(RateLimiterTest, RegistryLimitsConfiguredHostsOnly) {
+    auto& registry = RateLimiterRegistry::getInstance();
+    registry.configure("https://limited.example.com", 60.0);
+
+    auto limiter = registry.find("https://limited.example.com/v4/sports/x/odds?apiKey=k");
+    ASSERT_NE(limiter, nullptr);
+    EXPECT_EQ(limiter, registry.find("https://limited.example.com/other"));
+    EXPECT_EQ(registry.find("https://unlimited.example.com/markets"), nullptr);
+}
+
+} // namespace test
+} // namespace api
+} // namespace polymarket_bot
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "../src/market/scan_scheduler.h"
+#include <ctime>
+
+namespace polymarket_bot {
+namespace test {
+
+using Clock = ScanScheduler::Clock;
+using namespace std::chrono_literals;
+
+const Clock::time_point now = Clock::from_time_t(1790000000);   // Whole seconds, as commence times are
+
+polymarket_bot::common::RawOddsGame gameStarting(const std::string& id, const std::string& sport,
+                                                 Clock::duration fromNow) {
+    std::time_t commence = Clock::to_time_t(now + fromNow);
+    char iso[32];
+    std::strftime(iso, sizeof(iso), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&commence));
+
+    polymarket_bot::common::RawOddsGame game;
+    game.id = id;
+    game.sport_key = sport;
+    game.commence_time = iso;
+    return game;
+}
+
+// Under an hour out every 10 s, under a day every 10 min, otherwise hourly
+std::vector<polymarket_bot::config::PollBucket> buckets() {
+    return {{60, 10}, {1440, 600}, {100000, 3600}};
+}
+
+// Test that each game is polled at its own bucket's interval, grouped by sport
+TEST(ScanSchedulerTest, TakeDuePollsByBucket) {
+    ScanScheduler scheduler(buckets(), 10s, 1800s);
+    scheduler.updateGames({gameStarting("soon", "basketball_nba", 30min),
+                           gameStarting("tonight", "icehockey_nhl", 5h),
+                           gameStarting("later", "basketball_nba", 72h)}, now);
+    ASSERT_EQ(scheduler.size(), 3u);
+
+    // New games are due at once, one group per sport (ties in game id order)
+    auto due = scheduler.takeDue(now);
+    ASSERT_EQ(due.size(), 2u);
+    EXPECT_EQ(due["basketball_nba"], (std::vector<std::string>{"later", "soon"}));
+    EXPECT_EQ(due["icehockey_nhl"], std::vector<std::string>{"tonight"});
+
+    EXPECT_TRUE(scheduler.takeDue(now + 5s).empty());
+    EXPECT_EQ(scheduler.nextDue(), now + 10s);
+
+    due = scheduler.takeDue(now + 10s);
+    ASSERT_EQ(due.size(), 1u);
+    EXPECT_EQ(due["basketball_nba"], std::vector<std::string>{"soon"});
+
+    // At 600 s the 10-minute game is due again, and so is the 10-second one
+    due = scheduler.takeDue(now + 600s);
+    EXPECT_EQ(due["icehockey_nhl"], std::vector<std::string>{"tonight"});
+    EXPECT_EQ(due["basketball_nba"], std::vector<std::string>{"soon"});
+}
+
+// Test that games coming due within a quarter of the shortest interval ride along
+TEST(ScanSchedulerTest, TakeDueBatchesGamesDueShortly) {
+    ScanScheduler scheduler(buckets(), 10s, 1800s);
+    scheduler.updateGames({gameStarting("a", "basketball_nba", 30min)}, now);
+    scheduler.takeDue(now);
+
+    // b is new and due at once; a is due 2 s later, inside the 2.5 s horizon, so both go in one request
+    scheduler.updateGames({gameStarting("a", "basketball_nba", 30min), gameStarting("b", "basketball_nba", 40min)},
+                          now + 8s);
+    auto due = scheduler.takeDue(now + 8s);
+    EXPECT_EQ(due["basketball_nba"], (std::vector<std::string>{"b", "a"}));
+    EXPECT_EQ(scheduler.nextDue(), now + 18s);
+}
+
+// Test that intervals stretch so the total poll rate stays within one poll per game per base interval
+TEST(ScanSchedulerTest, StretchesIntervalsToBaseBudget) {
+    // Three games wanting a poll every 10 s against a budget of one every 20 s: stretch x2
+    ScanScheduler scheduler(buckets(), 20s, 1800s);
+    scheduler.updateGames({gameStarting("a", "basketball_nba", 10min), gameStarting("b", "basketball_nba", 20min),
+                           gameStarting("c", "icehockey_nhl", 30min)}, now);
+    scheduler.takeDue(now);
+
+    auto reports = scheduler.report(now);
+    ASSERT_EQ(reports.size(), 3u);
+    EXPECT_EQ(reports[0].targetSeconds, 20);
+    EXPECT_EQ(reports[0].games, 3u);
+    EXPECT_EQ(reports[1].targetSeconds, 1200);
+
+    EXPECT_TRUE(scheduler.takeDue(now + 10s).empty());
+    EXPECT_EQ(scheduler.nextDue(), now + 20s);
+    auto due = scheduler.takeDue(now + 20s);
+    EXPECT_EQ(due["basketball_nba"].size() + due["icehockey_nhl"].size(), 3u);
+}
+
+// Test that a budget the buckets already fit leaves the intervals as configured
+TEST(ScanSchedulerTest, NoStretchWithinBudget) {
+    ScanScheduler scheduler(buckets(), 600s, 1800s);
+    scheduler.updateGames({gameStarting("a", "basketball_nba", 10h), gameStarting("b", "basketball_nba", 72h)}, now);
+
+    auto reports = scheduler.report(now);
+    EXPECT_EQ(reports[0].targetSeconds, 10);
+    EXPECT_EQ(reports[1].targetSeconds, 600);
+    EXPECT_EQ(reports[2].targetSeconds, 3600);
+    EXPECT_EQ(reports[1].games, 1u);
+    EXPECT_EQ(reports[2].games, 1u);
+}
+
+// Test that started games are never polled and are dropped once their start passes
+TEST(ScanSchedulerTest, DropsStartedGames) {
+    ScanScheduler scheduler(buckets(), 10s, 1800s);
+    scheduler.updateGames({gameStarting("started", "basketball_nba", -1min),
+                           gameStarting("starting", "basketball_nba", 15s)}, now);
+    EXPECT_EQ(scheduler.size(), 1u);
+
+    scheduler.takeDue(now);
+    EXPECT_TRUE(scheduler.takeDue(now + 20s).empty());
+    EXPECT_EQ(scheduler.size(), 0u);
+    EXPECT_EQ(scheduler.nextDue(), Clock::time_point::max());
+}
+
+} // namespace test
+} // namespace polymarket_bot
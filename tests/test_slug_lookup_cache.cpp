@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include "../src/market/slug_lookup_cache.h"
+#include <thread>
+
+namespace polymarket_bot {
+namespace test {
+
+using namespace std::chrono_literals;
+
+// Test that a recorded miss is skipped until its TTL runs out
+TEST(SlugLookupCacheTest, NegativeEntryExpiresAfterTtl) {
+    SlugLookupCache cache(1s);
+    EXPECT_FALSE(cache.isKnownMissing("nba-bos-atl-2026-11-01"));
+
+    cache.recordMiss("nba-bos-atl-2026-11-01");
+    EXPECT_TRUE(cache.isKnownMissing("nba-bos-atl-2026-11-01"));
+    EXPECT_TRUE(cache.isKnownMissing("nba-bos-atl-2026-11-01"));
+    EXPECT_FALSE(cache.isKnownMissing("nba-bkn-atl-2026-11-01"));
+    EXPECT_EQ(cache.getStats().negativeHits, 2u);
+    EXPECT_EQ(cache.getStats().negativeEntries, 1u);
+
+    std::this_thread::sleep_for(1100ms);
+    EXPECT_FALSE(cache.isKnownMissing("nba-bos-atl-2026-11-01"));
+    EXPECT_EQ(cache.getStats().negativeEntries, 0u);
+}
+
+// Test that a zero TTL disables the negative cache
+TEST(SlugLookupCacheTest, ZeroTtlNeverSkips) {
+    SlugLookupCache cache(0s);
+    cache.recordMiss("nhl-bos-tor-2026-11-01");
+    EXPECT_FALSE(cache.isKnownMissing("nhl-bos-tor-2026-11-01"));
+}
+
+// Test that recording a miss drops entries that already expired
+TEST(SlugLookupCacheTest, RecordMissPrunesExpiredEntries) {
+    SlugLookupCache cache(1s);
+    cache.recordMiss("mlb-nyy-bos-2026-04-01");
+    std::this_thread::sleep_for(1100ms);
+    cache.recordMiss("mlb-nym-atl-2026-04-02");
+    EXPECT_EQ(cache.getStats().negativeEntries, 1u);
+}
+
+// Test that the default order is the enum order until a sport records hits
+TEST(SlugLookupCacheTest, DefaultVariantOrder) {
+    SlugLookupCache cache;
+    std::vector<SlugVariant> expected = {SlugVariant::Exact, SlugVariant::DayBefore, SlugVariant::DayAfter,
+                                         SlugVariant::Swapped, SlugVariant::SwappedDayBefore,
+                                         SlugVariant::SwappedDayAfter};
+    EXPECT_EQ(cache.variantOrder("nba"), expected);
+}
+
+// Test that the most frequently hit variant of a sport moves to the front, ties keeping default order
+TEST(SlugLookupCacheTest, LearnsVariantOrderPerSport) {
+    SlugLookupCache cache;
+    cache.recordHit("nhl", SlugVariant::DayAfter);
+    cache.recordHit("nhl", SlugVariant::DayAfter);
+    cache.recordHit("nhl", SlugVariant::Swapped);
+    cache.recordHit("nhl", SlugVariant::Exact);
+
+    auto order = cache.variantOrder("nhl");
+    std::vector<SlugVariant> expected = {SlugVariant::DayAfter, SlugVariant::Exact, SlugVariant::Swapped,
+                                         SlugVariant::DayBefore, SlugVariant::SwappedDayBefore,
+                                         SlugVariant::SwappedDayAfter};
+    EXPECT_EQ(order, expected);
+
+    // Other sports are unaffected
+    EXPECT_EQ(cache.variantOrder("nba").front(), SlugVariant::Exact);
+}
+
+} // namespace test
+} // namespace polymarket_bot
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "../src/common/string_interner.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace polymarket_bot {
+namespace common {
+namespace test {
+
+// Test that the seeded keys sit at the ids the interned:: constants name
+TEST(StringInternerTest, SeededKeysMatchConstants) {
+    auto& interner = StringInterner::getInstance();
+
+    for (size_t book = 0; book < sportsBookCount; ++book) {
+        auto sportsBook = static_cast<SportsBook>(book);
+        EXPECT_EQ(interner.find(sportsBookKey(sportsBook)), interned::bookmaker(sportsBook)) << sportsBookKey(sportsBook);
+    }
+    EXPECT_EQ(interner.find("h2h"), interned::h2h);
+    EXPECT_EQ(interner.find("spreads"), interned::spreads);
+    EXPECT_EQ(interner.find("totals"), interned::totals);
+    EXPECT_EQ(interner.find("basketball_nba"), interned::basketballNba);
+    EXPECT_EQ(interner.find("basketball_nba_summer_league"), interned::basketballNbaSummerLeague);
+    EXPECT_EQ(interner.find("icehockey_nhl"), interned::icehockeyNhl);
+    EXPECT_EQ(interner.find("baseball_mlb"), interned::baseballMlb);
+    EXPECT_EQ(interner.view(interned::h2h), "h2h");
+}
+
+// Test that the empty string is id 0 and unknown ids read as empty
+TEST(StringInternerTest, EmptyStringIsIdZero) {
+    auto& interner = StringInterner::getInstance();
+    EXPECT_EQ(interner.intern(""), StringInterner::emptyId);
+    EXPECT_EQ(interner.view(StringInterner::emptyId), "");
+    EXPECT_EQ(interner.view(static_cast<StringInterner::Id>(interner.size() + 100)), "");
+}
+
+// Test that the same text always gets the same id and views stay valid as the table grows
+TEST(StringInternerTest, IdsAreStable) {
+    auto& interner = StringInterner::getInstance();
+    EXPECT_EQ(interner.find("test-interner-stable"), std::nullopt);
+
+    auto id = interner.intern("test-interner-stable");
+    std::string_view view = interner.view(id);
+    for (int i = 0; i < 10000; ++i) {
+        interner.intern("test-interner-filler-" + std::to_string(i));
+    }
+    EXPECT_EQ(interner.intern(std::string("test-interner-") + "stable"), id);
+    EXPECT_EQ(interner.find("test-interner-stable"), id);
+    EXPECT_EQ(view, "test-interner-stable");
+    EXPECT_EQ(view.data(), interner.view(id).data());
+}
+
+// Test that threads interning the same strings all get one id per string
+TEST(StringInternerTest, ConcurrentInternAgrees) {
+    auto& interner = StringInterner::getInstance();
+    const int strings = 500;
+    std::vector<std::vector<StringInterner::Id>> seen(4, std::vector<StringInterner::Id>(strings));
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < seen.size(); ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < strings; ++i) {
+                seen[t][i] = interner.intern("test-interner-concurrent-" + std::to_string(i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (size_t t = 1; t < seen.size(); ++t) {
+        EXPECT_EQ(seen[t], seen[0]);
+    }
+}
+
+} // namespace test
+} // namespace common
+} // namespace polymarket_bot
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include "../src/api/transport_backend.h"
+#include <filesystem>
+#include <future>
+#include <sstream>
+#include <unistd.h>
+
+namespace polymarket_bot {
+namespace api {
+namespace test {
+
+// Answers each URL with its request count, so repeated requests get different bodies
+class ScriptedBackend : public TransportBackend {
+public:
+    HttpResponse perform(const HttpRequest& request) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        HttpResponse response;
+        response.statusCode = request.method == "POST" ? 201 : 200;
+        response.headers["etag"] = "\"v" + std::to_string(++calls[request.url]) + "\"";
+        response.body = request.method + " " + std::to_string(calls[request.url]) + " " + request.body;
+        return response;
+    }
+    void performAsync(HttpRequest request, Callback callback) override { callback(perform(request)); }
+    const char* name() const override { return "scripted"; }
+
+private:
+    std::mutex mutex;
+    std::map<std::string, int> calls;
+};
+
+const std::string oddsUrl = "https://api.the-odds-api.com/v4/sports/basketball_nba/odds?apiKey=secret"
+                            "&commenceTimeFrom=2026-11-01T00:00:00Z&commenceTimeTo=2026-11-02T00:00:00Z&markets=h2h";
+
+HttpRequest get(const std::string& url) {
+    HttpRequest request;
+    request.url = url;
+    return request;
+}
+
+class RecordReplayTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        archive = std::filesystem::temp_directory_path() /
+                  ("test_transport_backend_" + std::to_string(::getpid()) + ".bin");
+    }
+    void TearDown() override { std::filesystem::remove(archive); }
+
+    std::filesystem::path archive;
+};
+
+// Test that apiKey values are redacted wherever they appear in the query
+TEST(ExchangeArchiveTest, RedactsApiKeys) {
+    EXPECT_EQ(ExchangeArchive::redactUrl("https://x/odds?apiKey=secret&markets=h2h"),
+              "https://x/odds?apiKey=REDACTED&markets=h2h");
+    EXPECT_EQ(ExchangeArchive::redactUrl("https://x/odds?markets=h2h&apiKey=secret"),
+              "https://x/odds?markets=h2h&apiKey=REDACTED");
+    EXPECT_EQ(ExchangeArchive::redactUrl("https://x/markets?slug=a"), "https://x/markets?slug=a");
+}
+
+// Test that the loose key ignores time-window parameters and the api key, and nothing else
+TEST(ExchangeArchiveTest, LooseKeyDropsTimeWindow) {
+    std::string later = "https://api.the-odds-api.com/v4/sports/basketball_nba/odds?apiKey=other"
+                        "&commenceTimeFrom=2026-12-01T00:00:00Z&commenceTimeTo=2026-12-02T00:00:00Z&markets=h2h";
+    EXPECT_NE(ExchangeArchive::key("GET", oddsUrl, ""), ExchangeArchive::key("GET", later, ""));
+    EXPECT_EQ(ExchangeArchive::looseKey("GET", oddsUrl, ""), ExchangeArchive::looseKey("GET", later, ""));
+    EXPECT_EQ(ExchangeArchive::looseKey("GET", oddsUrl, ""),
+              "GET https://api.the-odds-api.com/v4/sports/basketball_nba/odds?apiKey=REDACTED&markets=h2h\n");
+    EXPECT_NE(ExchangeArchive::looseKey("GET", oddsUrl, ""), ExchangeArchive::looseKey("POST", oddsUrl, ""));
+}
+
+// Test that a recorded session replays the same responses in the same order, sync and async
+TEST_F(RecordReplayTest, RoundTrip) {
+    HttpRequest post = get("https://clob.example.com/order");
+    post.method = "POST";
+    post.body = R"({"size": 10})";
+
+    std::vector<HttpResponse> live;
+    {
+        RecordingBackend recorder(std::make_shared<ScriptedBackend>(), archive.string());
+        ASSERT_TRUE(recorder.isOpen());
+        live.push_back(recorder.perform(get(oddsUrl)));
+        live.push_back(recorder.perform(get(oddsUrl)));
+        live.push_back(recorder.perform(post));
+        recorder.performAsync(get("https://gamma.example.com/markets?slug=a"),
+                              [&](HttpResponse response) { live.push_back(std::move(response)); });
+        EXPECT_EQ(recorder.recorded(), 4u);
+    }
+
+    ReplayBackend replay(archive.string(), false);
+    ASSERT_TRUE(replay.isLoaded());
+    EXPECT_EQ(replay.size(), 4u);
+
+    std::vector<HttpResponse> replayed;
+    replayed.push_back(replay.perform(get(oddsUrl)));
+    replayed.push_back(replay.perform(get(oddsUrl)));
+    replayed.push_back(replay.perform(post));
+    std::promise<HttpResponse> async;
+    replay.performAsync(get("https://gamma.example.com/markets?slug=a"),
+                        [&](HttpResponse response) { async.set_value(std::move(response)); });
+    replayed.push_back(async.get_future().get());
+
+    ASSERT_EQ(replayed.size(), live.size());
+    for (size_t i = 0; i < live.size(); ++i) {
+        EXPECT_EQ(replayed[i].statusCode, live[i].statusCode) << i;
+        EXPECT_EQ(replayed[i].body, live[i].body) << i;
+        EXPECT_EQ(replayed[i].headers, live[i].headers) << i;
+        EXPECT_TRUE(replayed[i].ok()) << i;
+    }
+    EXPECT_EQ(replayed[1].body, "GET 2 ");
+    EXPECT_EQ(replayed[2].body, R"(POST 1 {"size": 10})");
+    EXPECT_EQ(replay.misses(), 0u);
+}
+
+// Test that the last answer repeats, other windows fall back to the loose key, and unknown requests miss
+TEST_F(RecordReplayTest, ReplayFallbacks) {
+    {
+        RecordingBackend recorder(std::make_shared<ScriptedBackend>(), archive.string());
+        recorder.perform(get(oddsUrl));
+    }
+
+    ReplayBackend replay(archive.string(), false);
+    EXPECT_EQ(replay.perform(get(oddsUrl)).body, "GET 1 ");
+    EXPECT_EQ(replay.perform(get(oddsUrl)).body, "GET 1 ");
+
+    std::string nextDay = "https://api.the-odds-api.com/v4/sports/basketball_nba/odds?apiKey=secret"
+                          "&commenceTimeFrom=2026-11-02T00:00:00Z&commenceTimeTo=2026-11-03T00:00:00Z&markets=h2h";
+    EXPECT_EQ(replay.perform(get(nextDay)).body, "GET 1 ");
+
+    HttpResponse miss = replay.perform(get("https://api.the-odds-api.com/v4/sports/icehockey_nhl/odds?apiKey=secret"));
+    EXPECT_EQ(miss.statusCode, 404);
+    EXPECT_FALSE(miss.ok());
+    EXPECT_EQ(miss.error.find("secret"), std::string::npos);
+    EXPECT_EQ(replay.misses(), 1u);
+}
+
+// Test that the archive never holds the api key, and a truncated tail keeps the records before it
+TEST_F(RecordReplayTest, ArchiveIsRedactedAndSurvivesTruncation) {
+    {
+        RecordingBackend recorder(std::make_shared<ScriptedBackend>(), archive.string());
+        recorder.perform(get(oddsUrl));
+        recorder.perform(get("https://gamma.example.com/markets?slug=a"));
+    }
+    std::ifstream in(archive, std::ios::binary);
+    std::stringstream bytes;
+    bytes << in.rdbuf();
+    EXPECT_EQ(bytes.str().find("secret"), std::string::npos);
+
+    std::filesystem::resize_file(archive, std::filesystem::file_size(archive) - 3);
+    std::vector<RecordedExchange> exchanges;
+    ASSERT_TRUE(ExchangeArchive::readAll(archive.string(), exchanges));
+    ASSERT_EQ(exchanges.size(), 1u);
+    EXPECT_EQ(exchanges[0].url, ExchangeArchive::redactUrl(oddsUrl));
+
+    std::ofstream(archive, std::ios::binary | std::ios::trunc) << "not an archive";
+    EXPECT_FALSE(ExchangeArchive::readAll(archive.string(), exchanges));
+}
+
+} // namespace test
+} // namespace api
+} // namespace polymarket_bot